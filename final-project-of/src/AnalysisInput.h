@@ -0,0 +1,82 @@
+//
+//  AnalysisInput.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef AnalysisInput_h
+#define AnalysisInput_h
+
+#include "ofMain.h"
+#include <vector>
+
+/**
+ * Abstract class that models where the visualizers get the sound they analyze from:
+ * the song being played (AudioEngine), or a live feed (LiveInput).
+ *
+ * All the functions are called on the main thread. update() is called once per frame, before the others,
+ * so that the windows and spectra for a frame are all read at the same position.
+ */
+class AnalysisInput {
+    
+public:
+    
+    /**
+     * Destructor for an AnalysisInput object.
+     */
+    virtual ~AnalysisInput() {}
+    
+    /**
+     * Moves the position the windows and spectra are read at to the sound being heard (or captured) right now.
+     */
+    virtual void update() = 0;
+    
+    /**
+     * Returns the time of the sound at that position (in seconds of sound played, or captured, so far),
+     * which the visualizers are to animate by, so that they keep in step with the sound.
+     */
+    virtual double getClockSeconds() = 0;
+    
+    /**
+     * Returns the sample rate of the sound (which the frequencies of the spectrum bands depend on).
+     */
+    virtual int getSampleRate() const = 0;
+    
+    /**
+     * Returns the current window of samples.
+     *
+     * @param number_of_frames - the number of frames in the window
+     */
+    virtual ofSoundBuffer getCurrentSoundBuffer(int number_of_frames) = 0;
+    
+    /**
+     * Returns the number of the first frame of the current window of samples (counted from the
+     * start of the song, or of the feed), so that consecutive windows can be lined up.
+     *
+     * @param number_of_frames - the number of frames in the window
+     */
+    virtual long long getCurrentWindowStartFrame(int number_of_frames) = 0;
+    
+    /**
+     * Copies any frames (numbered as getCurrentWindowStartFrame() numbers them) into a sound buffer,
+     * e.g. to analyze all the frames which have been played (or captured) since the last frame.
+     * Frames which are not available are silent.
+     *
+     * @param start_frame - the number of the first frame
+     * @param number_of_frames - the number of frames
+     * @param sound_buffer - the sound buffer the frames are copied into
+     */
+    virtual void copyFrames(long long start_frame, int number_of_frames, ofSoundBuffer & sound_buffer) = 0;
+    
+    /**
+     * Returns the spectrum band values of the current sound, on the same scale as ofSoundGetSpectrum().
+     *
+     * @param number_of_bands - the number of spectrum bands
+     * @return the spectrum band values (valid till the next call)
+     */
+    virtual const std::vector<float> & getSpectrum(int number_of_bands) = 0;
+    
+};
+
+#endif /* AnalysisInput_h */
@@ -0,0 +1,630 @@
+//
+//  AudioEngine.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "AudioEngine.h"
+
+const int kNumberOfOutputChannels = 2; // the number of channels the track is played on
+
+const int kStreamBufferSize = 512; // the number of frames the sound stream asks for at a time
+
+const int kNumberOfStreamBuffers = 4; // the number of buffers the sound stream queues
+
+const int kRetiredTracksCapacity = 16; // the number of retired tracks the ring holds (so that retiring a track
+                                       // on the audio thread does not allocate, as they are taken every frame)
+
+const int kMaximumTrackChannelsPerCopy = 8; // the number of channels the audio thread's copy buffer is sized for
+                                            // (tracks with more channels are copied in shorter chunks)
+
+/**
+ * Constructor for an AudioEngine object, with no track to play.
+ */
+AudioEngine::AudioEngine() noexcept {
+    
+    stream_sample_rate_ = 0;
+    playhead_frame_ = 0;
+    is_playing_ = false;
+    is_looping_ = true;
+    analysis_frame_ = 0;
+    clock_seconds_ = 0;
+    
+    retired_tracks_.resize(kRetiredTracksCapacity);
+    first_retired_track_ = 0;
+    number_of_retired_tracks_ = 0;
+    
+}
+
+/**
+ * Destructor for an AudioEngine object, which closes the sound stream.
+ */
+AudioEngine::~AudioEngine() {
+    
+    close();
+    
+}
+
+/**
+ * Returns (a reference-counted pointer to) the track being played.
+ */
+std::shared_ptr<AudioSource> AudioEngine::lockTrack() {
+    
+    std::lock_guard<std::mutex> lock(track_mutex_);
+    return track_;
+    
+}
+
+/**
+ * Moves a track switched away from into the ring of retired tracks, if there is room for it.
+ * The track mutex must be held.
+ *
+ * @return whether the track was retired (if not, the track is left as it was)
+ */
+bool AudioEngine::retireTrack(std::shared_ptr<AudioSource> & track) {
+    
+    if (number_of_retired_tracks_ == kRetiredTracksCapacity) {
+        return false;
+    }
+    
+    int index = (first_retired_track_ + number_of_retired_tracks_) % kRetiredTracksCapacity;
+    
+    retired_tracks_[index] = std::move(track);
+    number_of_retired_tracks_++;
+    
+    return true;
+    
+}
+
+/**
+ * Waits till the ring of retired tracks has room for the given number of tracks (on the main thread).
+ * If the ring is full, the oldest track is released here, once the audio thread has let go of it.
+ *
+ * @param lock - the lock holding the track mutex, which is released while waiting
+ * @param number_of_tracks - the number of tracks to make room for
+ */
+void AudioEngine::waitForRetiredTrackRoom(std::unique_lock<std::mutex> & lock, int number_of_tracks) {
+    
+    // The retired tracks are taken every frame, so this only waits if the caller stopped taking them.
+    // The audio thread lets go of a track by the end of the buffer it is filling.
+    
+    while (kRetiredTracksCapacity - number_of_retired_tracks_ < number_of_tracks) {
+        
+        std::shared_ptr<AudioSource> oldest_track;
+        
+        if (retired_tracks_[first_retired_track_].use_count() == 1) {
+            
+            oldest_track = std::move(retired_tracks_[first_retired_track_]);
+            first_retired_track_ = (first_retired_track_ + 1) % kRetiredTracksCapacity;
+            number_of_retired_tracks_--;
+        }
+        
+        lock.unlock();
+        
+        if (oldest_track) {
+            oldest_track.reset();
+        } else {
+            std::this_thread::yield();
+        }
+        
+        lock.lock();
+    }
+    
+}
+
+/**
+ * Sets the track to be played (dropping the next track, if one was queued), and rewinds the playhead to its start.
+ * The sound stream is (re)opened at the sample rate of the track, if needed.
+ */
+void AudioEngine::setTrack(std::shared_ptr<AudioSource> track) {
+    
+    {
+        std::unique_lock<std::mutex> lock(track_mutex_);
+        
+        // The audio thread may still be playing the tracks replaced, so they are retired rather than released.
+        
+        waitForRetiredTrackRoom(lock, 2);
+        
+        if (track_) {
+            retireTrack(track_);
+        }
+        
+        if (next_track_) {
+            retireTrack(next_track_);
+        }
+        
+        track_ = track;
+        next_track_.reset();
+        playhead_frame_ = 0;
+    }
+    
+    if (track) {
+        track->setPlayheadFrame(0);
+    }
+    
+    if (track && track->getSampleRate() != stream_sample_rate_) {
+        
+        close();
+        
+        sound_stream_.setOutput(this);
+        
+        // The audio thread's copy buffer is sized before the stream starts, so that it never allocates.
+        
+        output_samples_.resize(kStreamBufferSize * kMaximumTrackChannelsPerCopy);
+        
+        // The clock starts counting the new stream's frames. By the time a buffer is asked for, the buffers
+        // the stream queues are all filled ahead of it, so that is the latency it is heard with.
+        // (openFrameworks' sound streams do not report the device's own latency.)
+        
+        playback_clock_.reset(track->getSampleRate(), kStreamBufferSize * kNumberOfStreamBuffers);
+        
+        if (sound_stream_.setup(kNumberOfOutputChannels, 0, track->getSampleRate(),
+                                kStreamBufferSize, kNumberOfStreamBuffers)) {
+            
+            stream_sample_rate_ = track->getSampleRate();
+            
+        } else {
+            ofLogError("AudioEngine") << "Could not open a sound stream at " << track->getSampleRate() << " Hz";
+        }
+    }
+    
+}
+
+/**
+ * Getter for the track being played.
+ */
+std::shared_ptr<AudioSource> AudioEngine::getTrack() {
+    
+    return lockTrack();
+    
+}
+
+/**
+ * Sets the track which is played, without a gap, once the track being played ends
+ * (instead of the track being looped). The tracks must have the same sample rate.
+ *
+ * @return whether the track could be queued
+ */
+bool AudioEngine::setNextTrack(std::shared_ptr<AudioSource> next_track) {
+    
+    std::unique_lock<std::mutex> lock(track_mutex_);
+    
+    // The sound stream cannot be reopened at another sample rate without a gap.
+    
+    if (next_track && (!track_ || next_track->getSampleRate() != track_->getSampleRate())) {
+        return false;
+    }
+    
+    if (next_track_ && next_track_ != next_track) {
+        
+        waitForRetiredTrackRoom(lock, 1);
+        retireTrack(next_track_);
+    }
+    
+    next_track_ = next_track;
+    
+    if (next_track_) {
+        next_track_->setPlayheadFrame(0);
+    }
+    
+    return true;
+    
+}
+
+/**
+ * Getter for the track which is played once the track being played ends (nullptr if there is none).
+ */
+std::shared_ptr<AudioSource> AudioEngine::getNextTrack() {
+    
+    std::lock_guard<std::mutex> lock(track_mutex_);
+    return next_track_;
+    
+}
+
+/**
+ * Returns a track which has been switched away from, and which the audio thread has let go of
+ * (handing it over to the caller, to be released), or nullptr if there is none.
+ */
+std::shared_ptr<AudioSource> AudioEngine::takeRetiredTrack() {
+    
+    std::lock_guard<std::mutex> lock(track_mutex_);
+    
+    // A retired track cannot be picked up by the audio thread again, so once it holds the only reference,
+    // nothing else (the audio thread included) is using the track. The audio thread lets go of the tracks
+    // in the order they are retired, so the oldest is taken first.
+    
+    if (number_of_retired_tracks_ == 0 || retired_tracks_[first_retired_track_].use_count() != 1) {
+        return nullptr;
+    }
+    
+    std::shared_ptr<AudioSource> retired_track = std::move(retired_tracks_[first_retired_track_]);
+    
+    first_retired_track_ = (first_retired_track_ + 1) % kRetiredTracksCapacity;
+    number_of_retired_tracks_--;
+    
+    return retired_track;
+    
+}
+
+/**
+ * Closes the sound stream.
+ */
+void AudioEngine::close() {
+    
+    if (stream_sample_rate_ != 0) {
+        
+        sound_stream_.close();
+        stream_sample_rate_ = 0;
+        
+    }
+    
+}
+
+/**
+ * Starts playing the track from its start.
+ */
+void AudioEngine::play() {
+    
+    std::shared_ptr<AudioSource> track = lockTrack();
+    
+    playhead_frame_ = 0;
+    is_playing_ = true;
+    
+    if (track) {
+        track->setPlayheadFrame(0);
+    }
+    
+}
+
+/**
+ * Stops playing the track.
+ */
+void AudioEngine::stop() {
+    
+    is_playing_ = false;
+    
+}
+
+/**
+ * Returns whether the track is being played.
+ */
+bool AudioEngine::isPlaying() const {
+    
+    return is_playing_;
+    
+}
+
+/**
+ * Setter for whether the track restarts once it ends.
+ */
+void AudioEngine::setLoop(bool should_loop) {
+    
+    is_looping_ = should_loop;
+    
+}
+
+/**
+ * Moves the playhead to the given position (in milliseconds) of the track.
+ */
+void AudioEngine::setPositionMS(int position_ms) {
+    
+    std::shared_ptr<AudioSource> track = lockTrack();
+    
+    if (!track || track->getNumberOfFrames() == 0) {
+        return;
+    }
+    
+    long long position_frame = (long long) position_ms * track->getSampleRate() / 1000;
+    
+    // Positions past the end of the track wrap around (if it loops), or end it.
+    
+    if (position_frame >= track->getNumberOfFrames()) {
+        position_frame = is_looping_ ? position_frame % track->getNumberOfFrames() : track->getNumberOfFrames();
+    }
+    
+    playhead_frame_ = std::max(position_frame, 0LL);
+    track->setPlayheadFrame(playhead_frame_);
+    
+}
+
+/**
+ * Getter for the position of the playhead (in milliseconds).
+ */
+int AudioEngine::getPositionMS() {
+    
+    std::shared_ptr<AudioSource> track = lockTrack();
+    
+    if (!track) {
+        return 0;
+    }
+    
+    return (int) (playhead_frame_ * 1000 / track->getSampleRate());
+    
+}
+
+/**
+ * Getter for the position of the playhead (in frames).
+ */
+long long AudioEngine::getPositionFrames() const {
+    
+    return playhead_frame_;
+    
+}
+
+/**
+ * Moves the position the windows and spectra are read at to the frame being heard right now.
+ */
+void AudioEngine::update() {
+    
+    // The clock is sampled once, so that the frame analyzed and the time the animations are driven by
+    // describe the same instant.
+    
+    playback_clock_.sample();
+    
+    analysis_frame_ = playback_clock_.getTrackFrame();
+    clock_seconds_ = playback_clock_.getSeconds();
+    
+}
+
+/**
+ * Returns the time of the playback clock (in seconds of sound played so far) as of the last update().
+ */
+double AudioEngine::getClockSeconds() {
+    
+    return clock_seconds_;
+    
+}
+
+/**
+ * Returns the sample rate the track is played at (44,100 while no track is played).
+ */
+int AudioEngine::getSampleRate() const {
+    
+    // The sound stream is always opened at the track's sample rate.
+    
+    return (stream_sample_rate_ != 0) ? stream_sample_rate_ : 44100;
+    
+}
+
+/**
+ * Returns a window of the samples of the track, starting at the frame being heard.
+ * The window always has as many channels as are played (a mono track is copied to every channel).
+ */
+ofSoundBuffer AudioEngine::getCurrentSoundBuffer(int number_of_frames) {
+    
+    ofSoundBuffer sound_buffer;
+    
+    std::shared_ptr<AudioSource> track = lockTrack();
+    
+    if (!track) {
+        
+        sound_buffer.allocate(number_of_frames, kNumberOfOutputChannels);
+        return sound_buffer;
+        
+    }
+    
+    int track_channels = track->getNumberOfChannels();
+    
+    if (track_channels == kNumberOfOutputChannels) {
+        
+        track->copyFrames(analysis_frame_, number_of_frames, sound_buffer, is_looping_);
+        return sound_buffer;
+        
+    }
+    
+    track->copyFrames(analysis_frame_, number_of_frames, track_sound_buffer_, is_looping_);
+    
+    sound_buffer.setSampleRate(track->getSampleRate());
+    sound_buffer.allocate(number_of_frames, kNumberOfOutputChannels);
+    
+    for (int frame = 0; frame < number_of_frames; frame++) {
+        for (int channel = 0; channel < kNumberOfOutputChannels; channel++) {
+            
+            int track_channel = std::min(channel, track_channels - 1);
+            sound_buffer[frame * kNumberOfOutputChannels + channel] = track_sound_buffer_[frame * track_channels + track_channel];
+        }
+    }
+    
+    return sound_buffer;
+    
+}
+
+/**
+ * Returns the number of the first frame of the current window of samples (the frame being heard).
+ * (The window starts at the frame being heard, whatever its length.)
+ */
+long long AudioEngine::getCurrentWindowStartFrame(int /* number_of_frames */) {
+    
+    return analysis_frame_;
+    
+}
+
+/**
+ * Copies any frames of the track into a sound buffer (as they are stored in the track).
+ */
+void AudioEngine::copyFrames(long long start_frame, int number_of_frames, ofSoundBuffer & sound_buffer) {
+    
+    std::shared_ptr<AudioSource> track = lockTrack();
+    
+    if (!track) {
+        
+        sound_buffer.allocate(number_of_frames, kNumberOfOutputChannels);
+        sound_buffer.set(0);
+        return;
+        
+    }
+    
+    track->copyFrames(start_frame, number_of_frames, sound_buffer, is_looping_);
+    
+}
+
+/**
+ * Returns the spectrum band values of the samples just before the frame being heard, on the same scale as
+ * ofSoundGetSpectrum().
+ */
+const std::vector<float> & AudioEngine::getSpectrum(int number_of_bands) {
+    
+    int fft_size = SpectrumAnalyzer::getFftSize(number_of_bands);
+    
+    std::shared_ptr<AudioSource> track = lockTrack();
+    
+    // While the track is stopped, the spectrum is silent (as it is with ofSoundGetSpectrum()).
+    
+    if (!track || !is_playing_) {
+        
+        spectrum_samples_.assign(fft_size, 0);
+        return spectrum_analyzer_.getSpectrum(spectrum_samples_.data(), 1, number_of_bands);
+        
+    }
+    
+    track->copyFrames(analysis_frame_ - fft_size, fft_size, spectrum_sound_buffer_, is_looping_);
+    
+    return spectrum_analyzer_.getSpectrum(spectrum_sound_buffer_.getBuffer().data(),
+                                          track->getNumberOfChannels(), number_of_bands);
+    
+}
+
+/**
+ * Fills the sound stream's output buffer with the next frames of the track.
+ * This is called on the audio thread.
+ */
+void AudioEngine::audioOut(ofSoundBuffer & output_buffer) {
+    
+    std::shared_ptr<AudioSource> track;
+    std::shared_ptr<AudioSource> next_track;
+    
+    {
+        std::lock_guard<std::mutex> lock(track_mutex_);
+        
+        track = track_;
+        next_track = next_track_;
+    }
+    
+    int number_of_frames = (int) output_buffer.getNumFrames();
+    
+    if (!track || !is_playing_ || track->getNumberOfFrames() == 0) {
+        
+        playback_clock_.advance(playhead_frame_, number_of_frames, false);
+        
+        output_buffer.set(0);
+        return;
+        
+    }
+    
+    int output_channels = output_buffer.getNumChannels();
+    bool is_looping = is_looping_;
+    
+    long long start_playhead_frame = playhead_frame_;
+    long long playhead_frame = start_playhead_frame;
+    
+    // The clock is told where in the track this buffer starts. (If the track ends within the buffer,
+    // the clock runs on past its end, till the next buffer tells it where the next track is.)
+    
+    playback_clock_.advance(start_playhead_frame, number_of_frames, true);
+    
+    int frames_filled = 0;
+    
+    while (frames_filled < number_of_frames) {
+        
+        int track_channels = track->getNumberOfChannels();
+        long long number_of_track_frames = track->getNumberOfFrames();
+        
+        // If a next track is queued, this track is only played up to its end.
+        
+        int segment_frames = number_of_frames - frames_filled;
+        
+        if (next_track) {
+            segment_frames = (int) std::max(std::min((long long) segment_frames, number_of_track_frames - playhead_frame), 0LL);
+        }
+        
+        // Copy the next frames of the track (past its end, they wrap around if it loops, or are silent),
+        // as many at a time as the copy buffer holds (it is sized when the stream is set up, and never grows).
+        
+        int chunk_capacity = std::max((int) output_samples_.size() / track_channels, 1);
+        
+        for (int chunk_start = 0; chunk_start < segment_frames; chunk_start += chunk_capacity) {
+            
+            int chunk_frames = std::min(chunk_capacity, segment_frames - chunk_start);
+            
+            track->readFrames(playhead_frame + chunk_start, chunk_frames, output_samples_.data(),
+                              is_looping && !next_track);
+            
+            // A mono track is played on every output channel.
+            
+            for (int frame = 0; frame < chunk_frames; frame++) {
+                for (int channel = 0; channel < output_channels; channel++) {
+                    
+                    int track_channel = std::min(channel, track_channels - 1);
+                    output_buffer[(frames_filled + chunk_start + frame) * output_channels + channel] =
+                            output_samples_[frame * track_channels + track_channel];
+                }
+            }
+        }
+        
+        frames_filled += segment_frames;
+        playhead_frame += segment_frames;
+        
+        if (!next_track || playhead_frame < number_of_track_frames) {
+            break;
+        }
+        
+        // The track has ended: move straight on to the next track, in the same buffer.
+        
+        {
+            std::lock_guard<std::mutex> lock(track_mutex_);
+            
+            // The track which has ended is retired, so that it is not freed here, on the audio thread.
+            // If the tracks were changed (on the main thread) while the buffer was filled, or the ring of
+            // retired tracks is full, the rest of the buffer is silent. (With a full ring, the playhead
+            // waits at the end of the track, and the next track is moved on to once there is room.)
+            
+            bool is_track_changed = track_ != track || next_track_ != next_track;
+            
+            if (is_track_changed || !retireTrack(track_)) {
+                
+                for (; frames_filled < number_of_frames; frames_filled++) {
+                    for (int channel = 0; channel < output_channels; channel++) {
+                        output_buffer[frames_filled * output_channels + channel] = 0;
+                    }
+                }
+                
+                if (!is_track_changed) {
+                    playhead_frame_.compare_exchange_strong(start_playhead_frame, playhead_frame);
+                }
+                
+                return;
+            }
+            
+            track_ = next_track;
+            next_track_.reset();
+        }
+        
+        track = next_track;
+        next_track.reset();
+        
+        start_playhead_frame = playhead_frame_;
+        playhead_frame = 0;
+    }
+    
+    long long number_of_track_frames = track->getNumberOfFrames();
+    
+    if (is_looping && number_of_track_frames > 0) {
+        
+        playhead_frame %= number_of_track_frames;
+        
+    } else if (playhead_frame >= number_of_track_frames) {
+        
+        // The track has ended, with no track to move on to.
+        
+        playhead_frame = number_of_track_frames;
+        is_playing_ = false;
+    }
+    
+    // Only move the playhead if it was not moved (e.g. by setPositionMS()) while the buffer was filled.
+    
+    if (playhead_frame_.compare_exchange_strong(start_playhead_frame, playhead_frame)) {
+        track->setPlayheadFrame(playhead_frame);
+    }
+    
+}
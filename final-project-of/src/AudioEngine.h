@@ -0,0 +1,241 @@
+//
+//  AudioEngine.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef AudioEngine_h
+#define AudioEngine_h
+
+#include "ofMain.h"
+#include "AnalysisInput.h"
+#include "PlaybackClock.h"
+#include "AudioSource.h"
+#include "SpectrumAnalyzer.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Class that plays a track (an AudioSource) through a sound stream, and serves the visualizers
+ * windows of the samples around its playhead (and their spectrum).
+ *
+ * Playback and analysis both read the same decoded samples, so a track is decoded once
+ * (when it is loaded, or as it plays), no matter how many visualizations are opened while it plays.
+ *
+ * The playhead is advanced on the audio thread (in audioOut()), and read on the main thread.
+ * It runs ahead of what is heard by the buffers queued in the sound stream, so the visualizers are
+ * served the frames a playback clock (driven by the frames handed to the device) says are being heard.
+ *
+ * The tracks switched away from (on either thread) are kept in a fixed-capacity ring till the main thread
+ * takes them with takeRetiredTrack(), so that the audio thread never ends up freeing a track (or joining
+ * its decode thread), nor allocating room for one.
+ */
+class AudioEngine : public ofBaseSoundOutput, public AnalysisInput {
+    
+    ofSoundStream sound_stream_; // the sound stream the track is played through
+    
+    int stream_sample_rate_; // the sample rate the sound stream is open at (0 if it is closed)
+    
+    std::mutex track_mutex_; // the mutex guarding the track pointer (the track guards its own samples)
+    
+    std::shared_ptr<AudioSource> track_; // the track being played
+    
+    std::shared_ptr<AudioSource> next_track_; // the track played (without a gap) once the track being played ends
+    
+    std::vector<std::shared_ptr<AudioSource> > retired_tracks_; // the ring of tracks switched away from, till they
+                                                                // are taken (so that the audio thread never frees
+                                                                // a track); it is sized once, and never grows
+    
+    int first_retired_track_; // the index of the oldest track in the ring of retired tracks
+    
+    int number_of_retired_tracks_; // the number of tracks in the ring of retired tracks
+    
+    std::atomic<long long> playhead_frame_; // the frame of the track which is played next
+    
+    std::atomic<bool> is_playing_; // whether the track is being played
+    
+    std::atomic<bool> is_looping_; // whether the track restarts once it ends
+    
+    PlaybackClock playback_clock_; // the clock which tells which frame is being heard
+    
+    long long analysis_frame_; // the frame of the track being heard, as of the last update()
+    
+    double clock_seconds_; // the time of the playback clock, as of the last update()
+    
+    std::vector<float> output_samples_; // the samples of the track copied by the audio thread, before they are
+                                        // spread over the output channels (sized when the stream is set up)
+    
+    ofSoundBuffer track_sound_buffer_; // a window of the samples of the track, as they are stored in the track
+    
+    ofSoundBuffer spectrum_sound_buffer_; // the window of samples the spectrum is computed from
+    
+    std::vector<float> spectrum_samples_; // the (silent) samples the spectrum is computed from while the track is stopped
+    
+    SpectrumAnalyzer spectrum_analyzer_; // the analyzer which computes the spectrum of the track
+    
+    /**
+     * Returns (a reference-counted pointer to) the track being played.
+     */
+    std::shared_ptr<AudioSource> lockTrack();
+    
+    /**
+     * Moves a track switched away from into the ring of retired tracks, if there is room for it.
+     * The track mutex must be held.
+     *
+     * @return whether the track was retired (if not, the track is left as it was)
+     */
+    bool retireTrack(std::shared_ptr<AudioSource> & track);
+    
+    /**
+     * Waits till the ring of retired tracks has room for the given number of tracks (on the main thread).
+     * If the ring is full, the oldest track is released here, once the audio thread has let go of it.
+     *
+     * @param lock - the lock holding the track mutex, which is released while waiting
+     * @param number_of_tracks - the number of tracks to make room for
+     */
+    void waitForRetiredTrackRoom(std::unique_lock<std::mutex> & lock, int number_of_tracks);
+    
+public:
+    
+    /**
+     * Constructor for an AudioEngine object, with no track to play.
+     */
+    AudioEngine() noexcept;
+    
+    /**
+     * Destructor for an AudioEngine object, which closes the sound stream.
+     */
+    ~AudioEngine();
+    
+    /**
+     * Sets the track to be played (dropping the next track, if one was queued), and rewinds the playhead to its start.
+     * The sound stream is (re)opened at the sample rate of the track, if needed.
+     */
+    void setTrack(std::shared_ptr<AudioSource> track);
+    
+    /**
+     * Getter for the track being played.
+     */
+    std::shared_ptr<AudioSource> getTrack();
+    
+    /**
+     * Sets the track which is played, without a gap, once the track being played ends
+     * (instead of the track being looped). The tracks must have the same sample rate.
+     *
+     * @return whether the track could be queued
+     */
+    bool setNextTrack(std::shared_ptr<AudioSource> next_track);
+    
+    /**
+     * Getter for the track which is played once the track being played ends (nullptr if there is none).
+     */
+    std::shared_ptr<AudioSource> getNextTrack();
+    
+    /**
+     * Returns a track which has been switched away from, and which the audio thread has let go of
+     * (handing it over to the caller, to be released), or nullptr if there is none.
+     */
+    std::shared_ptr<AudioSource> takeRetiredTrack();
+    
+    /**
+     * Closes the sound stream.
+     */
+    void close();
+    
+    /**
+     * Starts playing the track from its start.
+     */
+    void play();
+    
+    /**
+     * Stops playing the track.
+     */
+    void stop();
+    
+    /**
+     * Returns whether the track is being played.
+     */
+    bool isPlaying() const;
+    
+    /**
+     * Setter for whether the track restarts once it ends.
+     */
+    void setLoop(bool should_loop);
+    
+    /**
+     * Moves the playhead to the given position (in milliseconds) of the track.
+     */
+    void setPositionMS(int position_ms);
+    
+    /**
+     * Getter for the position of the playhead (in milliseconds).
+     */
+    int getPositionMS();
+    
+    /**
+     * Getter for the position of the playhead (in frames).
+     */
+    long long getPositionFrames() const;
+    
+    /**
+     * Moves the position the windows and spectra are read at to the frame being heard right now.
+     */
+    void update();
+    
+    /**
+     * Returns the time of the playback clock (in seconds of sound played so far) as of the last update().
+     */
+    double getClockSeconds();
+    
+    /**
+     * Returns the sample rate the track is played at (44,100 while no track is played).
+     */
+    int getSampleRate() const;
+    
+    /**
+     * Returns a window of the samples of the track, starting at the frame being heard.
+     * The window always has as many channels as are played (a mono track is copied to every channel),
+     * so the visualizers see the same layout whichever track is being played.
+     *
+     * @param number_of_frames - the number of frames in the window
+     */
+    ofSoundBuffer getCurrentSoundBuffer(int number_of_frames);
+    
+    /**
+     * Returns the number of the first frame of the current window of samples (the frame being heard).
+     *
+     * @param number_of_frames - the number of frames in the window
+     */
+    long long getCurrentWindowStartFrame(int number_of_frames);
+    
+    /**
+     * Copies any frames of the track into a sound buffer (as they are stored in the track).
+     *
+     * @param start_frame - the first frame of the track
+     * @param number_of_frames - the number of frames
+     * @param sound_buffer - the sound buffer the frames are copied into
+     */
+    void copyFrames(long long start_frame, int number_of_frames, ofSoundBuffer & sound_buffer);
+    
+    /**
+     * Returns the spectrum band values of the samples just before the frame being heard, on the same scale as
+     * ofSoundGetSpectrum() (which only reports on the sound players using FMOD).
+     *
+     * @param number_of_bands - the number of spectrum bands
+     * @return the spectrum band values (valid till the next call)
+     */
+    const std::vector<float> & getSpectrum(int number_of_bands);
+    
+    /**
+     * Fills the sound stream's output buffer with the next frames of the track.
+     * This is called on the audio thread.
+     */
+    void audioOut(ofSoundBuffer & output_buffer);
+    
+};
+
+#endif /* AudioEngine_h */
@@ -0,0 +1,58 @@
+//
+//  AudioInputBackend.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef AudioInputBackend_h
+#define AudioInputBackend_h
+
+#include "ofMain.h"
+#include <string>
+
+/**
+ * Abstract class that models where the live input's blocks of samples come from:
+ * a sound input device (SoundStreamInputBackend), or a file standing in for one (FileInputBackend),
+ * so that the live input can be run on machines without a sound card.
+ *
+ * A backend delivers the blocks to its listener's audioIn(), on a thread of its own.
+ */
+class AudioInputBackend {
+    
+public:
+    
+    /**
+     * Destructor for an AudioInputBackend object.
+     */
+    virtual ~AudioInputBackend() {}
+    
+    /**
+     * Starts delivering blocks of samples to the listener.
+     *
+     * @param listener - the listener whose audioIn() is called with every block
+     * @param sample_rate - the sample rate asked for (see getSampleRate() for the one delivered)
+     * @param buffer_size - the number of frames in every block
+     * @param number_of_channels - the number of channels in every block
+     * @return whether the backend could be started
+     */
+    virtual bool start(ofBaseSoundInput * listener, int sample_rate, int buffer_size, int number_of_channels) = 0;
+    
+    /**
+     * Stops delivering blocks. Once this returns, the listener's audioIn() is not called anymore.
+     */
+    virtual void stop() = 0;
+    
+    /**
+     * Getter for the sample rate of the blocks delivered.
+     */
+    virtual int getSampleRate() const = 0;
+    
+    /**
+     * Getter for the name of the backend (to be displayed).
+     */
+    virtual std::string getName() const = 0;
+    
+};
+
+#endif /* AudioInputBackend_h */
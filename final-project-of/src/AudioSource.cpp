@@ -0,0 +1,21 @@
+//
+//  AudioSource.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "AudioSource.h"
+
+/**
+ * Copies a window of frames into a sound buffer (which is resized to fit them).
+ * Frames outside the track are either wrapped around (if loop is true) or silent.
+ */
+void AudioSource::copyFrames(long long start_frame, int number_of_frames, ofSoundBuffer & sound_buffer, bool loop) const {
+    
+    sound_buffer.setSampleRate(getSampleRate());
+    sound_buffer.allocate(number_of_frames, getNumberOfChannels());
+    
+    readFrames(start_frame, number_of_frames, sound_buffer.getBuffer().data(), loop);
+    
+}
@@ -0,0 +1,86 @@
+//
+//  AudioSource.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef AudioSource_h
+#define AudioSource_h
+
+#include "ofMain.h"
+#include <string>
+
+/**
+ * Abstract class that models a track whose samples can be read by the audio engine
+ * (for playback) and by the visualizers (for analysis).
+ *
+ * A source may not hold every sample of its track in memory (see StreamingTrack), so it is told
+ * where the playhead is, and only the frames around the playhead are guaranteed to be readable.
+ */
+class AudioSource {
+    
+public:
+    
+    /**
+     * Destructor for an AudioSource object.
+     */
+    virtual ~AudioSource() {}
+    
+    /**
+     * Getter for the path of the audio file the track was decoded from.
+     */
+    virtual const std::string & getPath() const = 0;
+    
+    /**
+     * Getter for the number of channels of the track.
+     */
+    virtual int getNumberOfChannels() const = 0;
+    
+    /**
+     * Getter for the sample rate of the track.
+     */
+    virtual int getSampleRate() const = 0;
+    
+    /**
+     * Getter for the number of frames (samples per channel) of the track.
+     */
+    virtual long long getNumberOfFrames() const = 0;
+    
+    /**
+     * Returns the number of bytes of memory the samples of the track take up.
+     */
+    virtual size_t getMemoryUsage() const = 0;
+    
+    /**
+     * Copies a window of frames of the track into an array of interleaved samples.
+     * Frames outside the track are either wrapped around (if loop is true) or silent,
+     * and so are frames which the source does not hold (yet).
+     *
+     * @param start_frame - the first frame of the window (may be negative)
+     * @param number_of_frames - the number of frames in the window
+     * @param samples - the array the samples are copied to (of number_of_frames * getNumberOfChannels() samples)
+     * @param loop - whether the track is played in a loop
+     */
+    virtual void readFrames(long long start_frame, int number_of_frames, float * samples, bool loop) const = 0;
+    
+    /**
+     * Tells the source which frame of the track is played next.
+     * This is called on the audio thread every time the playhead moves.
+     */
+    virtual void setPlayheadFrame(long long /* playhead_frame */) {}
+    
+    /**
+     * Copies a window of frames into a sound buffer (which is resized to fit them).
+     * Frames outside the track are either wrapped around (if loop is true) or silent.
+     *
+     * @param start_frame - the first frame of the window (may be negative)
+     * @param number_of_frames - the number of frames in the window
+     * @param sound_buffer - the sound buffer the window is copied to
+     * @param loop - whether the track is played in a loop
+     */
+    void copyFrames(long long start_frame, int number_of_frames, ofSoundBuffer & sound_buffer, bool loop) const;
+    
+};
+
+#endif /* AudioSource_h */
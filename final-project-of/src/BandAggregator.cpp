@@ -0,0 +1,298 @@
+//
+//  BandAggregator.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "BandAggregator.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define BAND_AGGREGATOR_USE_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define BAND_AGGREGATOR_USE_NEON 1
+#endif
+
+const float kLowestFrequency = 20; // the lowest frequency (in Hz) a band starts at (below it, there is nothing to hear)
+
+const float kBarkEdges[] = {100, 200, 300, 400, 510, 630, 770, 920, 1080, 1270, 1480, 1720, 2000, // the upper edges
+                            2320, 2700, 3150, 3700, 4400, 5300, 6400, 7700, 9500, 12000, 15500}; // (in Hz) of the Bark bands
+
+/**
+ * Constructor for a BandAggregator object, with third-octave bands (and no bins, till it is set up).
+ */
+BandAggregator::BandAggregator() noexcept {
+
+    scale_ = BAND_SCALE_THIRD_OCTAVE;
+    number_of_bins_ = 0;
+    sample_rate_ = 0;
+
+}
+
+/**
+ * Sets up the bands, recomputing the weight table only if something changed.
+ */
+void BandAggregator::setup(BandScale scale, int number_of_bins, int sample_rate) {
+
+    if (scale == scale_ && number_of_bins == number_of_bins_ && sample_rate == sample_rate_) {
+        return;
+    }
+
+    scale_ = scale;
+    number_of_bins_ = number_of_bins;
+    sample_rate_ = sample_rate;
+
+    computeBandEdges(sample_rate / 2.0f);
+    computeWeights();
+
+}
+
+/**
+ * Fills in the edges of the bands of the scale, up to the given frequency.
+ */
+void BandAggregator::computeBandEdges(float maximum_frequency) {
+
+    band_lower_edges_.clear();
+    band_upper_edges_.clear();
+
+    if (scale_ == BAND_SCALE_BARK) {
+
+        // The first critical band starts at 0 Hz; here, it starts at the lowest audible frequency.
+
+        float lower_edge = kLowestFrequency;
+
+        for (float upper_edge : kBarkEdges) {
+
+            if (lower_edge >= maximum_frequency) {
+                break;
+            }
+
+            band_lower_edges_.push_back(lower_edge);
+            band_upper_edges_.push_back(std::min(upper_edge, maximum_frequency));
+
+            lower_edge = upper_edge;
+        }
+
+        return;
+    }
+
+    // Octave bands are centered on 1 kHz * 2^k, and third-octave bands on 1 kHz * 2^(k/3) (the preferred
+    // frequencies of ANSI S1.11, which round these), each spanning half a band on either side of its center.
+
+    float bands_per_octave = (scale_ == BAND_SCALE_OCTAVE) ? 1 : 3;
+    float half_band = pow(2.0f, 0.5f / bands_per_octave);
+
+    // Start from the first band centered above the lowest frequency.
+
+    int band = (int) ceil(bands_per_octave * log2(kLowestFrequency / 1000.0f));
+
+    while (true) {
+
+        float center = 1000.0f * pow(2.0f, band / bands_per_octave);
+        float lower_edge = center / half_band;
+
+        if (lower_edge >= maximum_frequency || center > 21000) {
+            break;
+        }
+
+        band_lower_edges_.push_back(lower_edge);
+        band_upper_edges_.push_back(std::min(center * half_band, maximum_frequency));
+
+        band++;
+    }
+
+}
+
+/**
+ * Computes the sparse weight table of the bands.
+ */
+void BandAggregator::computeWeights() {
+
+    int number_of_bands = band_lower_edges_.size();
+
+    band_first_bins_.assign(number_of_bands, 0);
+    band_weight_offsets_.assign(number_of_bands + 1, 0);
+    weights_.clear();
+
+    if (number_of_bins_ <= 0 || sample_rate_ <= 0) {
+
+        // There are no bins to aggregate: every band reads 0.
+
+        return;
+    }
+
+    // Bin k is centered on k * bin_width, and spans half a bin on either side.
+
+    float bin_width = sample_rate_ / (2.0f * number_of_bins_);
+
+    for (int band = 0; band < number_of_bands; band++) {
+
+        float lower_edge = band_lower_edges_[band];
+        float upper_edge = band_upper_edges_[band];
+
+        int first_bin = std::min((int) floor(lower_edge / bin_width + 0.5f), number_of_bins_ - 1);
+        int last_bin = std::min((int) floor(upper_edge / bin_width + 0.5f), number_of_bins_ - 1);
+
+        band_first_bins_[band] = first_bin;
+        band_weight_offsets_[band] = weights_.size();
+
+        // Weight each bin by how much of it falls in the band, then normalize the weights so they add up to 1
+        // (a band narrower than a bin just reads the bin it falls in).
+
+        float sum_of_weights = 0;
+
+        for (int bin = first_bin; bin <= last_bin; bin++) {
+
+            float overlap = std::min(upper_edge, (bin + 0.5f) * bin_width) - std::max(lower_edge, (bin - 0.5f) * bin_width);
+            float weight = std::max(overlap, 0.0f) / bin_width;
+
+            weights_.push_back(weight);
+            sum_of_weights += weight;
+        }
+
+        int weight_offset = band_weight_offsets_[band];
+
+        for (int index = weight_offset; index < (int) weights_.size(); index++) {
+            weights_[index] = (sum_of_weights > 0) ? weights_[index] / sum_of_weights
+                                                   : 1.0f / (weights_.size() - weight_offset);
+        }
+    }
+
+    band_weight_offsets_[number_of_bands] = weights_.size();
+
+}
+
+/**
+ * Getter for the scale of the bands.
+ */
+BandScale BandAggregator::getScale() const {
+
+    return scale_;
+
+}
+
+/**
+ * Getter for the number of bands (those below half the sample rate).
+ */
+int BandAggregator::getNumberOfBands() const {
+
+    return band_lower_edges_.size();
+
+}
+
+/**
+ * Getter for the number of bins of the spectra the bands are set up for.
+ */
+int BandAggregator::getNumberOfBins() const {
+
+    return number_of_bins_;
+
+}
+
+/**
+ * Returns the band that covers the given frequency (the nearest band, if none does).
+ */
+int BandAggregator::getBandIndex(float frequency) const {
+
+    int number_of_bands = band_lower_edges_.size();
+
+    for (int band = 0; band < number_of_bands; band++) {
+
+        if (frequency < band_upper_edges_[band]) {
+            return band;
+        }
+    }
+
+    return std::max(number_of_bands - 1, 0);
+
+}
+
+/**
+ * Returns the name of a scale (e.g. "THIRD OCTAVE"), as it is listed in the GUI.
+ */
+std::string BandAggregator::getScaleName(BandScale scale) {
+
+    switch (scale) {
+        case BAND_SCALE_OCTAVE:
+            return "OCTAVE";
+        case BAND_SCALE_THIRD_OCTAVE:
+            return "THIRD OCTAVE";
+        case BAND_SCALE_BARK:
+            return "BARK";
+    }
+
+    return "";
+
+}
+
+/**
+ * Aggregates the bins of a spectrum into the bands.
+ */
+void BandAggregator::aggregate(const float * bin_values, std::vector<float> & band_values) const {
+
+    int number_of_bands = band_lower_edges_.size();
+
+    band_values.assign(number_of_bands, 0);
+
+    if (weights_.empty()) {
+        return;
+    }
+
+    for (int band = 0; band < number_of_bands; band++) {
+
+        // The band is the dot product of its weights with the run of bins it covers.
+
+        const float * weights = weights_.data() + band_weight_offsets_[band];
+        const float * values = bin_values + band_first_bins_[band];
+
+        int number_of_weights = band_weight_offsets_[band + 1] - band_weight_offsets_[band];
+        int index = 0;
+
+        float sum = 0;
+
+#if defined(BAND_AGGREGATOR_USE_SSE)
+
+        if (number_of_weights >= 4) {
+
+            __m128 sums = _mm_setzero_ps();
+
+            for (; index + 4 <= number_of_weights; index += 4) {
+                sums = _mm_add_ps(sums, _mm_mul_ps(_mm_loadu_ps(weights + index), _mm_loadu_ps(values + index)));
+            }
+
+            // Add the four lanes up.
+
+            sums = _mm_add_ps(sums, _mm_movehl_ps(sums, sums));
+            sums = _mm_add_ss(sums, _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 1, 1, 1)));
+
+            sum = _mm_cvtss_f32(sums);
+        }
+
+#elif defined(BAND_AGGREGATOR_USE_NEON)
+
+        if (number_of_weights >= 4) {
+
+            float32x4_t sums = vdupq_n_f32(0);
+
+            for (; index + 4 <= number_of_weights; index += 4) {
+                sums = vmlaq_f32(sums, vld1q_f32(weights + index), vld1q_f32(values + index));
+            }
+
+            float32x2_t pair = vadd_f32(vget_low_f32(sums), vget_high_f32(sums));
+            sum = vget_lane_f32(vpadd_f32(pair, pair), 0);
+        }
+
+#endif
+
+        for (; index < number_of_weights; index++) {
+            sum += weights[index] * values[index];
+        }
+
+        band_values[band] = sum;
+    }
+
+}
@@ -0,0 +1,113 @@
+//
+//  BandAggregator.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef BandAggregator_h
+#define BandAggregator_h
+
+#include <string>
+#include <vector>
+
+/**
+ * The scales the bins of a spectrum can be grouped into bands on.
+ */
+enum BandScale {
+    BAND_SCALE_OCTAVE, // octave bands, centered on 1 kHz * 2^k (31.5 Hz to 16 kHz)
+    BAND_SCALE_THIRD_OCTAVE, // third-octave bands, centered on 1 kHz * 2^(k/3) (25 Hz to 20 kHz)
+    BAND_SCALE_BARK // the 24 critical bands of hearing (Zwicker's Bark scale)
+};
+
+/**
+ * Class that groups the (linearly spaced) bins of a spectrum into bands that are spaced the way hearing is:
+ * octave, third-octave or Bark bands. Each band is the average of the bins it covers, weighted by how much
+ * of each bin falls in it.
+ *
+ * The weights are worked out once, when the scale, the number of bins or the sample rate changes, and kept
+ * as a sparse table (the run of bins each band covers, and their weights), so aggregating a spectrum
+ * only touches the bins below the top band, each band in one vectorized dot product (SSE on x86, NEON on
+ * ARM, with a scalar fallback).
+ */
+class BandAggregator {
+
+    BandScale scale_; // the scale of the bands
+
+    int number_of_bins_; // the number of bins of the spectra aggregated
+
+    int sample_rate_; // the sample rate of the sound the spectra are of
+
+    std::vector<float> band_lower_edges_; // the frequency (in Hz) each band starts at
+
+    std::vector<float> band_upper_edges_; // the frequency (in Hz) each band ends at
+
+    std::vector<int> band_first_bins_; // the first bin each band covers
+
+    std::vector<int> band_weight_offsets_; // where the weights of each band start in weights_
+                                           // (band i's weights end where band i + 1's start)
+
+    std::vector<float> weights_; // the weight of each bin each band covers (the weights of a band add up to 1)
+
+    /**
+     * Fills in the edges of the bands of the scale, up to the given frequency.
+     */
+    void computeBandEdges(float maximum_frequency);
+
+    /**
+     * Computes the sparse weight table of the bands.
+     */
+    void computeWeights();
+
+public:
+
+    /**
+     * Constructor for a BandAggregator object, with third-octave bands (and no bins, till it is set up).
+     */
+    BandAggregator() noexcept;
+
+    /**
+     * Sets up the bands, recomputing the weight table only if something changed.
+     *
+     * @param scale - the scale of the bands
+     * @param number_of_bins - the number of bins of the spectra, bin k being centered on k * sample_rate / (2 * number_of_bins)
+     * @param sample_rate - the sample rate of the sound the spectra are of
+     */
+    void setup(BandScale scale, int number_of_bins, int sample_rate);
+
+    /**
+     * Getter for the scale of the bands.
+     */
+    BandScale getScale() const;
+
+    /**
+     * Getter for the number of bands (those below half the sample rate).
+     */
+    int getNumberOfBands() const;
+
+    /**
+     * Getter for the number of bins of the spectra the bands are set up for.
+     */
+    int getNumberOfBins() const;
+
+    /**
+     * Returns the band that covers the given frequency (the nearest band, if none does).
+     */
+    int getBandIndex(float frequency) const;
+
+    /**
+     * Returns the name of a scale (e.g. "THIRD OCTAVE"), as it is listed in the GUI.
+     */
+    static std::string getScaleName(BandScale scale);
+
+    /**
+     * Aggregates the bins of a spectrum into the bands.
+     *
+     * @param bin_values - the value of each bin
+     * @param band_values - set to the value of each band
+     */
+    void aggregate(const float * bin_values, std::vector<float> & band_values) const;
+
+};
+
+#endif /* BandAggregator_h */
@@ -0,0 +1,451 @@
+//
+//  BeatTracker.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "BeatTracker.h"
+#include <algorithm>
+#include <cmath>
+
+const int kWindowSize = 1024; // the number of frames analyzed at a time
+
+const int kHopSize = 512; // the number of frames from one window to the next (about 12 ms at 44.1 kHz)
+
+const int kFluxHistoryHops = 512; // the number of hops of flux kept (about 6 seconds at 44.1 kHz) to estimate the tempo from
+
+const float kLogCompression = 100; // how strongly the magnitudes are log-compressed (log(1 + 100 * magnitude)),
+                                   // so that quiet onsets count as well as loud ones
+
+const int kOnsetAverageHops = 16; // the number of hops (before a peak of the flux) the flux is averaged over
+
+const float kOnsetThresholdRatio = 1.5f; // how many times the average flux a peak must reach to be an onset
+
+const float kOnsetThresholdOffset = 0.002f; // how far above the average flux a peak must reach (so silence has no onsets)
+
+const float kMinimumOnsetGapSeconds = 0.1f; // the shortest time between two onsets
+
+const float kMinimumBeatGapSeconds = 0.25f; // the shortest time between two beats, till the tempo is known
+
+const float kMinimumBpm = 60; // the slowest tempo considered
+
+const float kMaximumBpm = 180; // the fastest tempo considered
+
+const float kPreferredBpm = 120; // the tempo the estimate is weighted towards (halving or doubling it is less likely)
+
+const float kTempoPriorOctaves = 0.6f; // how quickly the weight falls off away from the preferred tempo (in octaves)
+
+const float kMinimumTempoHistorySeconds = 3; // how many seconds of flux there must be before the tempo is estimated
+
+const float kMinimumPeriodicity = 0.2f; // how much of the variance of the flux the autocorrelation at the beat period
+                                       // must reach, for the flux to be taken as periodic
+
+const int kTempoUpdateHops = 16; // the number of hops between re-estimations of the tempo
+
+const float kBeatAlignmentTolerance = 0.25f; // how close (in beats) to a predicted beat an onset must be to align it
+
+/**
+ * Constructor for a BeatTracker object, with windows of 1024 frames every 512 frames.
+ */
+BeatTracker::BeatTracker() noexcept {
+
+    framer_.setup(kWindowSize, kHopSize);
+    fft_plan_ = FftBackend::getPlan(kWindowSize);
+
+    window_function_.resize(kWindowSize);
+    windowed_samples_.resize(kWindowSize);
+    fft_output_.resize(kWindowSize / 2 + 1);
+    log_magnitudes_.assign(kWindowSize / 2 + 1, 0);
+
+    float window_sum = 0;
+
+    for (int index = 0; index < kWindowSize; index++) {
+
+        window_function_[index] = 0.5f * (1 - cos(2 * M_PI * index / (kWindowSize - 1)));
+        window_sum += window_function_[index];
+    }
+
+    // Fold the normalization of the magnitudes (so a full-scale sine reads about 1) into the window.
+
+    for (int index = 0; index < kWindowSize; index++) {
+        window_function_[index] *= 2 / window_sum;
+    }
+
+    sample_rate_ = 44100;
+    beat_count_ = 0;
+
+    reset();
+
+}
+
+/**
+ * Forgets the onsets, tempo and beats so far.
+ */
+void BeatTracker::reset() {
+
+    framer_.reset();
+    expected_window_start_frame_ = -1;
+
+    beat_period_hops_ = 0;
+    startRun(0);
+
+}
+
+/**
+ * Starts a new run (the stream was sought, or switched), forgetting the onsets and beats so far.
+ */
+void BeatTracker::startRun(long long first_window_start_frame) {
+
+    first_hop_frame_ = first_window_start_frame + kWindowSize / 2;
+    number_of_hops_ = 0;
+
+    flux_history_.assign(kFluxHistoryHops, 0);
+    std::fill(log_magnitudes_.begin(), log_magnitudes_.end(), 0.0f);
+
+    last_onset_hop_ = -1;
+    onset_strength_ = 0;
+
+    // The tempo is kept (a seek stays within the song), but the beats are to be found again.
+    // (The number of beats keeps counting up, so that a new beat can always be told by it changing.)
+
+    next_beat_hop_ = 0;
+    last_beat_hop_ = -1e9;
+
+}
+
+/**
+ * Getter for the number of frames analyzed at a time.
+ */
+int BeatTracker::getWindowSize() const {
+
+    return kWindowSize;
+
+}
+
+/**
+ * Pushes frames of the stream, and tracks the onsets and beats of the windows they complete.
+ */
+void BeatTracker::push(const float * samples, int number_of_frames, int number_of_channels, int sample_rate,
+                       long long start_frame) {
+
+    // A stream at another sample rate is another stream (of another tempo, as far as the hops go).
+
+    if (sample_rate != sample_rate_) {
+
+        sample_rate_ = sample_rate;
+        reset();
+    }
+
+    mixer_.mix(samples, number_of_frames, number_of_channels);
+    framer_.push(mixer_.getChannel(0), number_of_frames, 1, start_frame);
+
+    const float * window;
+    long long window_start_frame;
+
+    while (framer_.popWindow(window, window_start_frame)) {
+
+        // If this window is not a hop after the last one, the framer has started over.
+
+        if (window_start_frame != expected_window_start_frame_) {
+            startRun(window_start_frame);
+        }
+
+        expected_window_start_frame_ = window_start_frame + kHopSize;
+
+        analyzeWindow(window);
+    }
+
+}
+
+/**
+ * Computes the spectral flux of a window, and tracks the onsets and beats it brings.
+ */
+void BeatTracker::analyzeWindow(const float * window) {
+
+    for (int index = 0; index < kWindowSize; index++) {
+        windowed_samples_[index] = window[index] * window_function_[index];
+    }
+
+    fft_plan_->transform(windowed_samples_.data(), fft_output_.data());
+
+    // The flux is how much the log-magnitudes rose (falls do not count) since the last window, per bin.
+    // (The first window of a run has nothing to rise from.)
+
+    long long hop = number_of_hops_;
+    int number_of_bins = log_magnitudes_.size();
+
+    float flux = 0;
+
+    for (int bin = 0; bin < number_of_bins; bin++) {
+
+        float log_magnitude = log1p(kLogCompression * std::abs(fft_output_[bin]));
+
+        flux += std::max(log_magnitude - log_magnitudes_[bin], 0.0f);
+        log_magnitudes_[bin] = log_magnitude;
+    }
+
+    flux_history_[hop % kFluxHistoryHops] = (hop == 0) ? 0 : flux / number_of_bins;
+    number_of_hops_++;
+
+    // Now that the flux of this hop is known, the hop before it can be told to be a peak (an onset) or not.
+
+    if (hop >= 2 && isOnset(hop - 1)) {
+
+        long long onset_hop = hop - 1;
+
+        float average = 0;
+
+        for (long long index = onset_hop - kOnsetAverageHops; index <= onset_hop; index++) {
+            average += getFlux(index);
+        }
+
+        average /= kOnsetAverageHops + 1;
+
+        onset_strength_ = std::min(getFlux(onset_hop) / (2 * (kOnsetThresholdRatio * average + kOnsetThresholdOffset)), 1.0f);
+        last_onset_hop_ = onset_hop;
+
+        double hops_per_second = (double) sample_rate_ / kHopSize;
+
+        if (beat_period_hops_ <= 0) {
+
+            // Till the tempo is known, the onsets are the beats.
+
+            if (onset_hop - last_beat_hop_ >= kMinimumBeatGapSeconds * hops_per_second) {
+                addBeat(onset_hop);
+            }
+
+        } else if (onset_hop - last_beat_hop_ <= kBeatAlignmentTolerance * beat_period_hops_) {
+
+            // The onset is just after the beat predicted before it: the beats were a little early,
+            // so align them with the onset (without counting another beat).
+
+            last_beat_hop_ = onset_hop;
+            next_beat_hop_ = onset_hop + beat_period_hops_;
+
+        } else if (onset_hop >= next_beat_hop_ - kBeatAlignmentTolerance * beat_period_hops_) {
+
+            // The onset is just before the beat predicted: it is the beat.
+
+            addBeat(onset_hop);
+        }
+    }
+
+    // Re-estimate the tempo every few hops, once there are a few seconds of flux.
+
+    if (hop % kTempoUpdateHops == 0 && hop >= kMinimumTempoHistorySeconds * sample_rate_ / kHopSize) {
+        estimateTempo();
+    }
+
+    // If the predicted beat has been reached without an onset on it, count it anyway
+    // (a beat is not always played).
+
+    if (beat_period_hops_ > 0 && last_beat_hop_ > -1e9 && hop >= next_beat_hop_) {
+        addBeat(next_beat_hop_);
+    }
+
+}
+
+/**
+ * Returns the spectral flux of a hop of the current run (0 before it).
+ */
+float BeatTracker::getFlux(long long hop) const {
+
+    if (hop < 0 || hop >= number_of_hops_ || hop < number_of_hops_ - kFluxHistoryHops) {
+        return 0;
+    }
+
+    return flux_history_[hop % kFluxHistoryHops];
+
+}
+
+/**
+ * Decides whether the hop before the last is an onset (a peak of the flux that stands out of the flux around it).
+ */
+bool BeatTracker::isOnset(long long hop) const {
+
+    // A peak is only weighed against the flux before it once the run has that much flux of its own
+    // (the first hop of a run has no flux, and before it there is none), so that the start of a run
+    // (a seek, a switch of track) does not count as an onset.
+
+    if (hop <= kOnsetAverageHops) {
+        return false;
+    }
+
+    float flux = getFlux(hop);
+
+    if (flux <= getFlux(hop - 1) || flux < getFlux(hop + 1)) {
+        return false;
+    }
+
+    if (last_onset_hop_ >= 0 && hop - last_onset_hop_ < kMinimumOnsetGapSeconds * sample_rate_ / kHopSize) {
+        return false;
+    }
+
+    float average = 0;
+
+    for (long long index = hop - kOnsetAverageHops; index <= hop; index++) {
+        average += getFlux(index);
+    }
+
+    average /= kOnsetAverageHops + 1;
+
+    return flux > kOnsetThresholdRatio * average + kOnsetThresholdOffset;
+
+}
+
+/**
+ * Re-estimates the beat period from the autocorrelation of the flux of the last few seconds.
+ */
+void BeatTracker::estimateTempo() {
+
+    int number_of_hops = (int) std::min(number_of_hops_, (long long) kFluxHistoryHops);
+    long long first_hop = number_of_hops_ - number_of_hops;
+
+    double hops_per_second = (double) sample_rate_ / kHopSize;
+
+    int minimum_lag = std::max((int) floor(60 * hops_per_second / kMaximumBpm), 1);
+    int maximum_lag = std::min((int) ceil(60 * hops_per_second / kMinimumBpm), number_of_hops / 2);
+
+    if (maximum_lag <= minimum_lag + 1) {
+        return;
+    }
+
+    float mean = 0;
+
+    for (int index = 0; index < number_of_hops; index++) {
+        mean += getFlux(first_hop + index);
+    }
+
+    mean /= number_of_hops;
+
+    float variance = 0;
+
+    for (int index = 0; index < number_of_hops; index++) {
+        variance += (getFlux(first_hop + index) - mean) * (getFlux(first_hop + index) - mean);
+    }
+
+    variance /= number_of_hops;
+
+    // Autocorrelate the flux (less its mean) at every lag considered, weighting each lag by how likely its tempo is.
+
+    autocorrelation_.assign(maximum_lag + 2, 0);
+
+    int best_lag = -1;
+
+    for (int lag = minimum_lag; lag <= maximum_lag + 1; lag++) {
+
+        float sum = 0;
+
+        for (int index = lag; index < number_of_hops; index++) {
+            sum += (getFlux(first_hop + index) - mean) * (getFlux(first_hop + index - lag) - mean);
+        }
+
+        float bpm = 60 * hops_per_second / lag;
+        float octaves_from_preferred = log2(bpm / kPreferredBpm) / kTempoPriorOctaves;
+
+        autocorrelation_[lag] = sum / (number_of_hops - lag) * exp(-0.5f * octaves_from_preferred * octaves_from_preferred);
+
+        if (lag <= maximum_lag && (best_lag < 0 || autocorrelation_[lag] > autocorrelation_[best_lag])) {
+            best_lag = lag;
+        }
+    }
+
+    if (best_lag < 0 || autocorrelation_[best_lag] <= kMinimumPeriodicity * variance) {
+
+        // The flux is hardly periodic (e.g. silence, or noise): keep the tempo as it was.
+
+        return;
+    }
+
+    // Refine the lag between whole hops, from the parabola through the best lag and its neighbours.
+
+    double period = best_lag;
+
+    if (best_lag > minimum_lag) {
+
+        float before = autocorrelation_[best_lag - 1];
+        float peak = autocorrelation_[best_lag];
+        float after = autocorrelation_[best_lag + 1];
+
+        float curvature = before - 2 * peak + after;
+
+        if (curvature < 0) {
+            period += 0.5 * (before - after) / curvature;
+        }
+    }
+
+    // Follow small drifts of the tempo smoothly, but jump to a new tempo at once.
+
+    if (beat_period_hops_ > 0 && fabs(period - beat_period_hops_) < 0.1 * beat_period_hops_) {
+
+        beat_period_hops_ = 0.75 * beat_period_hops_ + 0.25 * period;
+
+    } else {
+
+        beat_period_hops_ = period;
+
+        // Predict the next beat from the last beat (or onset).
+
+        double last_hop = std::max(last_beat_hop_, (double) last_onset_hop_);
+
+        if (last_hop >= 0) {
+
+            next_beat_hop_ = last_hop + beat_period_hops_;
+
+            while (next_beat_hop_ < number_of_hops_ - 1) {
+                next_beat_hop_ += beat_period_hops_;
+            }
+        }
+    }
+
+}
+
+/**
+ * Counts a beat at the given hop, and predicts the next one.
+ */
+void BeatTracker::addBeat(double hop) {
+
+    last_beat_hop_ = hop;
+    next_beat_hop_ = hop + beat_period_hops_;
+
+    beat_count_++;
+
+}
+
+/**
+ * Returns the position in the stream of the center of the window of a hop.
+ */
+double BeatTracker::getHopFrame(double hop) const {
+
+    return first_hop_frame_ + hop * kHopSize;
+
+}
+
+/**
+ * Returns the beats of the stream as of a position in it.
+ */
+BeatState BeatTracker::getState(long long frame) const {
+
+    BeatState state;
+
+    state.bpm = (beat_period_hops_ > 0) ? 60.0 * sample_rate_ / (beat_period_hops_ * kHopSize) : 0;
+    state.beat_count = beat_count_;
+    state.onset_strength = onset_strength_;
+
+    if (last_beat_hop_ <= -1e9) {
+
+        state.seconds_since_beat = 1000;
+        state.beat_phase = 0;
+
+        return state;
+    }
+
+    double frames_since_beat = std::max(frame - getHopFrame(last_beat_hop_), 0.0);
+
+    state.seconds_since_beat = frames_since_beat / sample_rate_;
+    state.beat_phase = (beat_period_hops_ > 0) ? fmod(frames_since_beat / (beat_period_hops_ * kHopSize), 1.0) : 0;
+
+    return state;
+
+}
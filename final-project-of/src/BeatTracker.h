@@ -0,0 +1,160 @@
+//
+//  BeatTracker.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef BeatTracker_h
+#define BeatTracker_h
+
+#include "FftBackend.h"
+#include "HopFramer.h"
+#include "ChannelMixer.h"
+#include <complex>
+#include <memory>
+#include <vector>
+
+/**
+ * The beats of the sound, as of a position in the stream: what the visualizers pulse with.
+ */
+struct BeatState {
+
+    float bpm; // the tempo, in beats per minute (0 till it has been estimated)
+
+    long long beat_count; // the number of beats so far (the visualizers can tell a new beat by it changing)
+
+    float seconds_since_beat; // the time (in seconds) since the last beat (a large value if there has been none)
+
+    float beat_phase; // how far into the current beat the position is, in [0, 1) (0 till the tempo is known)
+
+    float onset_strength; // how strong the latest onset was, in [0, 1] (relative to the onsets around it)
+
+};
+
+/**
+ * Class that tracks the beats of a stream of samples, incrementally: every frame pushed is analyzed once,
+ * however often (and however many frames at a time) they are pushed.
+ *
+ * - Onsets are detected from the spectral flux (how much the log-magnitude spectrum rises from one hop to
+ *   the next), peaks of which stand out of a moving average of the flux around them.
+ * - The tempo is the lag (between 60 and 180 BPM, weighted towards 120 BPM) at which the flux of the last
+ *   6 seconds autocorrelates the most, re-estimated every few hops.
+ * - Beats are predicted a beat period after the last one, and realigned with the onsets near them. A beat
+ *   is emitted at most a hop after it happens (when the onset on it, or the predicted time, is reached),
+ *   so that the visualizers pulse with a bounded latency, without looking ahead.
+ *
+ * Till the tempo is known, every onset (at most 4 a second) counts as a beat.
+ */
+class BeatTracker {
+
+    ChannelMixer mixer_; // the mixer which mixes the channels down to mono
+
+    HopFramer framer_; // the framer which cuts the stream into overlapping windows
+
+    std::shared_ptr<const FftPlan> fft_plan_; // the plan of the FFT (shared with the other analyzers)
+
+    std::vector<float> window_function_; // the Hann window
+
+    std::vector<float> windowed_samples_; // the windowed samples the FFT is computed of
+
+    std::vector<std::complex<float> > fft_output_; // the bins of the FFT
+
+    std::vector<float> log_magnitudes_; // the log-compressed magnitude of each bin of the last window
+
+    int sample_rate_; // the sample rate of the stream
+
+    long long first_hop_frame_; // the position in the stream of the center of the first window of the current run
+
+    long long expected_window_start_frame_; // where the next window of the current run starts (-1 if none)
+
+    long long number_of_hops_; // the number of windows analyzed in the current run
+
+    std::vector<float> flux_history_; // the spectral flux of the most recent hops, hop i being at i % size
+
+    long long last_onset_hop_; // the hop of the last onset (-1 if none)
+
+    float onset_strength_; // how strong the last onset was, in [0, 1]
+
+    double beat_period_hops_; // the estimated beat period, in hops (0 till it is known)
+
+    double next_beat_hop_; // the hop the next beat is predicted at
+
+    double last_beat_hop_; // the hop of the last beat (a large negative value if none)
+
+    long long beat_count_; // the number of beats so far
+
+    std::vector<float> autocorrelation_; // the autocorrelation of the flux at each lag considered
+
+    /**
+     * Starts a new run (the stream was sought, or switched), forgetting the onsets and beats so far.
+     */
+    void startRun(long long first_window_start_frame);
+
+    /**
+     * Computes the spectral flux of a window, and tracks the onsets and beats it brings.
+     */
+    void analyzeWindow(const float * window);
+
+    /**
+     * Returns the spectral flux of a hop of the current run (0 before it).
+     */
+    float getFlux(long long hop) const;
+
+    /**
+     * Decides whether the hop before the last is an onset (a peak of the flux that stands out of the flux around it).
+     */
+    bool isOnset(long long hop) const;
+
+    /**
+     * Re-estimates the beat period from the autocorrelation of the flux of the last few seconds.
+     */
+    void estimateTempo();
+
+    /**
+     * Counts a beat at the given hop, and predicts the next one.
+     */
+    void addBeat(double hop);
+
+    /**
+     * Returns the position in the stream of the center of the window of a hop.
+     */
+    double getHopFrame(double hop) const;
+
+public:
+
+    /**
+     * Constructor for a BeatTracker object, with windows of 1024 frames every 512 frames.
+     */
+    BeatTracker() noexcept;
+
+    /**
+     * Forgets the onsets, tempo and beats so far.
+     */
+    void reset();
+
+    /**
+     * Getter for the number of frames analyzed at a time (the fewest new frames to start analyzing from).
+     */
+    int getWindowSize() const;
+
+    /**
+     * Pushes frames of the stream, and tracks the onsets and beats of the windows they complete.
+     *
+     * @param samples - the interleaved samples of the frames (mixed down to mono for the analysis)
+     * @param number_of_frames - the number of frames
+     * @param number_of_channels - the number of interleaved channels
+     * @param sample_rate - the sample rate of the stream
+     * @param start_frame - the position in the stream of the first frame
+     */
+    void push(const float * samples, int number_of_frames, int number_of_channels, int sample_rate,
+              long long start_frame);
+
+    /**
+     * Returns the beats of the stream as of a position in it (e.g. the frame being heard).
+     */
+    BeatState getState(long long frame) const;
+
+};
+
+#endif /* BeatTracker_h */
@@ -0,0 +1,224 @@
+//
+//  ChannelMixer.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "ChannelMixer.h"
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define CHANNEL_MIXER_USE_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CHANNEL_MIXER_USE_NEON 1
+#endif
+
+/**
+ * Constructor for a ChannelMixer object, which mixes the channels down to mono (CHANNEL_MODE_MID).
+ */
+ChannelMixer::ChannelMixer() noexcept {
+
+    mode_ = CHANNEL_MODE_MID;
+    number_of_channels_ = 1;
+    number_of_frames_ = 0;
+
+}
+
+/**
+ * Sets the channels mixed.
+ */
+void ChannelMixer::setMode(ChannelMode mode) {
+
+    mode_ = mode;
+
+}
+
+/**
+ * Getter for the channels mixed.
+ */
+ChannelMode ChannelMixer::getMode() const {
+
+    return mode_;
+
+}
+
+/**
+ * Returns the mode after the given one (going back to the first after the last), to cycle through the modes.
+ */
+ChannelMode ChannelMixer::getNextMode(ChannelMode mode) {
+
+    return (mode == CHANNEL_MODE_BOTH) ? CHANNEL_MODE_LEFT : (ChannelMode) (mode + 1);
+
+}
+
+/**
+ * Returns the name of a mode (e.g. "Mid"), to be displayed.
+ */
+std::string ChannelMixer::getModeName(ChannelMode mode) {
+
+    switch (mode) {
+        case CHANNEL_MODE_LEFT:
+            return "Left";
+        case CHANNEL_MODE_RIGHT:
+            return "Right";
+        case CHANNEL_MODE_MID:
+            return "Mid";
+        case CHANNEL_MODE_SIDE:
+            return "Side";
+        case CHANNEL_MODE_BOTH:
+            return "Left + Right";
+    }
+
+    return "";
+
+}
+
+/**
+ * Mixes interleaved frames into the channels of the mode.
+ */
+int ChannelMixer::mix(const float * samples, int number_of_frames, int number_of_channels) {
+
+    number_of_channels_ = (mode_ == CHANNEL_MODE_BOTH) ? 2 : 1;
+    number_of_frames_ = number_of_frames;
+
+    for (int channel = 0; channel < number_of_channels_; channel++) {
+        channels_[channel].resize(number_of_frames);
+    }
+
+    float * first_output = channels_[0].data();
+    float * second_output = channels_[1].data();
+
+    int frame = 0;
+
+    // The left and right channels of a mono sound are the same.
+
+    int right_channel = (number_of_channels > 1) ? 1 : 0;
+
+#if defined(CHANNEL_MIXER_USE_SSE)
+
+    // For stereo, split four frames at a time into their left and right samples, and mix those.
+
+    if (number_of_channels == 2) {
+
+        __m128 half = _mm_set1_ps(0.5f);
+
+        for (; frame + 4 <= number_of_frames; frame += 4) {
+
+            __m128 first_two_frames = _mm_loadu_ps(samples + 2 * frame);
+            __m128 last_two_frames = _mm_loadu_ps(samples + 2 * frame + 4);
+
+            __m128 left = _mm_shuffle_ps(first_two_frames, last_two_frames, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 right = _mm_shuffle_ps(first_two_frames, last_two_frames, _MM_SHUFFLE(3, 1, 3, 1));
+
+            switch (mode_) {
+                case CHANNEL_MODE_LEFT:
+                    _mm_storeu_ps(first_output + frame, left);
+                    break;
+                case CHANNEL_MODE_RIGHT:
+                    _mm_storeu_ps(first_output + frame, right);
+                    break;
+                case CHANNEL_MODE_MID:
+                    _mm_storeu_ps(first_output + frame, _mm_mul_ps(_mm_add_ps(left, right), half));
+                    break;
+                case CHANNEL_MODE_SIDE:
+                    _mm_storeu_ps(first_output + frame, _mm_mul_ps(_mm_sub_ps(left, right), half));
+                    break;
+                case CHANNEL_MODE_BOTH:
+                    _mm_storeu_ps(first_output + frame, left);
+                    _mm_storeu_ps(second_output + frame, right);
+                    break;
+            }
+        }
+    }
+
+#elif defined(CHANNEL_MIXER_USE_NEON)
+
+    if (number_of_channels == 2) {
+
+        for (; frame + 4 <= number_of_frames; frame += 4) {
+
+            float32x4x2_t deinterleaved = vld2q_f32(samples + 2 * frame);
+
+            float32x4_t left = deinterleaved.val[0];
+            float32x4_t right = deinterleaved.val[1];
+
+            switch (mode_) {
+                case CHANNEL_MODE_LEFT:
+                    vst1q_f32(first_output + frame, left);
+                    break;
+                case CHANNEL_MODE_RIGHT:
+                    vst1q_f32(first_output + frame, right);
+                    break;
+                case CHANNEL_MODE_MID:
+                    vst1q_f32(first_output + frame, vmulq_n_f32(vaddq_f32(left, right), 0.5f));
+                    break;
+                case CHANNEL_MODE_SIDE:
+                    vst1q_f32(first_output + frame, vmulq_n_f32(vsubq_f32(left, right), 0.5f));
+                    break;
+                case CHANNEL_MODE_BOTH:
+                    vst1q_f32(first_output + frame, left);
+                    vst1q_f32(second_output + frame, right);
+                    break;
+            }
+        }
+    }
+
+#endif
+
+    for (; frame < number_of_frames; frame++) {
+
+        float left = samples[frame * number_of_channels];
+        float right = samples[frame * number_of_channels + right_channel];
+
+        switch (mode_) {
+            case CHANNEL_MODE_LEFT:
+                first_output[frame] = left;
+                break;
+            case CHANNEL_MODE_RIGHT:
+                first_output[frame] = right;
+                break;
+            case CHANNEL_MODE_MID:
+                first_output[frame] = (left + right) * 0.5f;
+                break;
+            case CHANNEL_MODE_SIDE:
+                first_output[frame] = (left - right) * 0.5f;
+                break;
+            case CHANNEL_MODE_BOTH:
+                first_output[frame] = left;
+                second_output[frame] = right;
+                break;
+        }
+    }
+
+    return number_of_channels_;
+
+}
+
+/**
+ * Getter for the number of channels mixed by the last call to mix().
+ */
+int ChannelMixer::getNumberOfChannels() const {
+
+    return number_of_channels_;
+
+}
+
+/**
+ * Getter for the number of frames mixed by the last call to mix().
+ */
+int ChannelMixer::getNumberOfFrames() const {
+
+    return number_of_frames_;
+
+}
+
+/**
+ * Getter for the samples of a channel mixed by the last call to mix() (valid till the next call).
+ */
+const float * ChannelMixer::getChannel(int channel) const {
+
+    return channels_[channel].data();
+
+}
@@ -0,0 +1,98 @@
+//
+//  ChannelMixer.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef ChannelMixer_h
+#define ChannelMixer_h
+
+#include <string>
+#include <vector>
+
+/**
+ * The channels of the sound a visualizer analyzes.
+ */
+enum ChannelMode {
+    CHANNEL_MODE_LEFT, // the left channel
+    CHANNEL_MODE_RIGHT, // the right channel
+    CHANNEL_MODE_MID, // the mono downmix, (left + right) / 2
+    CHANNEL_MODE_SIDE, // the difference of the channels, (left - right) / 2 (what the stereo image adds to the mono downmix)
+    CHANNEL_MODE_BOTH // the left and right channels, each analyzed on its own
+};
+
+/**
+ * Class that mixes interleaved frames into the channels a visualizer analyzes (according to the channel mode),
+ * as separate (planar) streams of samples, so that the analysis is done either once, on a mono mix, or
+ * twice, on the left and right channels.
+ *
+ * Stereo frames (the usual case) are mixed four frames at a time (SSE on x86, NEON on ARM, with a scalar
+ * fallback). A mono sound is taken as having the same left and right channel; of a sound with more than two
+ * channels, the first two are taken as the left and right channel.
+ */
+class ChannelMixer {
+
+    ChannelMode mode_; // the channels mixed
+
+    std::vector<float> channels_[2]; // the samples of each channel mixed
+
+    int number_of_channels_; // the number of channels mixed (2 in the CHANNEL_MODE_BOTH mode, otherwise 1)
+
+    int number_of_frames_; // the number of frames mixed
+
+public:
+
+    /**
+     * Constructor for a ChannelMixer object, which mixes the channels down to mono (CHANNEL_MODE_MID).
+     */
+    ChannelMixer() noexcept;
+
+    /**
+     * Sets the channels mixed.
+     */
+    void setMode(ChannelMode mode);
+
+    /**
+     * Getter for the channels mixed.
+     */
+    ChannelMode getMode() const;
+
+    /**
+     * Returns the mode after the given one (going back to the first after the last), to cycle through the modes.
+     */
+    static ChannelMode getNextMode(ChannelMode mode);
+
+    /**
+     * Returns the name of a mode (e.g. "Mid"), to be displayed.
+     */
+    static std::string getModeName(ChannelMode mode);
+
+    /**
+     * Mixes interleaved frames into the channels of the mode.
+     *
+     * @param samples - the interleaved samples of the frames
+     * @param number_of_frames - the number of frames
+     * @param number_of_channels - the number of interleaved channels
+     * @return the number of channels mixed
+     */
+    int mix(const float * samples, int number_of_frames, int number_of_channels);
+
+    /**
+     * Getter for the number of channels mixed by the last call to mix().
+     */
+    int getNumberOfChannels() const;
+
+    /**
+     * Getter for the number of frames mixed by the last call to mix().
+     */
+    int getNumberOfFrames() const;
+
+    /**
+     * Getter for the samples of a channel mixed by the last call to mix() (valid till the next call).
+     */
+    const float * getChannel(int channel) const;
+
+};
+
+#endif /* ChannelMixer_h */
@@ -0,0 +1,194 @@
+//
+//  DecodedTrack.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "DecodedTrack.h"
+#include "audiodecoder.h"
+
+const int kDecodeChunkSize = 65536; // the number of samples decoded at a time
+
+/**
+ * Constructor for an (empty) DecodedTrack object.
+ */
+DecodedTrack::DecodedTrack() noexcept {
+    
+    number_of_channels_ = 2;
+    sample_rate_ = 44100;
+    number_of_frames_ = 0;
+    
+}
+
+/**
+ * Decodes the whole audio (.wav or .mp3) file at the given path (relative to the data directory).
+ *
+ * @return whether the file could be decoded (and the decoding was not abandoned)
+ */
+bool DecodedTrack::load(const std::string & path, std::function<bool(float)> on_progress) {
+    
+    // The decoder is the one ofxAudioDecoder (and so ofSoundPlayerExtended) uses.
+    
+    AudioDecoder decoder(ofToDataPath(path));
+    
+    if (decoder.open() != AUDIODECODER_OK) {
+        
+        ofLogError("DecodedTrack") << "Could not decode " << path;
+        return false;
+        
+    }
+    
+    path_ = path;
+    number_of_channels_ = decoder.channels();
+    sample_rate_ = decoder.sampleRate();
+    
+    // Decode all the samples, a chunk at a time, till the decoder runs out of them. The number of samples
+    // reported up front can be an estimate (e.g. for mp3 files), so the buffer is sized for it, and only
+    // grown if the file turns out to be longer (once the decoder has samples left over when it is full).
+    
+    long long estimated_number_of_samples = std::max(decoder.numSamples(), 0);
+    
+    samples_.resize(estimated_number_of_samples);
+    
+    std::vector<float> overflow_samples;
+    
+    long long samples_read = 0;
+    
+    while (true) {
+        
+        int chunk_samples_read;
+        
+        if (samples_read < (long long) samples_.size()) {
+            
+            int samples_to_read = (int) std::min((long long) kDecodeChunkSize, (long long) samples_.size() - samples_read);
+            chunk_samples_read = decoder.read(samples_to_read, &samples_[samples_read]);
+            
+        } else {
+            
+            overflow_samples.resize(kDecodeChunkSize);
+            chunk_samples_read = decoder.read(kDecodeChunkSize, overflow_samples.data());
+            
+            if (chunk_samples_read > 0) {
+                
+                samples_.resize(std::max(samples_read + chunk_samples_read, (long long) samples_.size() * 3 / 2));
+                std::copy(overflow_samples.begin(), overflow_samples.begin() + chunk_samples_read,
+                          samples_.begin() + samples_read);
+            }
+        }
+        
+        if (chunk_samples_read <= 0) {
+            break;
+        }
+        
+        samples_read += chunk_samples_read;
+        
+        float progress = (estimated_number_of_samples > 0)
+                       ? std::min((float) samples_read / estimated_number_of_samples, 1.0f) : 0;
+        
+        if (on_progress && !on_progress(progress)) {
+            
+            samples_.clear();
+            number_of_frames_ = 0;
+            return false;
+            
+        }
+    }
+    
+    // Trim the buffer to the samples decoded (giving back the room left over, if the estimate was off).
+    
+    samples_.resize(samples_read - samples_read % number_of_channels_);
+    
+    if (samples_.capacity() > samples_.size()) {
+        samples_.shrink_to_fit();
+    }
+    
+    number_of_frames_ = samples_.size() / number_of_channels_;
+    
+    return true;
+    
+}
+
+/**
+ * Getter for the path of the audio file the track was decoded from.
+ */
+const std::string & DecodedTrack::getPath() const {
+    
+    return path_;
+    
+}
+
+/**
+ * Getter for the interleaved samples of the track.
+ */
+const std::vector<float> & DecodedTrack::getSamples() const {
+    
+    return samples_;
+    
+}
+
+/**
+ * Getter for the number of channels of the track.
+ */
+int DecodedTrack::getNumberOfChannels() const {
+    
+    return number_of_channels_;
+    
+}
+
+/**
+ * Getter for the sample rate of the track.
+ */
+int DecodedTrack::getSampleRate() const {
+    
+    return sample_rate_;
+    
+}
+
+/**
+ * Getter for the number of frames (samples per channel) of the track.
+ */
+long long DecodedTrack::getNumberOfFrames() const {
+    
+    return number_of_frames_;
+    
+}
+
+/**
+ * Returns the number of bytes of memory the samples of the track take up.
+ */
+size_t DecodedTrack::getMemoryUsage() const {
+    
+    return samples_.capacity() * sizeof(float);
+    
+}
+
+/**
+ * Copies a window of frames of the track into an array of interleaved samples.
+ * Frames outside the track are either wrapped around (if loop is true) or silent.
+ */
+void DecodedTrack::readFrames(long long start_frame, int number_of_frames, float * samples, bool loop) const {
+    
+    for (int frame = 0; frame < number_of_frames; frame++) {
+        
+        long long track_frame = start_frame + frame;
+        
+        if (loop && number_of_frames_ > 0) {
+            
+            track_frame %= number_of_frames_;
+            
+            if (track_frame < 0) {
+                track_frame += number_of_frames_;
+            }
+        }
+        
+        bool is_in_track = track_frame >= 0 && track_frame < number_of_frames_;
+        
+        for (int channel = 0; channel < number_of_channels_; channel++) {
+            
+            samples[frame * number_of_channels_ + channel] =
+                    is_in_track ? samples_[track_frame * number_of_channels_ + channel] : 0;
+        }
+    }
+    
+}
@@ -0,0 +1,91 @@
+//
+//  DecodedTrack.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef DecodedTrack_h
+#define DecodedTrack_h
+
+#include "AudioSource.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Class that models a track which has been decoded (once) into interleaved float PCM samples.
+ *
+ * After load() returns, the samples are never modified, so they can be read from
+ * any thread (the audio output thread, the frame pipeline's worker, ...).
+ *
+ * The whole track is held in memory; for long tracks, see StreamingTrack.
+ */
+class DecodedTrack : public AudioSource {
+    
+    std::string path_; // the path of the audio file the track was decoded from
+    
+    std::vector<float> samples_; // the interleaved samples of the track
+    
+    int number_of_channels_; // the number of channels of the track
+    
+    int sample_rate_; // the sample rate of the track
+    
+    long long number_of_frames_; // the number of frames (samples per channel) of the track
+    
+public:
+    
+    /**
+     * Constructor for an (empty) DecodedTrack object.
+     */
+    DecodedTrack() noexcept;
+    
+    /**
+     * Decodes the whole audio (.wav or .mp3) file at the given path (relative to the data directory).
+     *
+     * @param path - the path of the audio file
+     * @param on_progress - (optional) called with the fraction of the file decoded so far after every chunk;
+     *                      the decoding is abandoned if it returns false
+     * @return whether the file could be decoded (and the decoding was not abandoned)
+     */
+    bool load(const std::string & path, std::function<bool(float)> on_progress = nullptr);
+    
+    /**
+     * Getter for the path of the audio file the track was decoded from.
+     */
+    const std::string & getPath() const;
+    
+    /**
+     * Getter for the interleaved samples of the track.
+     */
+    const std::vector<float> & getSamples() const;
+    
+    /**
+     * Getter for the number of channels of the track.
+     */
+    int getNumberOfChannels() const;
+    
+    /**
+     * Getter for the sample rate of the track.
+     */
+    int getSampleRate() const;
+    
+    /**
+     * Getter for the number of frames (samples per channel) of the track.
+     */
+    long long getNumberOfFrames() const;
+    
+    /**
+     * Returns the number of bytes of memory the samples of the track take up.
+     */
+    size_t getMemoryUsage() const;
+    
+    /**
+     * Copies a window of frames of the track into an array of interleaved samples.
+     * Frames outside the track are either wrapped around (if loop is true) or silent.
+     */
+    void readFrames(long long start_frame, int number_of_frames, float * samples, bool loop) const;
+    
+};
+
+#endif /* DecodedTrack_h */
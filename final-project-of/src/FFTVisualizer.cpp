@@ -8,6 +8,18 @@
 #include <stdio.h>
 #include "FFTVisualizer.h"
 
+const int kStftWindowSize = 2048; // the number of samples the STFT analyzes at a time
+
+const int kStftHopSize = 512; // the number of samples from one STFT window to the next
+
+const int kStftSpectraKept = 32; // the number of STFT spectra kept to be sampled from
+
+const FrameColor kChannelBarColors[2] = {{153, 204, 255, 255}, // the colours the frequency bars of each channel are
+                                         {255, 153, 204, 160}}; // drawn in (light blue, and translucent pink over it)
+
+const FrameColor kChannelWaveformColors[2] = {{51, 51, 255, 255}, // the colours the time waveform of each channel is
+                                              {255, 51, 153, 200}}; // drawn in (dark blue, and pink)
+
 /**
  * Constructor for an FFTVisualizer object that initializes
  * resources for the object
@@ -17,24 +29,38 @@ FFTVisualizer::FFTVisualizer() noexcept {
     // Set the music sample rate to the default, commonly used value - 44,100.
     sample_rate_ = 44100;
     
-    // Set the number of bands to 1024.
+    // The frequency bars show the spectrum of an STFT run over every sample of the song: windows of 2048
+    // samples (which gives 1025 bands, detailed enough to fill the space of the visualization), every
+    // 512 samples. The spectrum is sampled at the end of the current window, so no sound is skipped,
+    // whatever the frame rate.
     //
-    // You might notice that I am using 1024 bands instead of the usual 256 bands.
-    // This is because, since I have more space for the visualization, I wish to make it more detailed
-    // and accurate.
+    // By default, the channels are mixed down to mono (and analyzed once). In the CHANNEL_MODE_BOTH mode,
+    // the left and right channels each have an STFT of their own, run one after the other on the frame
+    // pipeline's worker thread (which keeps the frame computation to a single job, with no threads started
+    // or synchronized per frame).
     
-    number_of_bands_ = 1024;
+    for (int channel = 0; channel < 2; channel++) {
+        stft_analyzers_[channel].setup(kStftWindowSize, kStftHopSize, kStftSpectraKept);
+    }
     
-    // The number of audio channels of the music.
-    // It is set to 2. (The left and right channel.)
-    //
-    // Note that, I only use 1 channel for my visualization currently.
+    number_of_analyzed_channels_ = 1;
     
-    int number_of_channels = 2;
+    // By default, the time waveform shows the last 1024 samples.
+    // Since 1024 samples is a lot of detail for the time waveform, it is drawn in columns of 4 pixels
+    // (each showing the range of its samples), which makes it look much less blurry.
     
-    // Set up the audio analyzer (the ofxAddon which uses the Essentia Music Library).
+    waveform_window_size_ = 1024;
+    waveform_column_width_ = 4;
+    waveform_number_of_channels_ = 0;
     
-    audio_analyzer_.setup(sample_rate_, number_of_bands_, number_of_channels);
+    // Each bin of the spectrum has a frequency bar of its own.
+    
+    bins_per_bar_ = 1;
+    
+    // The history view of the time waveform scrolls through the last 5 seconds of the track.
+    
+    is_history_view_ = false;
+    history_length_ = 5;
     
 }
 
@@ -44,113 +70,318 @@ FFTVisualizer::FFTVisualizer() noexcept {
  *
  * @param sound_buffer - the sound buffer which
  *                              contains sound for the moment, to be updated with
+ * @param window_start_frame - the position in the track (in frames) of the first frame of the sound buffer
+ * @param new_sound_buffer - the frames which have not been analyzed yet (up to the end of the sound buffer)
+ * @param new_start_frame - the position in the track (in frames) of the first frame of new_sound_buffer
  */
-void FFTVisualizer::update(ofSoundBuffer sound_buffer) {
+void FFTVisualizer::update(ofSoundBuffer sound_buffer, long long window_start_frame,
+                           const ofSoundBuffer & new_sound_buffer, long long new_start_frame) {
     
-    // Let the audio analyzer analyze the current sound buffer.
-    audio_analyzer_.analyze(sound_buffer);
+    sample_rate_ = sound_buffer.getSampleRate();
     
-    // From the analyzer, get the sound spectrum.
-    sound_spectrum_ = audio_analyzer_.getValues(SPECTRUM, 0);
+    // Mix the frames which have not been analyzed yet into the channels analyzed,
+    // and run the STFT of each channel over them.
+    
+    number_of_analyzed_channels_ = analysis_mixer_.mix(new_sound_buffer.getBuffer().data(),
+                                                       new_sound_buffer.getNumFrames(),
+                                                       new_sound_buffer.getNumChannels());
+    
+    for (int channel = 0; channel < number_of_analyzed_channels_; channel++) {
+        stft_analyzers_[channel].push(analysis_mixer_.getChannel(channel), analysis_mixer_.getNumberOfFrames(),
+                                      1, new_start_frame);
+    }
+    
+    // Sample the spectrum of the most recent STFT window (centered half a window before the end of the
+    // current window), and convert it to the scale the frequency bars are drawn on (as log10 of the
+    // magnitudes, which is how the audio analyzer reports its spectrum).
+    
+    long long window_end_frame = window_start_frame + sound_buffer.getNumFrames();
+    
+    for (int channel = 0; channel < number_of_analyzed_channels_; channel++) {
+        
+        if (stft_analyzers_[channel].sample(window_end_frame - kStftWindowSize / 2.0, stft_magnitudes_)) {
+            
+            std::vector<float> & sound_spectrum = sound_spectra_[channel];
+            sound_spectrum.resize(stft_magnitudes_.size());
+            
+            for (int bin = 0; bin < (int) stft_magnitudes_.size(); bin++) {
+                sound_spectrum[bin] = std::max(log10(std::max(stft_magnitudes_[bin], 1e-20f)), (float) DB_MIN);
+            }
+        }
+    }
+    
+    // Store the most recent samples of the time waveform window, mixed into the channels drawn.
+    // They are mapped to screen coordinates when the frame is computed.
+    // (Assigning to the vectors keeps their capacity.)
+    
+    int number_of_channels = sound_buffer.getNumChannels();
+    int number_of_frames = std::min((int) sound_buffer.getNumFrames(), waveform_window_size_);
+    
+    const std::vector<float> & samples = sound_buffer.getBuffer();
+    
+    waveform_number_of_channels_ = waveform_mixer_.mix(samples.data() + samples.size() - number_of_frames * number_of_channels,
+                                                       number_of_frames, number_of_channels);
+    
+    for (int channel = 0; channel < waveform_number_of_channels_; channel++) {
+        
+        const float * channel_samples = waveform_mixer_.getChannel(channel);
+        waveform_samples_[channel].assign(channel_samples, channel_samples + number_of_frames);
+    }
     
-    // Clear the current time waveform line structure.
-    time_waveform_.clear();
+    // Add the samples of the window which have not been seen before to the track's min/max pyramid.
     
-    // For each sample within the buffer,
-    // set a new x and y coordinate for that vertex in the time waveform.
+    long long pyramid_end_frame = track_waveform_.getNumberOfFrames();
     
-    for(int index = 0; index < sound_buffer.getNumFrames(); index += 4) {
+    if (window_end_frame < pyramid_end_frame) {
         
-        // Get the sample at the current index from the first channel.
-        float sample = sound_buffer.getSample(index, 0);
+        // The track has been restarted, looped or sought backwards.
         
-        // Assign x and y coordinates for the vertex.
+        track_waveform_.clear();
+        pyramid_end_frame = 0;
         
-        float x = ofMap(index, 0, sound_buffer.getNumFrames(), 0, ofGetWidth());
-        float y = ofMap(sample, - 0.375, 0.375, 0, ofGetHeight() * 0.5) + (ofGetHeight() * 0.5);
+    }
+    
+    if (window_start_frame > pyramid_end_frame) {
+        
+        // Some frames were never seen (e.g. after seeking forward, or a long frame).
+        
+        track_waveform_.skip(window_start_frame - pyramid_end_frame);
+        pyramid_end_frame = window_start_frame;
         
-        // Add the vertex to the waveform structure.
-        time_waveform_.addVertex(x, y);
     }
     
+    int first_new_frame = pyramid_end_frame - window_start_frame;
+    
+    track_waveform_.append(samples.data() + first_new_frame * number_of_channels,
+                           sound_buffer.getNumFrames() - first_new_frame, number_of_channels);
+    
 }
 
 /**
- * The following function is responsible for drawing
+ * The following function is responsible for computing
  * the time waveform and associated
- * frequency bars.
+ * frequency bars to be drawn.
+ *
+ * @param frame - the frame to fill in with the primitives to be drawn
+ * @param window_width - the width of the window the frame is drawn to
+ * @param window_height - the height of the window the frame is drawn to
  */
-void FFTVisualizer::draw() {
+void FFTVisualizer::computeFrame(VisualizerFrame & frame, int window_width, int window_height) {
+    
+    frame.reset(window_width, window_height);
     
     // Set the background color to gray.
-    ofBackground(34, 34, 34);
+    
+    frame.has_background = true;
+    frame.background_color = FrameColor{34, 34, 34, 255};
     
     // Set line width to 2.5 for the waveform.
-    ofSetLineWidth(2.5);
+    
+    FrameLayer & waveform_layer = frame.addLayer(0, 0, 2.5);
     
     // Set color to dark blue for drawing the waveform.
-    ofSetColor(51, 51, 255);
     
-    // Draw the time waveform.
-    time_waveform_.draw();
+    waveform_layer.polyline_color = kChannelWaveformColors[0];
     
-    // Get the width of the screen.
-    int length_of_frequency_bar_plot = ofGetWidth();
+    // Map the samples to the vertices of the time waveform, in one pass.
+    // The samples in [-0.375, 0.375] are mapped to the lower half of the screen, and if there are more
+    // samples than columns, each column shows the minimum and maximum of its samples.
     
-    // Store the coordinate system, then shift it.
-    ofPushMatrix();
-    ofTranslate(0, 50);
+    waveform_mapper_.setup(0, window_width, - 0.375, 0.375, window_height * 0.5, window_height);
     
-    // Set the color to light blue. // ofSetColor(51, 255, 187);
+    int number_of_columns = std::max(window_width / waveform_column_width_, 1);
     
-    ofSetColor(153, 204, 255);
+    if (is_history_view_) {
+        
+        // Query the envelope of the last few seconds of the track from the pyramid.
+        // This costs O(number of columns), however long the span is.
+        
+        long long end_frame = track_waveform_.getNumberOfFrames();
+        long long start_frame = end_frame - (long long) (history_length_ * sample_rate_);
+        
+        track_waveform_.query(start_frame, end_frame, number_of_columns, history_minimums_, history_maximums_);
+        
+        // Columns without samples (before the start of the track) are drawn as silence.
+        
+        for (int column = 0; column < number_of_columns; column++) {
+            
+            if (history_minimums_[column] > history_maximums_[column]) {
+                
+                history_minimums_[column] = 0;
+                history_maximums_[column] = 0;
+                
+            }
+        }
+        
+        waveform_mapper_.mapEnvelope(history_minimums_.data(), history_maximums_.data(), number_of_columns,
+                                     waveform_layer.polyline);
+        
+    } else {
+        
+        // Each channel drawn is a polyline of its own (the right channel's in a layer over the left's).
+        
+        for (int channel = 0; channel < waveform_number_of_channels_; channel++) {
+            
+            FrameLayer & channel_layer = (channel == 0) ? waveform_layer : frame.addLayer(0, 0, 2.5);
+            channel_layer.polyline_color = kChannelWaveformColors[channel];
+            
+            waveform_mapper_.map(waveform_samples_[channel].data(), waveform_samples_[channel].size(), 1, 0,
+                                 number_of_columns, channel_layer.polyline);
+        }
+        
+    }
+    
+    // Shift the coordinate system for the frequency bars.
     
-    // Decide the width of each bar to be drawn.
-    float bar_width = (float) length_of_frequency_bar_plot / sound_spectrum_.size();
+    FrameLayer & bars_layer = frame.addLayer(0, 50);
     
-    // For each band, compute a bar height, then draw it.
+    // Draw the bars of each channel analyzed (the right channel's translucent, over the left's).
     
-    for (int band_number = 0; band_number < sound_spectrum_.size(); band_number++){
+    for (int channel = 0; channel < number_of_analyzed_channels_; channel++) {
         
-        // Compute the bar height.
+        const std::vector<float> & sound_spectrum = sound_spectra_[channel];
         
-        float height_multiplier = ofMap(sound_spectrum_[band_number ], DB_MIN, DB_MAX, 0.0, 1.0, true);
-        float bar_height = (- 1.25) * (height_multiplier * ofGetHeight()/2);
+        // Decide the width of each bar to be drawn, so that the bars fill the width of the screen.
+        // Each bar shows the loudest of its bins.
         
-        // Draw the bar.
+        int number_of_bars = (sound_spectrum.size() + bins_per_bar_ - 1) / bins_per_bar_;
+        float bar_width = (float) window_width / number_of_bars;
         
-        ofDrawRectangle(band_number * bar_width, ofGetHeight()/2, bar_width, bar_height);
+        // For each bar, compute a bar height, then add it.
         
+        for (int band_number = 0; band_number < number_of_bars; band_number++){
+            
+            int first_bin = band_number * bins_per_bar_;
+            int end_bin = std::min(first_bin + bins_per_bar_, (int) sound_spectrum.size());
+            
+            float band_value = *std::max_element(sound_spectrum.begin() + first_bin, sound_spectrum.begin() + end_bin);
+            
+            // Compute the bar height.
+            
+            float height_multiplier = ofMap(band_value, DB_MIN, DB_MAX, 0.0, 1.0, true);
+            float bar_height = (- 1.25) * (height_multiplier * window_height / 2);
+            
+            // Add the bar, in the channel's colour.
+            
+            FrameRectangle bar = {band_number * bar_width, (float) (window_height / 2), bar_width, bar_height,
+                                  kChannelBarColors[channel]};
+            bars_layer.rectangles.push_back(bar);
+            
+        }
     }
     
-    // Restore original coordinate system.
-    ofPopMatrix();
+    FrameLayer & labels_layer = frame.addLayer(0, 0);
     
     // Draw a separating line between the waveform and bars plot.
     
-    ofSetColor(100);
-    ofDrawLine(0, ofGetHeight()/2 + 50, ofGetWidth(), ofGetHeight()/2 + 50);
+    FrameLine separator = {0, (float) (window_height / 2 + 50), 0, (float) window_width, (float) (window_height / 2 + 50), 0,
+                           {100, 100, 100, 255}};
+    labels_layer.lines.push_back(separator);
     
     // Display Time Waveform and Frequency Waveform for the respective visualizations.
     
-    // First, load the font.
+    FrameText frequency_label = {"Frequency Bars (" + ChannelMixer::getModeName(getChannelMode()) + ")", 10, 20, 10,
+                                 {255, 255, 255, 255}};
+    labels_layer.texts.push_back(frequency_label);
+    
+    FrameText waveform_label = {is_history_view_ ? "Time Waveform (last " + ofToString(history_length_, 0) + " s)"
+                                                 : "Time Waveform",
+                                10, (float) (20 + window_height / 2 + 50), 10, {255, 255, 255, 255}};
+    labels_layer.texts.push_back(waveform_label);
+    
+}
+
+/**
+ * Getter for the number of bands of the visualizer (the number of bins of the STFT).
+ */
+int FFTVisualizer::getNumberOfBands() {
+    
+    return stft_analyzers_[0].getNumberOfBins();
     
-    ofTrueTypeFont temporary_font_loader_;
-    temporary_font_loader_.load("helvetica.ttf", 10);
+}
+
+/**
+ * Sets the channels of the sound which are analyzed and drawn (starting the analysis over).
+ */
+void FFTVisualizer::setChannelMode(ChannelMode mode) {
+    
+    analysis_mixer_.setMode(mode);
+    waveform_mixer_.setMode(mode);
     
-    // Then, display the messages.
+    // The spectra so far are of other channels.
+    
+    for (int channel = 0; channel < 2; channel++) {
+        
+        stft_analyzers_[channel].reset();
+        sound_spectra_[channel].clear();
+    }
     
-    ofSetColor(255, 255, 255);
-    temporary_font_loader_.drawString("Frequency Bars", 10, 20);
-    temporary_font_loader_.drawString("Time Waveform", 10, 20 + ofGetHeight()/2 + 50);
+    number_of_analyzed_channels_ = (mode == CHANNEL_MODE_BOTH) ? 2 : 1;
     
 }
 
 /**
- * Getter for the number of bands of the visualizer.
+ * Getter for the channels of the sound which are analyzed and drawn.
  */
-int FFTVisualizer::getNumberOfBands() {
+ChannelMode FFTVisualizer::getChannelMode() const {
+    
+    return analysis_mixer_.getMode();
+    
+}
+
+/**
+ * Getter for the number of samples of the sound buffers the visualizer is to be updated with
+ * (the time waveform window size).
+ */
+int FFTVisualizer::getWindowSize() {
+    
+    return waveform_window_size_;
+    
+}
+
+/**
+ * Getter for the number of samples the STFT analyzes at a time
+ * (the fewest new frames the visualizer can start analyzing from).
+ */
+int FFTVisualizer::getAnalysisWindowSize() {
+    
+    return stft_analyzers_[0].getWindowSize();
+    
+}
+
+/**
+ * Sets the number of samples shown in the time waveform (up to 16384, for high-resolution displays).
+ */
+void FFTVisualizer::setWaveformWindowSize(int window_size) {
+    
+    waveform_window_size_ = ofClamp(window_size, 1, 16384);
+    
+}
+
+/**
+ * Sets the width (in pixels) of the columns the time waveform is decimated into.
+ */
+void FFTVisualizer::setWaveformColumnWidth(int column_width) {
+    
+    waveform_column_width_ = std::max(column_width, 1);
+    
+}
+
+/**
+ * Sets the number of bins of the spectrum each frequency bar shows (the loudest of).
+ */
+void FFTVisualizer::setBinsPerBar(int bins_per_bar) {
+    
+    bins_per_bar_ = std::max(bins_per_bar, 1);
+    
+}
+
+/**
+ * Switches the time waveform between showing the current window and
+ * scrolling through the last few seconds of the track.
+ */
+void FFTVisualizer::toggleWaveformView() {
     
-    return number_of_bands_;
+    is_history_view_ = !is_history_view_;
     
 }
@@ -9,6 +9,11 @@
 #include "ofxGui.h"
 #include "ofxAudioAnalyzer.h"
 #include "ofSoundPlayerExtended.h"
+#include "VisualizerFrame.h"
+#include "WaveformMapper.h"
+#include "WaveformPyramid.h"
+#include "StftAnalyzer.h"
+#include "ChannelMixer.h"
 #include <iostream>
 
 #ifndef FFTVisualizer_h
@@ -19,15 +24,42 @@
  */
 class FFTVisualizer {
     
-    ofxAudioAnalyzer audio_analyzer_; // the audio analyzer that obtains frequency band values and spectrum
+    ChannelMixer analysis_mixer_; // the mixer which mixes the new frames into the channels analyzed
     
-    std::vector<float> sound_spectrum_; // the float array storing the sound spectrum values
+    ChannelMixer waveform_mixer_; // the mixer which mixes the current window into the channels drawn
     
-    ofPolyline time_waveform_; // the line structure storing the current time waveform
+    StftAnalyzer stft_analyzers_[2]; // the analyzers which compute the spectra of every hop of each channel analyzed
     
-    int sample_rate_; // the sample rate of the music
+    int number_of_analyzed_channels_; // the number of channels analyzed (2 in the CHANNEL_MODE_BOTH mode, otherwise 1)
+    
+    std::vector<float> stft_magnitudes_; // the magnitudes of the spectrum sampled from the STFT
+    
+    std::vector<float> sound_spectra_[2]; // the float arrays storing the sound spectrum values (log-scaled) of each channel
+    
+    std::vector<float> waveform_samples_[2]; // the float arrays storing the samples of the current time waveform of each channel
+    
+    int waveform_number_of_channels_; // the number of channels of the current time waveform
+    
+    WaveformMapper waveform_mapper_; // the kernel which maps the time waveform to screen coordinates
+    
+    int waveform_window_size_; // the number of samples (per channel) shown in the time waveform
+    
+    int waveform_column_width_; // the width (in pixels) of the columns the time waveform is decimated into
+    
+    int bins_per_bar_; // the number of bins of the spectrum each frequency bar shows (the loudest of)
+    
+    WaveformPyramid track_waveform_; // the min/max pyramid over the samples of the track played so far
     
-    int number_of_bands_; // the number of bands for the music spectrum
+    bool is_history_view_; // whether the time waveform shows the last few seconds of the track
+                           // instead of the current window
+    
+    float history_length_; // the number of seconds of the track shown in the history view
+    
+    std::vector<float> history_minimums_; // the minimum sample of each column of the history view
+    
+    std::vector<float> history_maximums_; // the maximum sample of each column of the history view
+    
+    int sample_rate_; // the sample rate of the music
     
   public:
     
@@ -43,21 +75,74 @@ class FFTVisualizer {
     *
     * @param sound_buffer - the sound buffer which
     *                              contains sound for the moment, to be updated with
+    * @param window_start_frame - the position in the track (in frames) of the first frame of the sound buffer
+    * @param new_sound_buffer - the frames which have not been analyzed yet (up to the end of the sound buffer)
+    * @param new_start_frame - the position in the track (in frames) of the first frame of new_sound_buffer
     */
-    void update(ofSoundBuffer sound_buffer);
+    void update(ofSoundBuffer sound_buffer, long long window_start_frame,
+                const ofSoundBuffer & new_sound_buffer, long long new_start_frame);
     
     /**
-     * The following function is responsible for drawing
+     * The following function is responsible for computing
      * the time waveform and associated
-     * frequency bars.
+     * frequency bars to be drawn.
+     *
+     * @param frame - the frame to fill in with the primitives to be drawn
+     * @param window_width - the width of the window the frame is drawn to
+     * @param window_height - the height of the window the frame is drawn to
      */
-    void draw();
+    void computeFrame(VisualizerFrame & frame, int window_width, int window_height);
     
     /**
-     * Getter for the number of bands of the visualizer.
+     * Getter for the number of bands of the visualizer (the number of bins of the STFT).
      */
     int getNumberOfBands();
     
+    /**
+     * Sets the channels of the sound which are analyzed and drawn (starting the analysis over).
+     */
+    void setChannelMode(ChannelMode mode);
+    
+    /**
+     * Getter for the channels of the sound which are analyzed and drawn.
+     */
+    ChannelMode getChannelMode() const;
+    
+    /**
+     * Getter for the number of samples of the sound buffers the visualizer is to be updated with
+     * (the time waveform window size).
+     */
+    int getWindowSize();
+    
+    /**
+     * Getter for the number of samples the STFT analyzes at a time
+     * (the fewest new frames the visualizer can start analyzing from).
+     */
+    int getAnalysisWindowSize();
+    
+    /**
+     * Sets the number of samples shown in the time waveform (up to 16384, for high-resolution displays).
+     */
+    void setWaveformWindowSize(int window_size);
+    
+    /**
+     * Sets the width (in pixels) of the columns the time waveform is decimated into
+     * (wider columns are cheaper to draw).
+     */
+    void setWaveformColumnWidth(int column_width);
+    
+    /**
+     * Sets the number of bins of the spectrum each frequency bar shows (the loudest of),
+     * e.g. 2 to draw half as many bars.
+     */
+    void setBinsPerBar(int bins_per_bar);
+    
+    /**
+     * Switches the time waveform between showing the current window and
+     * scrolling through the last few seconds of the track.
+     */
+    void toggleWaveformView();
+    
 };
 
 #endif /* FFTVisualizer_h */
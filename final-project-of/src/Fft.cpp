@@ -0,0 +1,99 @@
+//
+//  Fft.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "Fft.h"
+#include <cmath>
+
+/**
+ * Constructor for an Fft object (of size 0, till it is set up).
+ */
+Fft::Fft() noexcept {
+    
+    size_ = 0;
+    
+}
+
+/**
+ * Computes the tables for the given FFT size (a power of 2). Does nothing if they already are.
+ */
+void Fft::setup(int size) {
+    
+    if (size == size_) {
+        return;
+    }
+    
+    size_ = size;
+    
+    twiddles_.resize(size / 2);
+    bit_reversed_indices_.resize(size);
+    
+    for (int index = 0; index < size / 2; index++) {
+        twiddles_[index] = std::polar(1.0f, (float) (- 2 * M_PI * index / size));
+    }
+    
+    int number_of_bits = 0;
+    
+    while ((1 << number_of_bits) < size) {
+        number_of_bits++;
+    }
+    
+    for (int index = 0; index < size; index++) {
+        
+        int reversed_index = 0;
+        
+        for (int bit = 0; bit < number_of_bits; bit++) {
+            
+            if (index & (1 << bit)) {
+                reversed_index |= 1 << (number_of_bits - 1 - bit);
+            }
+        }
+        
+        bit_reversed_indices_[index] = reversed_index;
+    }
+    
+}
+
+/**
+ * Getter for the size of the FFT.
+ */
+int Fft::getSize() const {
+    
+    return size_;
+    
+}
+
+/**
+ * Computes the FFT of complex values.
+ */
+void Fft::transform(const std::complex<float> * input, std::complex<float> * output) const {
+    
+    // Copy the values in bit-reversed order.
+    
+    for (int index = 0; index < size_; index++) {
+        output[bit_reversed_indices_[index]] = input[index];
+    }
+    
+    // Iterative radix-2 FFT.
+    
+    for (int size = 2; size <= size_; size *= 2) {
+        
+        int half_size = size / 2;
+        int twiddle_step = size_ / size;
+        
+        for (int start = 0; start < size_; start += size) {
+            for (int index = 0; index < half_size; index++) {
+                
+                std::complex<float> even = output[start + index];
+                std::complex<float> odd = output[start + index + half_size] * twiddles_[index * twiddle_step];
+                
+                output[start + index] = even + odd;
+                output[start + index + half_size] = even - odd;
+            }
+        }
+    }
+    
+}
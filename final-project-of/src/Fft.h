@@ -0,0 +1,55 @@
+//
+//  Fft.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef Fft_h
+#define Fft_h
+
+#include <complex>
+#include <vector>
+
+/**
+ * Class that computes the complex FFT of a window (an iterative radix-2 FFT).
+ * This is the FFT the built-in backend of FftBackend is based on.
+ *
+ * The twiddle factors and the bit-reversed permutation are computed once per FFT size.
+ */
+class Fft {
+    
+    int size_; // the size of the FFT the tables below were computed for
+    
+    std::vector<std::complex<float> > twiddles_; // the FFT twiddle factors
+    
+    std::vector<int> bit_reversed_indices_; // the bit-reversed permutation of the FFT input
+    
+public:
+    
+    /**
+     * Constructor for an Fft object (of size 0, till it is set up).
+     */
+    Fft() noexcept;
+    
+    /**
+     * Computes the tables for the given FFT size (a power of 2). Does nothing if they already are.
+     */
+    void setup(int size);
+    
+    /**
+     * Getter for the size of the FFT.
+     */
+    int getSize() const;
+    
+    /**
+     * Computes the FFT of complex values.
+     *
+     * @param input - the getSize() values to be transformed
+     * @param output - the getSize() values the FFT is written to (which must not overlap the input)
+     */
+    void transform(const std::complex<float> * input, std::complex<float> * output) const;
+    
+};
+
+#endif /* Fft_h */
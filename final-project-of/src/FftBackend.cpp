@@ -0,0 +1,207 @@
+//
+//  FftBackend.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "FftBackend.h"
+#include "Fft.h"
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#ifdef MUSIC_VISUALIZER_USE_FFTW
+#include <fftw3.h>
+#endif
+
+namespace {
+
+/**
+ * Class that models a plan of the built-in radix-2 FFT.
+ *
+ * The N real samples are transformed as N / 2 complex values (the even samples being the real parts,
+ * and the odd samples the imaginary parts), and the bins are untangled from that FFT.
+ */
+class RadixTwoFftPlan : public FftPlan {
+    
+    int size_; // the size of the FFT
+    
+    Fft half_size_fft_; // the complex FFT of half the size
+    
+    std::vector<std::complex<float> > twiddles_; // the twiddle factors the bins are untangled with
+    
+public:
+    
+    /**
+     * Constructor for a RadixTwoFftPlan object, for the given size.
+     */
+    RadixTwoFftPlan(int size) noexcept {
+        
+        size_ = size;
+        half_size_fft_.setup(size / 2);
+        
+        twiddles_.resize(size / 2);
+        
+        for (int index = 0; index < size / 2; index++) {
+            twiddles_[index] = std::polar(1.0f, (float) (- 2 * M_PI * index / size));
+        }
+        
+    }
+    
+    /**
+     * Getter for the size of the FFT.
+     */
+    int getSize() const {
+        
+        return size_;
+        
+    }
+    
+    /**
+     * Computes the FFT of real samples.
+     */
+    void transform(const float * samples, std::complex<float> * bins) const {
+        
+        int half_size = size_ / 2;
+        
+        // Pairs of real samples are laid out as complex values, so they can be transformed as they are.
+        
+        half_size_fft_.transform(reinterpret_cast<const std::complex<float> *>(samples), bins);
+        
+        // Untangle the bins k and N / 2 - k (in place) from the values of the half-size FFT Z:
+        // X[k] = (Z[k] + conj(Z[N/2 - k])) / 2 - i * W^k * (Z[k] - conj(Z[N/2 - k])) / 2
+        
+        std::complex<float> first = bins[0];
+        
+        bins[0] = std::complex<float>(first.real() + first.imag(), 0);
+        bins[half_size] = std::complex<float>(first.real() - first.imag(), 0);
+        
+        for (int bin = 1; bin <= half_size / 2; bin++) {
+            
+            int mirrored_bin = half_size - bin;
+            
+            std::complex<float> value = bins[bin];
+            std::complex<float> mirrored_value = std::conj(bins[mirrored_bin]);
+            
+            std::complex<float> even = 0.5f * (value + mirrored_value);
+            std::complex<float> odd = std::complex<float>(0, -0.5f) * (value - mirrored_value);
+            
+            bins[bin] = even + twiddles_[bin] * odd;
+            
+            if (mirrored_bin != bin) {
+                bins[mirrored_bin] = std::conj(even - twiddles_[bin] * odd);
+            }
+        }
+        
+    }
+    
+};
+
+#ifdef MUSIC_VISUALIZER_USE_FFTW
+
+/**
+ * Class that models an FFTW plan.
+ */
+class FftwFftPlan : public FftPlan {
+    
+    int size_; // the size of the FFT
+    
+    fftwf_plan plan_; // the FFTW plan
+    
+public:
+    
+    /**
+     * Constructor for an FftwFftPlan object, for the given size.
+     * FFTW measures the fastest way to compute the FFT on this machine (which only has to be done once).
+     */
+    FftwFftPlan(int size) noexcept {
+        
+        size_ = size;
+        
+        float * samples = fftwf_alloc_real(size);
+        fftwf_complex * bins = fftwf_alloc_complex(size / 2 + 1);
+        
+        // The plan is executed on the analyzers' own (not necessarily aligned) buffers.
+        
+        plan_ = fftwf_plan_dft_r2c_1d(size, samples, bins, FFTW_MEASURE | FFTW_UNALIGNED);
+        
+        fftwf_free(samples);
+        fftwf_free(bins);
+        
+    }
+    
+    /**
+     * Destructor for an FftwFftPlan object, which destroys the plan.
+     */
+    ~FftwFftPlan() {
+        
+        fftwf_destroy_plan(plan_);
+        
+    }
+    
+    /**
+     * Getter for the size of the FFT.
+     */
+    int getSize() const {
+        
+        return size_;
+        
+    }
+    
+    /**
+     * Computes the FFT of real samples. (Executing a plan on new buffers is thread-safe in FFTW.)
+     */
+    void transform(const float * samples, std::complex<float> * bins) const {
+        
+        fftwf_execute_dft_r2c(plan_, const_cast<float *>(samples), reinterpret_cast<fftwf_complex *>(bins));
+        
+    }
+    
+};
+
+#endif
+
+std::mutex plans_mutex; // the mutex guarding the plans (making a plan is not thread-safe in FFTW)
+
+std::map<int, std::shared_ptr<const FftPlan> > plans; // the plans made so far, by size
+
+}
+
+/**
+ * Returns the plan for the FFT of the given size (a power of 2, at least 2), making it if it is not cached.
+ * This can be called from any thread.
+ */
+std::shared_ptr<const FftPlan> FftBackend::getPlan(int size) {
+    
+    std::lock_guard<std::mutex> lock(plans_mutex);
+    
+    std::shared_ptr<const FftPlan> & plan = plans[size];
+    
+    if (!plan) {
+        
+#ifdef MUSIC_VISUALIZER_USE_FFTW
+        plan = std::make_shared<FftwFftPlan>(size);
+#else
+        plan = std::make_shared<RadixTwoFftPlan>(size);
+#endif
+        
+    }
+    
+    return plan;
+    
+}
+
+/**
+ * Returns the name of the backend the plans are made by.
+ */
+std::string FftBackend::getName() {
+    
+#ifdef MUSIC_VISUALIZER_USE_FFTW
+    return "FFTW";
+#else
+    return "Radix-2";
+#endif
+    
+}
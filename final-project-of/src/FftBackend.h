@@ -0,0 +1,69 @@
+//
+//  FftBackend.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef FftBackend_h
+#define FftBackend_h
+
+#include <complex>
+#include <memory>
+#include <string>
+
+/**
+ * Abstract class that models a plan for the FFT of real samples of one size (a real-to-complex transform,
+ * which only computes the non-negative frequencies: half the work of a complex FFT of the same size).
+ *
+ * A plan is immutable once made, so it can be shared, and used by several threads at once.
+ */
+class FftPlan {
+    
+public:
+    
+    /**
+     * Destructor for an FftPlan object.
+     */
+    virtual ~FftPlan() {}
+    
+    /**
+     * Getter for the size of the FFT (the number of real samples transformed).
+     */
+    virtual int getSize() const = 0;
+    
+    /**
+     * Computes the FFT of real samples.
+     *
+     * @param samples - the getSize() samples to be transformed
+     * @param bins - the getSize() / 2 + 1 bins (from 0 Hz up to half the sample rate) the FFT is written to
+     */
+    virtual void transform(const float * samples, std::complex<float> * bins) const = 0;
+    
+};
+
+/**
+ * Class that hands out the FFT plans all the analyzers share.
+ *
+ * The plans are made by FFTW (in single precision) if the application is built with MUSIC_VISUALIZER_USE_FFTW
+ * defined (and linked with libfftw3f), otherwise by the built-in radix-2 FFT (which computes a real FFT with
+ * a complex FFT of half its size). A plan is made once per size, and cached.
+ */
+class FftBackend {
+    
+public:
+    
+    /**
+     * Returns the plan for the FFT of the given size (a power of 2, at least 2), making it if it is not cached.
+     * This can be called from any thread.
+     */
+    static std::shared_ptr<const FftPlan> getPlan(int size);
+    
+    /**
+     * Returns the name of the backend the plans are made by.
+     */
+    static std::string getName();
+    
+};
+
+#endif /* FftBackend_h */
@@ -0,0 +1,106 @@
+//
+//  FftBenchmark.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "FftBenchmark.h"
+#include "FftBackend.h"
+#include "Fft.h"
+#include "ofMain.h"
+#include <chrono>
+#include <complex>
+#include <vector>
+
+const double kSecondsPerMeasurement = 0.25; // how long each FFT is run for
+
+/**
+ * Returns the time (in microseconds) a function takes per run, running it for about kSecondsPerMeasurement.
+ */
+template <typename Function>
+static double measureMicros(Function function) {
+    
+    typedef std::chrono::steady_clock Clock;
+    
+    // Warm up (the caches, and the plan), then run in batches till enough time has gone by.
+    
+    function();
+    
+    long long number_of_runs = 0;
+    Clock::time_point start_time = Clock::now();
+    double elapsed_seconds = 0;
+    
+    while (elapsed_seconds < kSecondsPerMeasurement) {
+        
+        for (int run = 0; run < 16; run++) {
+            function();
+        }
+        
+        number_of_runs += 16;
+        elapsed_seconds = std::chrono::duration<double>(Clock::now() - start_time).count();
+    }
+    
+    return elapsed_seconds * 1e6 / number_of_runs;
+    
+}
+
+/**
+ * Runs the benchmark, and logs the results.
+ */
+void FftBenchmark::run(int minimum_bins, int maximum_bins) {
+    
+    ofLogNotice("FftBenchmark") << "FFT backend: " << FftBackend::getName();
+    ofLogNotice("FftBenchmark") << "bins, plan (us, once), complex FFT (us), real-input plan (us), speedup";
+    
+    for (int number_of_bins = minimum_bins; number_of_bins <= maximum_bins; number_of_bins *= 2) {
+        
+        int fft_size = 2 * number_of_bins;
+        
+        // A window of noise to transform.
+        
+        std::vector<float> samples(fft_size);
+        
+        for (int index = 0; index < fft_size; index++) {
+            samples[index] = ofRandom(-1, 1);
+        }
+        
+        // The plan is made (and cached) the first time it is asked for.
+        
+        std::chrono::steady_clock::time_point plan_start_time = std::chrono::steady_clock::now();
+        std::shared_ptr<const FftPlan> plan = FftBackend::getPlan(fft_size);
+        double plan_micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now()
+                                                                       - plan_start_time).count();
+        
+        // The complex FFT of the full size, of the samples as complex values (the way the spectra used to be computed).
+        
+        Fft complex_fft;
+        complex_fft.setup(fft_size);
+        
+        std::vector<std::complex<float> > complex_samples(fft_size);
+        std::vector<std::complex<float> > complex_bins(fft_size);
+        
+        double complex_micros = measureMicros([&]() {
+            
+            for (int index = 0; index < fft_size; index++) {
+                complex_samples[index] = std::complex<float>(samples[index], 0);
+            }
+            
+            complex_fft.transform(complex_samples.data(), complex_bins.data());
+        });
+        
+        // The backend's real-input plan.
+        
+        std::vector<std::complex<float> > bins(number_of_bins + 1);
+        
+        double plan_run_micros = measureMicros([&]() {
+            
+            plan->transform(samples.data(), bins.data());
+        });
+        
+        ofLogNotice("FftBenchmark") << number_of_bins << ", " << ofToString(plan_micros, 1) << ", "
+                                    << ofToString(complex_micros, 2) << ", " << ofToString(plan_run_micros, 2) << ", "
+                                    << ofToString(complex_micros / plan_run_micros, 2) << "x";
+    }
+    
+}
@@ -0,0 +1,29 @@
+//
+//  FftBenchmark.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef FftBenchmark_h
+#define FftBenchmark_h
+
+/**
+ * Class that benchmarks the FFT backend's (cached) real-input plans against a complex FFT of the full size
+ * (the way the spectra used to be computed), for 256 to 8192 bins. Run with --benchmark-fft.
+ */
+class FftBenchmark {
+    
+public:
+    
+    /**
+     * Runs the benchmark, and logs the results.
+     *
+     * @param minimum_bins - the fewest bins benchmarked
+     * @param maximum_bins - the most bins benchmarked
+     */
+    static void run(int minimum_bins = 256, int maximum_bins = 8192);
+    
+};
+
+#endif /* FftBenchmark_h */
@@ -0,0 +1,138 @@
+//
+//  FileInputBackend.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "FileInputBackend.h"
+#include "TrackLoader.h"
+#include <chrono>
+
+/**
+ * Constructor for a FileInputBackend object.
+ */
+FileInputBackend::FileInputBackend(const std::string & path, float speed) noexcept : path_(path) {
+    
+    speed_ = speed > 0 ? speed : 1;
+    is_running_ = false;
+    
+}
+
+/**
+ * Destructor for a FileInputBackend object, which stops the delivery thread.
+ */
+FileInputBackend::~FileInputBackend() {
+    
+    stop();
+    
+}
+
+/**
+ * Decodes the file, and starts the delivery thread.
+ * The blocks are delivered at the sample rate of the file, whatever sample rate is asked for.
+ */
+bool FileInputBackend::start(ofBaseSoundInput * listener, int /* sample_rate */, int buffer_size, int number_of_channels) {
+    
+    stop();
+    
+    if (!track_) {
+        
+        track_ = TrackLoader::openTrack(path_);
+        
+        if (!track_ || track_->getNumberOfFrames() == 0) {
+            
+            ofLogError("FileInputBackend") << "Could not decode " << path_;
+            track_.reset();
+            return false;
+            
+        }
+    }
+    
+    is_running_ = true;
+    delivery_thread_ = std::thread(&FileInputBackend::run, this, listener, buffer_size, number_of_channels);
+    
+    return true;
+    
+}
+
+/**
+ * Stops the delivery thread.
+ */
+void FileInputBackend::stop() {
+    
+    is_running_ = false;
+    
+    if (delivery_thread_.joinable()) {
+        delivery_thread_.join();
+    }
+    
+}
+
+/**
+ * The function run by the delivery thread.
+ */
+void FileInputBackend::run(ofBaseSoundInput * listener, int buffer_size, int number_of_channels) {
+    
+    int track_channels = track_->getNumberOfChannels();
+    
+    std::vector<float> track_samples(buffer_size * track_channels);
+    
+    ofSoundBuffer block;
+    block.setSampleRate(track_->getSampleRate());
+    block.allocate(buffer_size, number_of_channels);
+    
+    // Every block is due a block's length (divided by the speed) after the one before it. The blocks are
+    // scheduled against the start time rather than the previous block, so that the pace does not drift.
+    
+    std::chrono::duration<double> block_interval(buffer_size / (speed_ * track_->getSampleRate()));
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    
+    long long block_number = 0;
+    long long playhead_frame = 0;
+    
+    while (is_running_) {
+        
+        // Read the next block of the file (looping around at its end), and spread its channels over the block.
+        
+        track_->setPlayheadFrame(playhead_frame);
+        track_->readFrames(playhead_frame, buffer_size, track_samples.data(), true);
+        
+        for (int frame = 0; frame < buffer_size; frame++) {
+            for (int channel = 0; channel < number_of_channels; channel++) {
+                
+                int track_channel = std::min(channel, track_channels - 1);
+                block[frame * number_of_channels + channel] = track_samples[frame * track_channels + track_channel];
+            }
+        }
+        
+        playhead_frame = (playhead_frame + buffer_size) % track_->getNumberOfFrames();
+        block_number++;
+        
+        // A device delivers a block once it has been captured in full.
+        
+        std::this_thread::sleep_until(start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                          block_interval * block_number));
+        
+        listener->audioIn(block);
+    }
+    
+}
+
+/**
+ * Getter for the sample rate of the file.
+ */
+int FileInputBackend::getSampleRate() const {
+    
+    return track_ ? track_->getSampleRate() : 44100;
+    
+}
+
+/**
+ * Getter for the name of the backend (to be displayed).
+ */
+std::string FileInputBackend::getName() const {
+    
+    return "File Input: " + path_.substr(path_.find_last_of("\\/") + 1);
+    
+}
@@ -0,0 +1,81 @@
+//
+//  FileInputBackend.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef FileInputBackend_h
+#define FileInputBackend_h
+
+#include "AudioInputBackend.h"
+#include "AudioSource.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Class that stands in for a sound input device: it delivers the blocks of a (.wav or .mp3) file,
+ * looped, at the pace a device would (or faster, for load testing), on a thread of its own.
+ *
+ * This lets the whole live input path (the ring buffer, the frame pipeline, the visualizers)
+ * be exercised on machines without a sound card.
+ */
+class FileInputBackend : public AudioInputBackend {
+    
+    std::string path_; // the path of the file the blocks are read from
+    
+    float speed_; // how many times faster than real time the blocks are delivered
+    
+    std::shared_ptr<AudioSource> track_; // the decoded file
+    
+    std::thread delivery_thread_; // the thread which delivers the blocks
+    
+    std::atomic<bool> is_running_; // whether the delivery thread should keep running
+    
+    /**
+     * The function run by the delivery thread.
+     */
+    void run(ofBaseSoundInput * listener, int buffer_size, int number_of_channels);
+    
+public:
+    
+    /**
+     * Constructor for a FileInputBackend object.
+     *
+     * @param path - the path of the file (relative to the data directory)
+     * @param speed - how many times faster than real time the blocks are delivered (1 for real time)
+     */
+    FileInputBackend(const std::string & path, float speed) noexcept;
+    
+    /**
+     * Destructor for a FileInputBackend object, which stops the delivery thread.
+     */
+    ~FileInputBackend();
+    
+    /**
+     * Decodes the file, and starts the delivery thread.
+     * The blocks are delivered at the sample rate of the file, whatever sample rate is asked for.
+     */
+    bool start(ofBaseSoundInput * listener, int sample_rate, int buffer_size, int number_of_channels);
+    
+    /**
+     * Stops the delivery thread.
+     */
+    void stop();
+    
+    /**
+     * Getter for the sample rate of the file.
+     */
+    int getSampleRate() const;
+    
+    /**
+     * Getter for the name of the backend (to be displayed).
+     */
+    std::string getName() const;
+    
+};
+
+#endif /* FileInputBackend_h */
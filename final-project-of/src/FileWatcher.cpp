@@ -0,0 +1,96 @@
+//
+//  FileWatcher.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "FileWatcher.h"
+#include "ofMain.h"
+#include <sys/stat.h>
+
+const int kPollIntervalMilliseconds = 500; // the time between two polls of the file
+
+/**
+ * Constructor for a FileWatcher object, which watches no file.
+ */
+FileWatcher::FileWatcher() noexcept {
+
+    exists_ = false;
+    modification_time_nanoseconds_ = 0;
+    size_ = 0;
+    has_polled_ = false;
+
+}
+
+/**
+ * Sets the file to be watched.
+ */
+void FileWatcher::setup(const std::string & path) {
+
+    path_ = ofToDataPath(path, true);
+
+    exists_ = false;
+    modification_time_nanoseconds_ = 0;
+    size_ = 0;
+    has_polled_ = false;
+
+}
+
+/**
+ * Getter for the path of the file watched (absolute).
+ */
+const std::string & FileWatcher::getPath() const {
+
+    return path_;
+
+}
+
+/**
+ * Polls the file, if it has not been polled for half a second.
+ */
+bool FileWatcher::hasChanged() {
+
+    if (path_.empty()) {
+        return false;
+    }
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    if (has_polled_ && now < next_poll_time_) {
+        return false;
+    }
+
+    has_polled_ = true;
+    next_poll_time_ = now + std::chrono::milliseconds(kPollIntervalMilliseconds);
+
+    struct stat file_status;
+
+    if (stat(path_.c_str(), &file_status) != 0) {
+
+        exists_ = false;
+
+        return false;
+    }
+
+#if defined(__APPLE__)
+    long long modification_time_nanoseconds = file_status.st_mtimespec.tv_sec * 1000000000LL + file_status.st_mtimespec.tv_nsec;
+#elif defined(_WIN32)
+    long long modification_time_nanoseconds = file_status.st_mtime * 1000000000LL;
+#else
+    long long modification_time_nanoseconds = file_status.st_mtim.tv_sec * 1000000000LL + file_status.st_mtim.tv_nsec;
+#endif
+
+    // A change of either the time or the size counts (the time alone may not tell two saves apart,
+    // on a file system which keeps it to the second).
+
+    bool has_changed = !exists_ || modification_time_nanoseconds != modification_time_nanoseconds_ ||
+                       (long long) file_status.st_size != size_;
+
+    exists_ = true;
+    modification_time_nanoseconds_ = modification_time_nanoseconds;
+    size_ = file_status.st_size;
+
+    return has_changed;
+
+}
@@ -0,0 +1,63 @@
+//
+//  FileWatcher.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef FileWatcher_h
+#define FileWatcher_h
+
+#include <chrono>
+#include <string>
+
+/**
+ * Class that watches a file for changes (e.g. a configuration file being edited while the application runs).
+ *
+ * The file's modification time and size are polled (with stat(), which is a single system call) at most every
+ * half a second, so it can be checked every frame at no cost, on any platform.
+ */
+class FileWatcher {
+
+    std::string path_; // the path of the file watched
+
+    bool exists_; // whether the file existed when it was last polled
+
+    long long modification_time_nanoseconds_; // the modification time of the file when it was last polled
+
+    long long size_; // the size (in bytes) of the file when it was last polled
+
+    std::chrono::steady_clock::time_point next_poll_time_; // the time before which the file is not polled again
+
+    bool has_polled_; // whether the file has been polled yet
+
+public:
+
+    /**
+     * Constructor for a FileWatcher object, which watches no file.
+     */
+    FileWatcher() noexcept;
+
+    /**
+     * Sets the file to be watched. The next poll counts it as changed, if it exists.
+     *
+     * @param path - the path of the file (absolute, or relative to the data directory)
+     */
+    void setup(const std::string & path);
+
+    /**
+     * Getter for the path of the file watched (absolute).
+     */
+    const std::string & getPath() const;
+
+    /**
+     * Polls the file, if it has not been polled for half a second.
+     *
+     * @return true if the file has been created or modified since it was last polled, false otherwise
+     *         (also if it has been removed: the last version of it stands)
+     */
+    bool hasChanged();
+
+};
+
+#endif /* FileWatcher_h */
@@ -0,0 +1,205 @@
+//
+//  FramePipeline.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "FramePipeline.h"
+#include <chrono>
+
+/**
+ * Runs a job on a frame, and records the time it took in the frame.
+ */
+static void runJob(const FramePipeline::FrameJob & job, VisualizerFrame & frame) {
+    
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    
+    job(frame);
+    
+    frame.compute_time_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+    
+}
+
+/**
+ * Constructor for a FramePipeline object, which does not start the worker thread yet.
+ */
+FramePipeline::FramePipeline() noexcept {
+    
+    is_job_pending_ = false;
+    is_running_ = false;
+    
+    front_frame_index_ = 0;
+    has_front_frame_ = false;
+    has_back_frame_ = false;
+    
+}
+
+/**
+ * Destructor, which stops the worker thread.
+ */
+FramePipeline::~FramePipeline() {
+    
+    stop();
+    
+}
+
+/**
+ * Starts the worker thread.
+ */
+void FramePipeline::start() {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (is_running_) {
+        return;
+    }
+    
+    is_running_ = true;
+    worker_ = std::thread(&FramePipeline::runWorker, this);
+    
+}
+
+/**
+ * Stops the worker thread, after it finishes the job it is running.
+ */
+void FramePipeline::stop() {
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_running_ = false;
+    }
+    
+    condition_.notify_all();
+    
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    
+}
+
+/**
+ * The function run by the worker thread.
+ */
+void FramePipeline::runWorker() {
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    
+    while (true) {
+        
+        // Sleep till a job is submitted (or the pipeline is stopped).
+        
+        condition_.wait(lock, [this] { return is_job_pending_ || !is_running_; });
+        
+        if (!is_running_) {
+            break;
+        }
+        
+        // Run the job on the back frame without holding the lock,
+        // so the main thread can draw the front frame in the meantime.
+        
+        FrameJob job;
+        job.swap(pending_job_);
+        
+        VisualizerFrame & back_frame = frames_[1 - front_frame_index_];
+        
+        lock.unlock();
+        runJob(job, back_frame);
+        lock.lock();
+        
+        has_back_frame_ = true;
+        is_job_pending_ = false;
+        
+        condition_.notify_all();
+    }
+    
+    // Do not leave the main thread waiting for a job that will never run.
+    
+    is_job_pending_ = false;
+    condition_.notify_all();
+    
+}
+
+/**
+ * Hands the job computing the next frame to the worker thread.
+ *
+ * This waits for the previously submitted job to finish (so at most one frame is in flight),
+ * and makes the frame it computed the front frame.
+ */
+void FramePipeline::submit(FrameJob job) {
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    
+    condition_.wait(lock, [this] { return !is_job_pending_; });
+    
+    // Swap the buffers: the frame that was just computed is drawn next.
+    
+    if (has_back_frame_) {
+        
+        front_frame_index_ = 1 - front_frame_index_;
+        has_front_frame_ = true;
+        has_back_frame_ = false;
+        
+    }
+    
+    if (!is_running_) {
+        
+        // Without a worker, compute the frame on this thread (and draw it one frame later, as usual).
+        
+        runJob(job, frames_[1 - front_frame_index_]);
+        has_back_frame_ = true;
+        return;
+        
+    }
+    
+    pending_job_ = job;
+    is_job_pending_ = true;
+    
+    condition_.notify_all();
+    
+}
+
+/**
+ * Waits for the job in flight (if any) to finish, so that the main thread can safely
+ * modify the state the jobs use.
+ */
+void FramePipeline::waitUntilIdle() {
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return !is_job_pending_; });
+    
+}
+
+/**
+ * Waits for the job in flight to finish, then discards all computed frames
+ * (e.g. when switching to another visualization).
+ */
+void FramePipeline::clear() {
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return !is_job_pending_; });
+    
+    has_front_frame_ = false;
+    has_back_frame_ = false;
+    
+}
+
+/**
+ * Returns whether there is a frame to be drawn.
+ */
+bool FramePipeline::hasFrontFrame() {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    return has_front_frame_;
+    
+}
+
+/**
+ * Returns the frame to be drawn. It is only modified by the next call to submit() or clear().
+ */
+const VisualizerFrame & FramePipeline::getFrontFrame() {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    return frames_[front_frame_index_];
+    
+}
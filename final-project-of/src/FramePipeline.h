@@ -0,0 +1,114 @@
+//
+//  FramePipeline.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef FramePipeline_h
+#define FramePipeline_h
+
+#include "VisualizerFrame.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * Class that runs a two-stage frame pipeline: a worker thread computes frame N + 1
+ * (updating a visualizer and filling in its VisualizerFrame) while the main thread draws frame N.
+ *
+ * The frames are double-buffered. A frame that is drawn is always exactly one frame behind
+ * the input it was computed from, so the latency the pipeline adds is bounded to one frame.
+ */
+class FramePipeline {
+    
+public:
+    
+    typedef std::function<void(VisualizerFrame &)> FrameJob; // a job which computes a frame into the given frame object
+    
+private:
+    
+    std::thread worker_; // the worker thread which runs the frame jobs
+    
+    std::mutex mutex_; // the mutex guarding all the below state
+    
+    std::condition_variable condition_; // the condition the worker and the main thread wait on
+    
+    FrameJob pending_job_; // the job the worker is to run next (or is running)
+    
+    bool is_job_pending_; // whether a job has been submitted and has not been finished yet
+    
+    bool is_running_; // whether the worker thread should keep running
+    
+    VisualizerFrame frames_[2]; // the double-buffered frames
+    
+    int front_frame_index_; // the index of the frame which is drawn (the other one is computed into)
+    
+    bool has_front_frame_; // whether the front frame holds a computed frame
+    
+    bool has_back_frame_; // whether the back frame holds a computed frame that has not been swapped in yet
+    
+    /**
+     * The function run by the worker thread.
+     */
+    void runWorker();
+    
+public:
+    
+    /**
+     * Constructor for a FramePipeline object, which does not start the worker thread yet.
+     */
+    FramePipeline() noexcept;
+    
+    /**
+     * Destructor, which stops the worker thread.
+     */
+    ~FramePipeline();
+    
+    /**
+     * Starts the worker thread.
+     */
+    void start();
+    
+    /**
+     * Stops the worker thread, after it finishes the job it is running.
+     */
+    void stop();
+    
+    /**
+     * Hands the job computing the next frame to the worker thread.
+     *
+     * This waits for the previously submitted job to finish (so at most one frame is in flight),
+     * and makes the frame it computed the front frame.
+     *
+     * @param job - the job which computes the next frame. Everything it reads must be owned
+     *              by the job (captured by value) or only be touched by the worker.
+     */
+    void submit(FrameJob job);
+    
+    /**
+     * Waits for the job in flight (if any) to finish, so that the main thread can safely
+     * modify the state the jobs use.
+     */
+    void waitUntilIdle();
+    
+    /**
+     * Waits for the job in flight to finish, then discards all computed frames
+     * (e.g. when switching to another visualization).
+     */
+    void clear();
+    
+    /**
+     * Returns whether there is a frame to be drawn.
+     */
+    bool hasFrontFrame();
+    
+    /**
+     * Returns the frame to be drawn. It is only modified by the next call to submit() or clear().
+     */
+    const VisualizerFrame & getFrontFrame();
+    
+};
+
+#endif /* FramePipeline_h */
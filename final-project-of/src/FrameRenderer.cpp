@@ -0,0 +1,203 @@
+//
+//  FrameRenderer.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "FrameRenderer.h"
+
+/**
+ * Converts a frame colour to an openFrameworks colour.
+ */
+static ofColor toOfColor(const FrameColor & color) {
+    return ofColor(color.r, color.g, color.b, color.a);
+}
+
+/**
+ * Constructor for a FrameRenderer object, which sets up its meshes.
+ */
+FrameRenderer::FrameRenderer() noexcept {
+    
+    rectangles_mesh_.setMode(OF_PRIMITIVE_TRIANGLES);
+    triangles_mesh_.setMode(OF_PRIMITIVE_TRIANGLES);
+    lines_mesh_.setMode(OF_PRIMITIVE_LINES);
+    polyline_mesh_.setMode(OF_PRIMITIVE_LINE_STRIP);
+    
+}
+
+/**
+ * Returns the (loaded) font for the given font size.
+ */
+ofTrueTypeFont & FrameRenderer::getFont(int font_size) {
+
+    // Fonts are only loaded the first time a size is asked for,
+    // instead of once every frame.
+
+    std::map<int, ofTrueTypeFont>::iterator font = fonts_.find(font_size);
+
+    if (font == fonts_.end()) {
+
+        font = fonts_.insert(std::make_pair(font_size, ofTrueTypeFont())).first;
+        font->second.load("helvetica.ttf", font_size);
+
+    }
+
+    return font->second;
+
+}
+
+/**
+ * The following function is responsible for drawing
+ * all the layers of the given frame.
+ */
+void FrameRenderer::draw(const VisualizerFrame & frame) {
+
+    if (frame.has_background) {
+        ofBackground(frame.background_color.r, frame.background_color.g, frame.background_color.b);
+    }
+
+    ofFill();
+
+    for (int index = 0; index < (int) frame.layers.size(); index++) {
+        drawLayer(frame.layers[index]);
+    }
+
+}
+
+/**
+ * Helper function to draw a single layer of a frame.
+ */
+void FrameRenderer::drawLayer(const FrameLayer & layer) {
+
+    // Store the coordinate system, then shift it.
+
+    ofPushMatrix();
+    ofTranslate(layer.translate_x, layer.translate_y);
+
+    ofSetLineWidth(layer.line_width);
+
+    // Each kind of primitive is batched into its mesh.
+    // (ofMesh::clear() keeps the capacity of the vertex and colour arrays.)
+    
+    if (!layer.rectangles.empty()) {
+        
+        rectangles_mesh_.clear();
+        
+        for (int index = 0; index < (int) layer.rectangles.size(); index++) {
+            
+            const FrameRectangle & rectangle = layer.rectangles[index];
+            
+            ofPoint top_left(rectangle.x, rectangle.y);
+            ofPoint top_right(rectangle.x + rectangle.width, rectangle.y);
+            ofPoint bottom_right(rectangle.x + rectangle.width, rectangle.y + rectangle.height);
+            ofPoint bottom_left(rectangle.x, rectangle.y + rectangle.height);
+            
+            ofColor color = toOfColor(rectangle.color);
+            
+            // Two triangles per rectangle.
+            
+            rectangles_mesh_.addVertex(top_left);
+            rectangles_mesh_.addVertex(top_right);
+            rectangles_mesh_.addVertex(bottom_right);
+            rectangles_mesh_.addVertex(top_left);
+            rectangles_mesh_.addVertex(bottom_right);
+            rectangles_mesh_.addVertex(bottom_left);
+            
+            for (int vertex_number = 0; vertex_number < 6; vertex_number++) {
+                rectangles_mesh_.addColor(color);
+            }
+            
+        }
+        
+        rectangles_mesh_.draw();
+        
+    }
+    
+    for (int index = 0; index < (int) layer.circles.size(); index++) {
+
+        const FrameCircle & circle = layer.circles[index];
+
+        ofSetColor(circle.color.r, circle.color.g, circle.color.b, circle.color.a);
+        ofDrawCircle(circle.x, circle.y, circle.z, circle.radius);
+
+    }
+    
+    if (!layer.triangles.empty()) {
+        
+        triangles_mesh_.clear();
+        
+        for (int index = 0; index < (int) layer.triangles.size(); index++) {
+            
+            const FrameTriangle & triangle = layer.triangles[index];
+            
+            ofColor color = toOfColor(triangle.color);
+            
+            triangles_mesh_.addVertex(ofPoint(triangle.x1, triangle.y1));
+            triangles_mesh_.addVertex(ofPoint(triangle.x2, triangle.y2));
+            triangles_mesh_.addVertex(ofPoint(triangle.x3, triangle.y3));
+            
+            triangles_mesh_.addColor(color);
+            triangles_mesh_.addColor(color);
+            triangles_mesh_.addColor(color);
+            
+        }
+        
+        triangles_mesh_.draw();
+        
+    }
+    
+    if (!layer.lines.empty()) {
+        
+        lines_mesh_.clear();
+        
+        for (int index = 0; index < (int) layer.lines.size(); index++) {
+            
+            const FrameLine & line = layer.lines[index];
+            
+            ofColor color = toOfColor(line.color);
+            
+            lines_mesh_.addVertex(ofPoint(line.x1, line.y1, line.z1));
+            lines_mesh_.addVertex(ofPoint(line.x2, line.y2, line.z2));
+            
+            lines_mesh_.addColor(color);
+            lines_mesh_.addColor(color);
+            
+        }
+        
+        lines_mesh_.draw();
+        
+    }
+
+    if (!layer.polyline.empty()) {
+
+        // Draw the polyline as one line strip.
+
+        polyline_mesh_.clear();
+        
+        ofColor color = toOfColor(layer.polyline_color);
+
+        for (int index = 0; index < (int) layer.polyline.size(); index++) {
+            
+            polyline_mesh_.addVertex(ofPoint(layer.polyline[index].x, layer.polyline[index].y));
+            polyline_mesh_.addColor(color);
+            
+        }
+
+        polyline_mesh_.draw();
+
+    }
+
+    for (int index = 0; index < (int) layer.texts.size(); index++) {
+
+        const FrameText & text = layer.texts[index];
+
+        ofSetColor(text.color.r, text.color.g, text.color.b, text.color.a);
+        getFont(text.font_size).drawString(text.text, text.x, text.y);
+
+    }
+
+    // Restore original coordinate system.
+    ofPopMatrix();
+
+}
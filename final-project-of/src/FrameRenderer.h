@@ -0,0 +1,58 @@
+//
+//  FrameRenderer.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef FrameRenderer_h
+#define FrameRenderer_h
+
+#include "ofMain.h"
+#include "VisualizerFrame.h"
+#include <map>
+
+/**
+ * Class that draws a VisualizerFrame to the application window using openFrameworks.
+ *
+ * Rectangles, triangles, lines and the polyline of a layer are each drawn as one batched mesh.
+ * The meshes are kept between frames, so their vertex arrays keep their capacity.
+ */
+class FrameRenderer {
+
+    std::map<int, ofTrueTypeFont> fonts_; // the loaded fonts, by font size
+
+    ofMesh rectangles_mesh_; // the batched mesh of the bar quads of a layer
+
+    ofMesh triangles_mesh_; // the batched mesh of the triangles of a layer
+
+    ofMesh lines_mesh_; // the batched mesh of the edge lines of a layer
+
+    ofMesh polyline_mesh_; // the mesh of the (waveform) polyline of a layer
+
+    /**
+     * Returns the (loaded) font for the given font size.
+     */
+    ofTrueTypeFont & getFont(int font_size);
+
+    /**
+     * Helper function to draw a single layer of a frame.
+     */
+    void drawLayer(const FrameLayer & layer);
+
+public:
+
+    /**
+     * Constructor for a FrameRenderer object, which sets up its meshes.
+     */
+    FrameRenderer() noexcept;
+
+    /**
+     * The following function is responsible for drawing
+     * all the layers of the given frame.
+     */
+    void draw(const VisualizerFrame & frame);
+
+};
+
+#endif /* FrameRenderer_h */
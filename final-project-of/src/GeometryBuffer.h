@@ -0,0 +1,164 @@
+//
+//  GeometryBuffer.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef GeometryBuffer_h
+#define GeometryBuffer_h
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Class template that models a frame-arena-backed array of geometry (vertices, bars, edges, ...).
+ *
+ * Its storage is only ever grown, never released: clear() just resets the fill position to the start
+ * (a pointer bump), and the elements are overwritten in place when the next frame is filled in.
+ * Once the buffer has grown to the size a visualization needs, filling it in allocates nothing.
+ *
+ * Every time the storage has to grow, the allocation counter is incremented, so that the number of
+ * allocations made while filling in a frame can be checked (it should read zero in steady state).
+ */
+template <typename T>
+class GeometryBuffer {
+
+    std::vector<T> storage_; // the storage of the buffer, whose size is the capacity of the buffer
+
+    size_t size_; // the number of elements in use
+
+    int allocation_count_; // the number of times the storage has grown since the buffer was last cleared
+
+    /**
+     * Grows the storage so that it can hold at least the given number of elements.
+     */
+    void grow(size_t minimum_capacity) {
+
+        size_t new_capacity = storage_.empty() ? 16 : 2 * storage_.size();
+
+        while (new_capacity < minimum_capacity) {
+            new_capacity *= 2;
+        }
+
+        storage_.resize(new_capacity);
+        allocation_count_++;
+
+    }
+
+public:
+
+    /**
+     * Constructor for an (empty) GeometryBuffer object.
+     */
+    GeometryBuffer() noexcept : size_(0), allocation_count_(0) {}
+
+    /**
+     * Resets the buffer to hold no elements, keeping its capacity.
+     */
+    void clear() {
+
+        size_ = 0;
+        allocation_count_ = 0;
+
+    }
+
+    /**
+     * Makes sure the buffer can hold the given number of elements without growing.
+     */
+    void reserve(size_t capacity) {
+
+        if (capacity > storage_.size()) {
+            grow(capacity);
+        }
+
+    }
+
+    /**
+     * Sets the number of elements in use. New elements keep whatever value their slot last held.
+     */
+    void resize(size_t new_size) {
+
+        reserve(new_size);
+        size_ = new_size;
+
+    }
+
+    /**
+     * Appends an element to the buffer, and returns a reference to it.
+     * The element keeps whatever value its slot last held, so that it can be filled in in place.
+     */
+    T & add() {
+
+        if (size_ == storage_.size()) {
+            grow(size_ + 1);
+        }
+
+        return storage_[size_++];
+
+    }
+
+    /**
+     * Appends a copy of the given element to the buffer.
+     */
+    void push_back(const T & value) {
+
+        add() = value;
+
+    }
+
+    /**
+     * Getter for the number of elements in use.
+     */
+    size_t size() const {
+        return size_;
+    }
+
+    /**
+     * Returns whether no elements are in use.
+     */
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    /**
+     * Getter for the number of elements the buffer can hold without growing.
+     */
+    size_t capacity() const {
+        return storage_.size();
+    }
+
+    /**
+     * Getter for the number of times the storage has grown since the buffer was last cleared.
+     */
+    int getAllocationCount() const {
+        return allocation_count_;
+    }
+
+    T & operator[](size_t index) {
+        return storage_[index];
+    }
+
+    const T & operator[](size_t index) const {
+        return storage_[index];
+    }
+
+    T & back() {
+        return storage_[size_ - 1];
+    }
+
+    const T & back() const {
+        return storage_[size_ - 1];
+    }
+
+    T * data() {
+        return storage_.data();
+    }
+
+    const T * data() const {
+        return storage_.data();
+    }
+
+};
+
+#endif /* GeometryBuffer_h */
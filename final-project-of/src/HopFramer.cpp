@@ -0,0 +1,139 @@
+//
+//  HopFramer.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "HopFramer.h"
+#include <algorithm>
+
+/**
+ * Constructor for a HopFramer object, with windows of 1024 frames every 512 frames.
+ */
+HopFramer::HopFramer() noexcept {
+    
+    window_size_ = 1024;
+    hop_size_ = 512;
+    number_of_channels_ = 1;
+    
+    reset();
+    
+}
+
+/**
+ * Sets the size of the windows and of the hop between them, and starts over.
+ */
+void HopFramer::setup(int window_size, int hop_size) {
+    
+    window_size_ = std::max(window_size, 1);
+    hop_size_ = std::max(hop_size, 1);
+    
+    reset();
+    
+}
+
+/**
+ * Drops the frames pushed so far, so that the next frames pushed start a new stream.
+ */
+void HopFramer::reset() {
+    
+    samples_.clear();
+    first_frame_ = 0;
+    next_frame_ = -1;
+    window_offset_ = 0;
+    
+}
+
+/**
+ * Getter for the number of frames in a window.
+ */
+int HopFramer::getWindowSize() const {
+    
+    return window_size_;
+    
+}
+
+/**
+ * Getter for the number of frames from the start of a window to the start of the next.
+ */
+int HopFramer::getHopSize() const {
+    
+    return hop_size_;
+    
+}
+
+/**
+ * Getter for the number of channels of the windows.
+ */
+int HopFramer::getNumberOfChannels() const {
+    
+    return number_of_channels_;
+    
+}
+
+/**
+ * Pushes frames of the stream.
+ */
+void HopFramer::push(const float * samples, int number_of_frames, int number_of_channels, long long start_frame) {
+    
+    if (number_of_frames <= 0 || number_of_channels <= 0) {
+        return;
+    }
+    
+    if (start_frame != next_frame_ || number_of_channels != number_of_channels_) {
+        
+        // The frames do not follow on from the ones before: start over from them.
+        
+        reset();
+        
+        number_of_channels_ = number_of_channels;
+        first_frame_ = start_frame;
+        
+    } else {
+        
+        // Drop the frames before the next window (the windows taken so far are not used anymore).
+        
+        int frames_to_drop = std::min(window_offset_, (int) (samples_.size() / number_of_channels_));
+        
+        samples_.erase(samples_.begin(), samples_.begin() + frames_to_drop * number_of_channels_);
+        first_frame_ += frames_to_drop;
+        window_offset_ -= frames_to_drop;
+        
+    }
+    
+    // If the next window starts past the frames kept (when the hop is longer than the window),
+    // the frames before its start are not needed.
+    
+    int frames_to_skip = std::min(std::max(window_offset_ - (int) (samples_.size() / number_of_channels_), 0),
+                                  number_of_frames);
+    
+    first_frame_ += frames_to_skip;
+    window_offset_ -= frames_to_skip;
+    
+    samples_.insert(samples_.end(), samples + frames_to_skip * number_of_channels,
+                    samples + number_of_frames * number_of_channels);
+    
+    next_frame_ = start_frame + number_of_frames;
+    
+}
+
+/**
+ * Takes the next window, if all its frames have been pushed.
+ */
+bool HopFramer::popWindow(const float * & window, long long & window_start_frame) {
+    
+    int number_of_frames = (int) (samples_.size() / number_of_channels_);
+    
+    if (window_offset_ + window_size_ > number_of_frames) {
+        return false;
+    }
+    
+    window = samples_.data() + window_offset_ * number_of_channels_;
+    window_start_frame = first_frame_ + window_offset_;
+    
+    window_offset_ += hop_size_;
+    
+    return true;
+    
+}
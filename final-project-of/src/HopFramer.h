@@ -0,0 +1,89 @@
+//
+//  HopFramer.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef HopFramer_h
+#define HopFramer_h
+
+#include <vector>
+
+/**
+ * Class that cuts a stream of (interleaved) frames into overlapping windows: a window of window_size frames
+ * starts every hop_size frames, so that every frame of the stream is analyzed, however often it is pushed.
+ *
+ * The frames are pushed with their position in the stream. If they do not follow on from the frames
+ * pushed before (e.g. the song was sought, or looped), the framer starts over from them.
+ */
+class HopFramer {
+    
+    int window_size_; // the number of frames in a window
+    
+    int hop_size_; // the number of frames from the start of a window to the start of the next
+    
+    int number_of_channels_; // the number of channels of the frames
+    
+    std::vector<float> samples_; // the frames pushed which are still to be windowed (interleaved)
+    
+    long long first_frame_; // the position in the stream of the first frame in samples_
+    
+    long long next_frame_; // the position in the stream of the frame expected to be pushed next (-1 if none is)
+    
+    int window_offset_; // the offset (in frames) in samples_ of the start of the next window
+    
+public:
+    
+    /**
+     * Constructor for a HopFramer object, with windows of 1024 frames every 512 frames.
+     */
+    HopFramer() noexcept;
+    
+    /**
+     * Sets the size of the windows and of the hop between them, and starts over.
+     */
+    void setup(int window_size, int hop_size);
+    
+    /**
+     * Drops the frames pushed so far, so that the next frames pushed start a new stream.
+     */
+    void reset();
+    
+    /**
+     * Getter for the number of frames in a window.
+     */
+    int getWindowSize() const;
+    
+    /**
+     * Getter for the number of frames from the start of a window to the start of the next.
+     */
+    int getHopSize() const;
+    
+    /**
+     * Getter for the number of channels of the windows.
+     */
+    int getNumberOfChannels() const;
+    
+    /**
+     * Pushes frames of the stream.
+     *
+     * @param samples - the interleaved samples of the frames
+     * @param number_of_frames - the number of frames
+     * @param number_of_channels - the number of interleaved channels
+     * @param start_frame - the position in the stream of the first frame
+     */
+    void push(const float * samples, int number_of_frames, int number_of_channels, long long start_frame);
+    
+    /**
+     * Takes the next window, if all its frames have been pushed.
+     *
+     * @param window - set to the interleaved samples of the window (valid till the next push)
+     * @param window_start_frame - set to the position in the stream of the first frame of the window
+     * @return whether there was a window to take
+     */
+    bool popWindow(const float * & window, long long & window_start_frame);
+    
+};
+
+#endif /* HopFramer_h */
@@ -0,0 +1,662 @@
+//
+//  JsonValue.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "JsonValue.h"
+#include <cstdlib>
+#include <sstream>
+
+const int kMaximumDepth = 64; // the deepest arrays and objects may be nested (so a malformed file cannot overflow the stack)
+
+/**
+ * Class that parses the text of a JSON document by recursive descent.
+ */
+class JsonParser {
+
+    const std::string & text_; // the text being parsed
+
+    size_t position_; // the position of the next character to be read
+
+    std::string error_; // what is wrong with the text (empty if nothing is, so far)
+
+public:
+
+    /**
+     * Constructor for a JsonParser object, which parses the given text.
+     */
+    JsonParser(const std::string & text) noexcept : text_(text), position_(0) {
+
+    }
+
+    /**
+     * Parses the whole text as one value.
+     */
+    bool parseDocument(JsonValue & value) {
+
+        skipWhitespace();
+
+        if (!parseValue(value, 0)) {
+            return false;
+        }
+
+        skipWhitespace();
+
+        if (position_ != text_.size()) {
+            return fail("unexpected text after the end of the document");
+        }
+
+        return true;
+
+    }
+
+    /**
+     * Getter for what is wrong with the text, with the line it is on.
+     */
+    std::string getError() const {
+
+        int line = 1;
+
+        for (size_t index = 0; index < position_ && index < text_.size(); index++) {
+
+            if (text_[index] == '\n') {
+                line++;
+            }
+        }
+
+        std::ostringstream stream;
+        stream << "line " << line << ": " << error_;
+
+        return stream.str();
+
+    }
+
+private:
+
+    /**
+     * Records what is wrong with the text (the first thing found wrong), and returns false.
+     */
+    bool fail(const std::string & error) {
+
+        if (error_.empty()) {
+            error_ = error;
+        }
+
+        return false;
+
+    }
+
+    /**
+     * Skips the whitespace from the current position.
+     */
+    void skipWhitespace() {
+
+        while (position_ < text_.size() && (text_[position_] == ' ' || text_[position_] == '\t' ||
+                                            text_[position_] == '\n' || text_[position_] == '\r')) {
+            position_++;
+        }
+
+    }
+
+    /**
+     * Reads the given word (e.g. "true") from the current position, if it is there.
+     */
+    bool consumeWord(const char * word) {
+
+        size_t length = std::char_traits<char>::length(word);
+
+        if (text_.compare(position_, length, word) != 0) {
+            return false;
+        }
+
+        position_ += length;
+
+        return true;
+
+    }
+
+    /**
+     * Parses a value from the current position.
+     */
+    bool parseValue(JsonValue & value, int depth) {
+
+        if (position_ >= text_.size()) {
+            return fail("unexpected end of the document");
+        }
+
+        char character = text_[position_];
+
+        if (character == '{') {
+            return parseObject(value, depth + 1);
+        }
+
+        if (character == '[') {
+            return parseArray(value, depth + 1);
+        }
+
+        if (character == '"') {
+
+            value.type_ = JsonValue::TYPE_STRING;
+
+            return parseString(value.string_value_);
+        }
+
+        if (character == '-' || (character >= '0' && character <= '9')) {
+            return parseNumber(value);
+        }
+
+        if (consumeWord("true")) {
+
+            value.type_ = JsonValue::TYPE_BOOL;
+            value.bool_value_ = true;
+
+            return true;
+        }
+
+        if (consumeWord("false")) {
+
+            value.type_ = JsonValue::TYPE_BOOL;
+            value.bool_value_ = false;
+
+            return true;
+        }
+
+        if (consumeWord("null")) {
+
+            value.type_ = JsonValue::TYPE_NULL;
+
+            return true;
+        }
+
+        return fail(std::string("unexpected character '") + character + "'");
+
+    }
+
+    /**
+     * Parses an object from the current position (its opening brace).
+     */
+    bool parseObject(JsonValue & value, int depth) {
+
+        if (depth > kMaximumDepth) {
+            return fail("too deeply nested");
+        }
+
+        value.type_ = JsonValue::TYPE_OBJECT;
+        position_++;
+
+        skipWhitespace();
+
+        if (position_ < text_.size() && text_[position_] == '}') {
+
+            position_++;
+
+            return true;
+        }
+
+        while (true) {
+
+            skipWhitespace();
+
+            if (position_ >= text_.size() || text_[position_] != '"') {
+                return fail("expected the name of a member");
+            }
+
+            value.members_.push_back(std::make_pair(std::string(), JsonValue()));
+
+            if (!parseString(value.members_.back().first)) {
+                return false;
+            }
+
+            skipWhitespace();
+
+            if (position_ >= text_.size() || text_[position_] != ':') {
+                return fail("expected ':' after the name of a member");
+            }
+
+            position_++;
+            skipWhitespace();
+
+            if (!parseValue(value.members_.back().second, depth)) {
+                return false;
+            }
+
+            skipWhitespace();
+
+            if (position_ < text_.size() && text_[position_] == ',') {
+
+                position_++;
+                continue;
+            }
+
+            if (position_ < text_.size() && text_[position_] == '}') {
+
+                position_++;
+
+                return true;
+            }
+
+            return fail("expected ',' or '}' in an object");
+        }
+
+    }
+
+    /**
+     * Parses an array from the current position (its opening bracket).
+     */
+    bool parseArray(JsonValue & value, int depth) {
+
+        if (depth > kMaximumDepth) {
+            return fail("too deeply nested");
+        }
+
+        value.type_ = JsonValue::TYPE_ARRAY;
+        position_++;
+
+        skipWhitespace();
+
+        if (position_ < text_.size() && text_[position_] == ']') {
+
+            position_++;
+
+            return true;
+        }
+
+        while (true) {
+
+            skipWhitespace();
+
+            value.elements_.push_back(JsonValue());
+
+            if (!parseValue(value.elements_.back(), depth)) {
+                return false;
+            }
+
+            skipWhitespace();
+
+            if (position_ < text_.size() && text_[position_] == ',') {
+
+                position_++;
+                continue;
+            }
+
+            if (position_ < text_.size() && text_[position_] == ']') {
+
+                position_++;
+
+                return true;
+            }
+
+            return fail("expected ',' or ']' in an array");
+        }
+
+    }
+
+    /**
+     * Parses the four hexadecimal digits of a \u escape, from the current position.
+     */
+    bool parseHexDigits(unsigned int & code_unit) {
+
+        if (position_ + 4 > text_.size()) {
+            return fail("unexpected end of the document in a \\u escape");
+        }
+
+        code_unit = 0;
+
+        for (int index = 0; index < 4; index++) {
+
+            char digit = text_[position_++];
+            code_unit <<= 4;
+
+            if (digit >= '0' && digit <= '9') {
+                code_unit |= digit - '0';
+            } else if (digit >= 'a' && digit <= 'f') {
+                code_unit |= digit - 'a' + 10;
+            } else if (digit >= 'A' && digit <= 'F') {
+                code_unit |= digit - 'A' + 10;
+            } else {
+                return fail("invalid \\u escape");
+            }
+        }
+
+        return true;
+
+    }
+
+    /**
+     * Appends a code point to a string, encoded as UTF-8.
+     */
+    static void appendUtf8(std::string & string, unsigned int code_point) {
+
+        if (code_point < 0x80) {
+
+            string += (char) code_point;
+
+        } else if (code_point < 0x800) {
+
+            string += (char) (0xC0 | (code_point >> 6));
+            string += (char) (0x80 | (code_point & 0x3F));
+
+        } else if (code_point < 0x10000) {
+
+            string += (char) (0xE0 | (code_point >> 12));
+            string += (char) (0x80 | ((code_point >> 6) & 0x3F));
+            string += (char) (0x80 | (code_point & 0x3F));
+
+        } else {
+
+            string += (char) (0xF0 | (code_point >> 18));
+            string += (char) (0x80 | ((code_point >> 12) & 0x3F));
+            string += (char) (0x80 | ((code_point >> 6) & 0x3F));
+            string += (char) (0x80 | (code_point & 0x3F));
+        }
+
+    }
+
+    /**
+     * Parses a string from the current position (its opening quote).
+     */
+    bool parseString(std::string & string) {
+
+        position_++;
+        string.clear();
+
+        while (position_ < text_.size()) {
+
+            char character = text_[position_++];
+
+            if (character == '"') {
+                return true;
+            }
+
+            if ((unsigned char) character < 0x20) {
+                return fail("control character in a string");
+            }
+
+            if (character != '\\') {
+
+                string += character;
+                continue;
+            }
+
+            if (position_ >= text_.size()) {
+                break;
+            }
+
+            char escape = text_[position_++];
+
+            switch (escape) {
+                case '"': string += '"'; break;
+                case '\\': string += '\\'; break;
+                case '/': string += '/'; break;
+                case 'b': string += '\b'; break;
+                case 'f': string += '\f'; break;
+                case 'n': string += '\n'; break;
+                case 'r': string += '\r'; break;
+                case 't': string += '\t'; break;
+                case 'u': {
+
+                    unsigned int code_point;
+
+                    if (!parseHexDigits(code_point)) {
+                        return false;
+                    }
+
+                    // A code point above U+FFFF is escaped as a surrogate pair.
+
+                    if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+
+                        unsigned int low_surrogate;
+
+                        if (!consumeWord("\\u") || !parseHexDigits(low_surrogate) ||
+                            low_surrogate < 0xDC00 || low_surrogate > 0xDFFF) {
+                            return fail("invalid surrogate pair");
+                        }
+
+                        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low_surrogate - 0xDC00);
+                    }
+
+                    appendUtf8(string, code_point);
+                    break;
+                }
+                default:
+                    return fail(std::string("invalid escape '\\") + escape + "'");
+            }
+        }
+
+        return fail("unexpected end of the document in a string");
+
+    }
+
+    /**
+     * Parses a number from the current position.
+     */
+    bool parseNumber(JsonValue & value) {
+
+        // Check the number is in JSON's (stricter) form, then have strtod read it.
+
+        size_t start = position_;
+
+        if (text_[position_] == '-') {
+            position_++;
+        }
+
+        if (position_ < text_.size() && text_[position_] == '0') {
+
+            position_++;
+
+        } else if (!skipDigits()) {
+
+            return fail("invalid number");
+        }
+
+        if (position_ < text_.size() && text_[position_] == '.') {
+
+            position_++;
+
+            if (!skipDigits()) {
+                return fail("invalid number");
+            }
+        }
+
+        if (position_ < text_.size() && (text_[position_] == 'e' || text_[position_] == 'E')) {
+
+            position_++;
+
+            if (position_ < text_.size() && (text_[position_] == '+' || text_[position_] == '-')) {
+                position_++;
+            }
+
+            if (!skipDigits()) {
+                return fail("invalid number");
+            }
+        }
+
+        value.type_ = JsonValue::TYPE_NUMBER;
+        value.number_value_ = strtod(text_.substr(start, position_ - start).c_str(), nullptr);
+
+        return true;
+
+    }
+
+    /**
+     * Skips the digits from the current position, returning whether there were any.
+     */
+    bool skipDigits() {
+
+        size_t start = position_;
+
+        while (position_ < text_.size() && text_[position_] >= '0' && text_[position_] <= '9') {
+            position_++;
+        }
+
+        return position_ > start;
+
+    }
+
+};
+
+/**
+ * Constructor for a JsonValue object, which is null.
+ */
+JsonValue::JsonValue() noexcept {
+
+    type_ = TYPE_NULL;
+    bool_value_ = false;
+    number_value_ = 0;
+
+}
+
+/**
+ * Parses a JSON document.
+ */
+bool JsonValue::parse(const std::string & text, JsonValue & value, std::string & error) {
+
+    JsonValue document;
+    JsonParser parser(text);
+
+    if (!parser.parseDocument(document)) {
+
+        error = parser.getError();
+
+        return false;
+    }
+
+    value = std::move(document);
+
+    return true;
+
+}
+
+/**
+ * Getter for the type of the value.
+ */
+JsonValue::Type JsonValue::getType() const {
+
+    return type_;
+
+}
+
+/**
+ * Returns whether the value is of the given type.
+ */
+bool JsonValue::is(Type type) const {
+
+    return type_ == type;
+
+}
+
+/**
+ * Returns the value as a bool (or the given default, if it is not one).
+ */
+bool JsonValue::asBool(bool default_value) const {
+
+    return (type_ == TYPE_BOOL) ? bool_value_ : default_value;
+
+}
+
+/**
+ * Returns the value as a number (or the given default, if it is not one).
+ */
+double JsonValue::asNumber(double default_value) const {
+
+    return (type_ == TYPE_NUMBER) ? number_value_ : default_value;
+
+}
+
+/**
+ * Returns the value as a string (or the given default, if it is not one).
+ */
+std::string JsonValue::asString(const std::string & default_value) const {
+
+    return (type_ == TYPE_STRING) ? string_value_ : default_value;
+
+}
+
+/**
+ * Returns the number of elements (of an array) or members (of an object), or 0 for any other value.
+ */
+int JsonValue::size() const {
+
+    if (type_ == TYPE_ARRAY) {
+        return elements_.size();
+    }
+
+    if (type_ == TYPE_OBJECT) {
+        return members_.size();
+    }
+
+    return 0;
+
+}
+
+/**
+ * Returns an element of an array (or a null value, if there is no such element).
+ */
+const JsonValue & JsonValue::operator[](int index) const {
+
+    static const JsonValue null_value;
+
+    if (type_ != TYPE_ARRAY || index < 0 || index >= (int) elements_.size()) {
+        return null_value;
+    }
+
+    return elements_[index];
+
+}
+
+/**
+ * Returns the member of an object with the given name (or a null value, if there is no such member).
+ */
+const JsonValue & JsonValue::operator[](const std::string & name) const {
+
+    static const JsonValue null_value;
+
+    if (type_ == TYPE_OBJECT) {
+
+        for (const std::pair<std::string, JsonValue> & member : members_) {
+
+            if (member.first == name) {
+                return member.second;
+            }
+        }
+    }
+
+    return null_value;
+
+}
+
+/**
+ * Returns whether the value is an object with a member of the given name.
+ */
+bool JsonValue::hasMember(const std::string & name) const {
+
+    if (type_ == TYPE_OBJECT) {
+
+        for (const std::pair<std::string, JsonValue> & member : members_) {
+
+            if (member.first == name) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+
+}
+
+/**
+ * Returns the name of a member of an object (or an empty string, if there is no such member).
+ */
+const std::string & JsonValue::getMemberName(int index) const {
+
+    static const std::string empty_name;
+
+    if (type_ != TYPE_OBJECT || index < 0 || index >= (int) members_.size()) {
+        return empty_name;
+    }
+
+    return members_[index].first;
+
+}
@@ -0,0 +1,124 @@
+//
+//  JsonValue.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef JsonValue_h
+#define JsonValue_h
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Class that models a value of a JSON document (e.g. a configuration file), and parses one from text.
+ *
+ * Only what a small configuration needs is supported: the whole of RFC 8259 is parsed (escapes, \u
+ * sequences and all), but numbers are read as doubles, and the members of an object are looked up
+ * one after another (objects are expected to be small). A value is meant to be read once, when the
+ * configuration is loaded, and turned into whatever is needed every frame.
+ */
+class JsonValue {
+
+public:
+
+    /**
+     * The types of JSON values.
+     */
+    enum Type {
+        TYPE_NULL,
+        TYPE_BOOL,
+        TYPE_NUMBER,
+        TYPE_STRING,
+        TYPE_ARRAY,
+        TYPE_OBJECT
+    };
+
+private:
+
+    Type type_; // the type of the value
+
+    bool bool_value_; // the value, if it is a bool
+
+    double number_value_; // the value, if it is a number
+
+    std::string string_value_; // the value, if it is a string
+
+    std::vector<JsonValue> elements_; // the elements, if the value is an array
+
+    std::vector<std::pair<std::string, JsonValue> > members_; // the members (in order), if the value is an object
+
+    friend class JsonParser;
+
+public:
+
+    /**
+     * Constructor for a JsonValue object, which is null.
+     */
+    JsonValue() noexcept;
+
+    /**
+     * Parses a JSON document.
+     *
+     * @param text - the text of the document
+     * @param value - the value to be set to the document's (left as it is if the text is not valid JSON)
+     * @param error - set to what is wrong with the text (with the line it is on), if it is not valid JSON
+     * @return true if the text is valid JSON, false otherwise
+     */
+    static bool parse(const std::string & text, JsonValue & value, std::string & error);
+
+    /**
+     * Getter for the type of the value.
+     */
+    Type getType() const;
+
+    /**
+     * Returns whether the value is of the given type.
+     */
+    bool is(Type type) const;
+
+    /**
+     * Returns the value as a bool (or the given default, if it is not one).
+     */
+    bool asBool(bool default_value) const;
+
+    /**
+     * Returns the value as a number (or the given default, if it is not one).
+     */
+    double asNumber(double default_value) const;
+
+    /**
+     * Returns the value as a string (or the given default, if it is not one).
+     */
+    std::string asString(const std::string & default_value) const;
+
+    /**
+     * Returns the number of elements (of an array) or members (of an object), or 0 for any other value.
+     */
+    int size() const;
+
+    /**
+     * Returns an element of an array (or a null value, if there is no such element).
+     */
+    const JsonValue & operator[](int index) const;
+
+    /**
+     * Returns the member of an object with the given name (or a null value, if there is no such member).
+     */
+    const JsonValue & operator[](const std::string & name) const;
+
+    /**
+     * Returns whether the value is an object with a member of the given name.
+     */
+    bool hasMember(const std::string & name) const;
+
+    /**
+     * Returns the name of a member of an object (or an empty string, if there is no such member).
+     */
+    const std::string & getMemberName(int index) const;
+
+};
+
+#endif /* JsonValue_h */
@@ -0,0 +1,312 @@
+//
+//  LiveInput.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "LiveInput.h"
+
+const int kHistoryLength = 32768; // the number of frames the history holds (at least the largest window or FFT)
+
+const int kRingBufferFrames = 16384; // the number of frames the ring buffer holds, to ride out slow frames
+                                     // (64 blocks of the default 256 frames)
+
+const int kMinimumRingBufferBlocks = 4; // the fewest captured blocks the ring buffer must hold
+
+const int kMinimumBufferSize = 32; // the fewest frames the backend may capture at a time
+
+/**
+ * Constructor for a LiveInput object, which does not start capturing yet.
+ */
+LiveInput::LiveInput() noexcept {
+    
+    sample_rate_ = 44100;
+    number_of_channels_ = 2;
+    buffer_size_ = 256;
+    capture_time_micros_ = 0;
+    dropped_frames_ = 0;
+    history_capacity_ = kHistoryLength;
+    frames_received_ = 0;
+    received_capture_time_micros_ = 0;
+    
+}
+
+/**
+ * Destructor for a LiveInput object, which stops the backend.
+ */
+LiveInput::~LiveInput() {
+    
+    close();
+    
+}
+
+/**
+ * Starts capturing from a backend.
+ */
+bool LiveInput::setup(std::unique_ptr<AudioInputBackend> backend, int sample_rate, int buffer_size,
+                      int number_of_channels) {
+    
+    close();
+    
+    if (!isValidBufferSize(buffer_size)) {
+        
+        ofLogError("LiveInput") << "Invalid buffer size " << buffer_size << " (expected a power of 2 from "
+                                << kMinimumBufferSize << " to " << getMaximumBufferSize() << ")";
+        return false;
+        
+    }
+    
+    sample_rate_ = sample_rate;
+    buffer_size_ = buffer_size;
+    number_of_channels_ = number_of_channels;
+    
+    // Everything the audio thread touches is allocated before the backend is started.
+    
+    ring_buffer_.allocate(kRingBufferFrames * number_of_channels);
+    capture_time_micros_ = 0;
+    dropped_frames_ = 0;
+    
+    history_.assign(history_capacity_ * number_of_channels, 0);
+    frames_received_ = 0;
+    received_capture_time_micros_ = 0;
+    
+    if (!backend || !backend->start(this, sample_rate, buffer_size, number_of_channels)) {
+        
+        ofLogError("LiveInput") << "Could not start capturing" << (backend ? " from " + backend->getName() : "");
+        return false;
+        
+    }
+    
+    // The backend may not capture at the sample rate asked for (e.g. a file has its own).
+    
+    backend_ = std::move(backend);
+    sample_rate_ = backend_->getSampleRate();
+    
+    return true;
+    
+}
+
+/**
+ * Stops capturing, and releases the backend.
+ */
+void LiveInput::close() {
+    
+    if (backend_) {
+        
+        backend_->stop();
+        backend_.reset();
+        
+    }
+    
+}
+
+/**
+ * Returns whether the input is being captured.
+ */
+bool LiveInput::isOpen() const {
+    
+    return backend_ != nullptr;
+    
+}
+
+/**
+ * Getter for the name of the backend the input is captured from (empty if closed).
+ */
+std::string LiveInput::getBackendName() const {
+    
+    return backend_ ? backend_->getName() : "";
+    
+}
+
+/**
+ * Drains the frames captured since the last call into the history. Called on the main thread.
+ */
+void LiveInput::update() {
+    
+    // Read the capture time before draining, so that it belongs to a block which is drained
+    // (the audio thread records it after pushing the block).
+    
+    uint64_t capture_time_micros = capture_time_micros_.load(std::memory_order_acquire);
+    
+    size_t samples_available = ring_buffer_.getReadAvailable();
+    samples_available -= samples_available % number_of_channels_;
+    
+    drain_buffer_.resize(samples_available);
+    ring_buffer_.pop(drain_buffer_.data(), samples_available);
+    
+    long long frames_available = samples_available / number_of_channels_;
+    
+    for (long long frame = 0; frame < frames_available; frame++) {
+        
+        long long history_index = ((frames_received_ + frame) % history_capacity_) * number_of_channels_;
+        
+        for (int channel = 0; channel < number_of_channels_; channel++) {
+            history_[history_index + channel] = drain_buffer_[frame * number_of_channels_ + channel];
+        }
+    }
+    
+    frames_received_ += frames_available;
+    
+    if (frames_available > 0) {
+        received_capture_time_micros_ = capture_time_micros;
+    }
+    
+}
+
+/**
+ * Returns the time of the newest frame drained by update() (in seconds of input captured so far).
+ */
+double LiveInput::getClockSeconds() {
+    
+    return (double) frames_received_ / sample_rate_;
+    
+}
+
+/**
+ * Getter for the number of frames the backend captures at a time.
+ */
+int LiveInput::getBufferSize() const {
+    
+    return buffer_size_;
+    
+}
+
+/**
+ * Getter for the sample rate of the input.
+ */
+int LiveInput::getSampleRate() const {
+    
+    return sample_rate_;
+    
+}
+
+/**
+ * Getter for the time (in microseconds, as ofGetElapsedTimeMicros()) the newest frame
+ * drained by update() was captured (0 if nothing has been captured yet).
+ */
+uint64_t LiveInput::getCaptureTimeMicros() const {
+    
+    return received_capture_time_micros_;
+    
+}
+
+/**
+ * Getter for the number of frames which were dropped, as the main thread did not drain them in time.
+ */
+long long LiveInput::getDroppedFrames() const {
+    
+    return dropped_frames_;
+    
+}
+
+/**
+ * Copies any frames of the history into a sound buffer (frames which have not been received yet,
+ * or have left the history, are silent).
+ */
+void LiveInput::copyFrames(long long start_frame, int number_of_frames, ofSoundBuffer & sound_buffer) {
+    
+    sound_buffer.setSampleRate(sample_rate_);
+    sound_buffer.allocate(number_of_frames, number_of_channels_);
+    
+    for (int frame = 0; frame < number_of_frames; frame++) {
+        
+        long long history_frame = start_frame + frame;
+        
+        // Frames which have not been received yet (or have left the history) are silent.
+        
+        bool is_in_history = history_frame >= 0 && history_frame < frames_received_
+                          && history_frame >= frames_received_ - history_capacity_;
+        long long history_index = (history_frame % history_capacity_) * number_of_channels_;
+        
+        for (int channel = 0; channel < number_of_channels_; channel++) {
+            sound_buffer[frame * number_of_channels_ + channel] = is_in_history ? history_[history_index + channel] : 0;
+        }
+    }
+    
+}
+
+/**
+ * Returns the most recent window of samples.
+ */
+ofSoundBuffer LiveInput::getCurrentSoundBuffer(int number_of_frames) {
+    
+    ofSoundBuffer sound_buffer;
+    copyFrames(frames_received_ - number_of_frames, number_of_frames, sound_buffer);
+    
+    return sound_buffer;
+    
+}
+
+/**
+ * Returns the number of the first frame of the most recent window of samples (counted from the
+ * start of the feed).
+ */
+long long LiveInput::getCurrentWindowStartFrame(int number_of_frames) {
+    
+    return frames_received_ - number_of_frames;
+    
+}
+
+/**
+ * Returns the spectrum band values of the most recent samples.
+ */
+const std::vector<float> & LiveInput::getSpectrum(int number_of_bands) {
+    
+    int fft_size = SpectrumAnalyzer::getFftSize(number_of_bands);
+    
+    copyFrames(frames_received_ - fft_size, fft_size, window_sound_buffer_);
+    
+    return spectrum_analyzer_.getSpectrum(window_sound_buffer_.getBuffer().data(), number_of_channels_, number_of_bands);
+    
+}
+
+/**
+ * Pushes the captured block of samples into the ring buffer. This is called on the audio thread.
+ */
+void LiveInput::audioIn(ofSoundBuffer & input_buffer) {
+    
+    // Only whole frames are pushed, so that the channels stay lined up.
+    
+    size_t samples_to_push = std::min(input_buffer.size(), ring_buffer_.getWriteAvailable());
+    samples_to_push -= samples_to_push % number_of_channels_;
+    
+    size_t samples_pushed = ring_buffer_.push(input_buffer.getBuffer().data(), samples_to_push);
+    
+    if (samples_pushed < input_buffer.size()) {
+        dropped_frames_ += (input_buffer.size() - samples_pushed) / number_of_channels_;
+    }
+    
+    capture_time_micros_.store(ofGetElapsedTimeMicros(), std::memory_order_release);
+    
+}
+
+/**
+ * Returns whether the backend may capture the given number of frames at a time.
+ */
+bool LiveInput::isValidBufferSize(int buffer_size) {
+    
+    // The size must be a power of 2 (as sound devices expect), and the ring buffer must hold a few blocks of it.
+    
+    return buffer_size >= kMinimumBufferSize && buffer_size <= getMaximumBufferSize()
+           && (buffer_size & (buffer_size - 1)) == 0;
+    
+}
+
+/**
+ * Returns the fewest frames the backend may capture at a time.
+ */
+int LiveInput::getMinimumBufferSize() {
+    
+    return kMinimumBufferSize;
+    
+}
+
+/**
+ * Returns the most frames the backend may capture at a time.
+ */
+int LiveInput::getMaximumBufferSize() {
+    
+    return kRingBufferFrames / kMinimumRingBufferBlocks;
+    
+}
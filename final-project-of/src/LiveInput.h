@@ -0,0 +1,187 @@
+//
+//  LiveInput.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef LiveInput_h
+#define LiveInput_h
+
+#include "ofMain.h"
+#include "AnalysisInput.h"
+#include "AudioInputBackend.h"
+#include "SpectrumAnalyzer.h"
+#include "SpscRingBuffer.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * Class that feeds the visualizers from a live sound input (e.g. a mixer feed) instead of a song.
+ * The blocks of samples come from an AudioInputBackend: a sound input device, or a file standing in for one.
+ *
+ * The audio thread (the backend's thread) pushes every block it captures (in audioIn()) into a lock-free ring buffer,
+ * without ever blocking. On the main thread, update() drains the ring buffer into a history of
+ * the most recent frames, which the windows and spectra for the visualizers are read from.
+ *
+ * The time each block was captured is recorded, so that the latency from the input to the
+ * frame drawn from it can be measured.
+ */
+class LiveInput : public ofBaseSoundInput, public AnalysisInput {
+    
+    std::unique_ptr<AudioInputBackend> backend_; // the backend the input is captured from (null if closed)
+    
+    int sample_rate_; // the sample rate of the input
+    
+    int number_of_channels_; // the number of channels of the input
+    
+    int buffer_size_; // the number of frames the backend captures at a time
+    
+    SpscRingBuffer<float> ring_buffer_; // the samples captured by the audio thread, till the main thread drains them
+    
+    std::atomic<uint64_t> capture_time_micros_; // the time the newest block in the ring buffer was captured
+    
+    std::atomic<long long> dropped_frames_; // the number of frames which did not fit in the ring buffer
+    
+    std::vector<float> history_; // the most recent frames drained from the ring buffer, frame f being at f % capacity
+    
+    long long history_capacity_; // the number of frames the history holds
+    
+    long long frames_received_; // the number of frames drained from the ring buffer so far
+    
+    uint64_t received_capture_time_micros_; // the time the newest block drained from the ring buffer was captured
+    
+    std::vector<float> drain_buffer_; // the samples popped from the ring buffer at a time
+    
+    ofSoundBuffer window_sound_buffer_; // the window of samples the spectrum is computed from
+    
+    SpectrumAnalyzer spectrum_analyzer_; // the analyzer which computes the spectrum of the input
+    
+public:
+    
+    /**
+     * Constructor for a LiveInput object, which does not start capturing yet.
+     */
+    LiveInput() noexcept;
+    
+    /**
+     * Destructor for a LiveInput object, which stops the backend.
+     */
+    ~LiveInput();
+    
+    /**
+     * Starts capturing from a backend.
+     *
+     * @param backend - the backend to capture from (e.g. a SoundStreamInputBackend for the default input device)
+     * @param sample_rate - the sample rate to capture at (the backend may deliver another, see getSampleRate())
+     * @param buffer_size - the number of frames to capture at a time (smaller buffers give a lower latency),
+     *                      a power of 2 which isValidBufferSize()
+     * @param number_of_channels - the number of channels to capture
+     * @return whether the backend could be started (false if the buffer size is invalid)
+     */
+    bool setup(std::unique_ptr<AudioInputBackend> backend, int sample_rate, int buffer_size, int number_of_channels);
+    
+    /**
+     * Stops capturing, and releases the backend.
+     */
+    void close();
+    
+    /**
+     * Returns whether the input is being captured.
+     */
+    bool isOpen() const;
+    
+    /**
+     * Getter for the name of the backend the input is captured from (empty if closed).
+     */
+    std::string getBackendName() const;
+    
+    /**
+     * Drains the frames captured since the last call into the history. Called on the main thread.
+     */
+    void update();
+    
+    /**
+     * Returns the time of the newest frame drained by update() (in seconds of input captured so far).
+     */
+    double getClockSeconds();
+    
+    /**
+     * Getter for the number of frames the backend captures at a time.
+     */
+    int getBufferSize() const;
+    
+    /**
+     * Getter for the sample rate of the input.
+     */
+    int getSampleRate() const;
+    
+    /**
+     * Getter for the time (in microseconds, as ofGetElapsedTimeMicros()) the newest frame
+     * drained by update() was captured (0 if nothing has been captured yet).
+     */
+    uint64_t getCaptureTimeMicros() const;
+    
+    /**
+     * Getter for the number of frames which were dropped, as the main thread did not drain them in time.
+     */
+    long long getDroppedFrames() const;
+    
+    /**
+     * Returns the most recent window of samples.
+     *
+     * @param number_of_frames - the number of frames in the window
+     */
+    ofSoundBuffer getCurrentSoundBuffer(int number_of_frames);
+    
+    /**
+     * Returns the number of the first frame of the most recent window of samples (counted from the
+     * start of the feed).
+     *
+     * @param number_of_frames - the number of frames in the window
+     */
+    long long getCurrentWindowStartFrame(int number_of_frames);
+    
+    /**
+     * Copies any frames of the history into a sound buffer (frames which have not been received yet,
+     * or have left the history, are silent).
+     *
+     * @param start_frame - the number of the first frame (counted from the start of the feed)
+     * @param number_of_frames - the number of frames
+     * @param sound_buffer - the sound buffer the frames are copied into
+     */
+    void copyFrames(long long start_frame, int number_of_frames, ofSoundBuffer & sound_buffer);
+    
+    /**
+     * Returns the spectrum band values of the most recent samples.
+     *
+     * @param number_of_bands - the number of spectrum bands
+     * @return the spectrum band values (valid till the next call)
+     */
+    const std::vector<float> & getSpectrum(int number_of_bands);
+    
+    /**
+     * Pushes the captured block of samples into the ring buffer. This is called on the audio thread.
+     */
+    void audioIn(ofSoundBuffer & input_buffer);
+    
+    /**
+     * Returns whether the backend may capture the given number of frames at a time:
+     * a power of 2, small enough for the ring buffer to hold a few blocks of it.
+     */
+    static bool isValidBufferSize(int buffer_size);
+    
+    /**
+     * Returns the fewest frames the backend may capture at a time.
+     */
+    static int getMinimumBufferSize();
+    
+    /**
+     * Returns the most frames the backend may capture at a time.
+     */
+    static int getMaximumBufferSize();
+    
+};
+
+#endif /* LiveInput_h */
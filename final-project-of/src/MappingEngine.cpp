@@ -0,0 +1,469 @@
+//
+//  MappingEngine.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "MappingEngine.h"
+#include "ofMain.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+const char * const kFeatureNames[] = {"rms", "band", "pitch_class", "beat", "beat_phase", "tempo", "onset"}; // by MappingFeature
+
+const char * const kParameterNames[] = {"graph_radius", "particle_velocity", "edge_distance"}; // by VisualParameter
+
+const char * const kCurveNames[] = {"linear", "power", "log", "smoothstep"}; // by MappingCurve
+
+const char * const kOperationNames[] = {"set", "add", "multiply"}; // by MappingOperation
+
+const float kLowestPitchClassFrequency = 250; // the lowest frequency (in Hz) counted in the pitch classes (below it,
+                                              // a bin of the spectrum is wider than a semitone)
+
+const float kHighestPitchClassFrequency = 5000; // the highest frequency (in Hz) counted in the pitch classes
+
+// The moving graph visualizers' own mappings: the graph radius follows the band at 172 Hz, and pulses out on
+// every beat (decaying away with a time constant of 0.12 seconds); the particle velocity follows the band
+// at 4300 Hz, and is scaled with the tempo (by 1 at 120 BPM, within [0.75, 1.5]).
+
+const char * const kDefaultConfiguration = R"({
+    "mappings": [
+        {"feature": "band", "frequency": 172, "parameter": "graph_radius",
+         "input": [0.25, 3], "output": [450, 750]},
+        {"feature": "beat", "parameter": "graph_radius", "operation": "add",
+         "input": [0, 1], "output": [0, 60], "release": 0.12},
+        {"feature": "band", "frequency": 4300, "parameter": "particle_velocity",
+         "input": [0, 0.1], "output": [0.45, 0.75], "clamp": false},
+        {"feature": "tempo", "parameter": "particle_velocity", "operation": "multiply",
+         "input": [90, 180], "output": [0.75, 1.5]}
+    ]
+})";
+
+/**
+ * Looks a name up in a table of names, returning its index (-1 if it is not there).
+ */
+template <size_t N>
+static int findName(const char * const (& names)[N], const std::string & name) {
+
+    for (size_t index = 0; index < N; index++) {
+
+        if (name == names[index]) {
+            return index;
+        }
+    }
+
+    return -1;
+
+}
+
+/**
+ * Reads a [minimum, maximum] range from a configuration.
+ */
+static bool readRange(const JsonValue & value, float & minimum, float & maximum) {
+
+    if (!value.is(JsonValue::TYPE_ARRAY) || value.size() != 2 ||
+        !value[0].is(JsonValue::TYPE_NUMBER) || !value[1].is(JsonValue::TYPE_NUMBER)) {
+        return false;
+    }
+
+    minimum = value[0].asNumber(0);
+    maximum = value[1].asNumber(0);
+
+    return true;
+
+}
+
+/**
+ * Returns the fraction of the distance to a new value which is still to go after the given time,
+ * when it is followed with the given time constant (0 if it is followed at once).
+ */
+static float getRetention(float time_constant_seconds, float delta_seconds) {
+
+    if (time_constant_seconds <= 0) {
+        return 0;
+    }
+
+    return exp(- delta_seconds / time_constant_seconds);
+
+}
+
+/**
+ * Constructor for a MappingEngine object, with the default bindings.
+ */
+MappingEngine::MappingEngine() noexcept {
+
+    is_compiled_ = false;
+    uses_pitch_classes_ = false;
+    last_beat_count_ = 0;
+
+    std::fill(pitch_class_values_, pitch_class_values_ + 12, 0.0f);
+
+    std::string error;
+    load(kDefaultConfiguration, error);
+
+}
+
+/**
+ * Loads the bindings from a JSON configuration file.
+ */
+bool MappingEngine::loadFile(const std::string & file_path) {
+
+    if (!ofFile(file_path).exists()) {
+
+        ofLogError("MappingEngine") << "Could not find " << file_path;
+
+        return false;
+    }
+
+    std::string error;
+
+    if (!load(ofBufferFromFile(file_path).getText(), error)) {
+
+        ofLogError("MappingEngine") << "Could not load " << file_path << " (" << error << ")";
+
+        return false;
+    }
+
+    return true;
+
+}
+
+/**
+ * Loads the bindings from the text of a JSON configuration.
+ */
+bool MappingEngine::load(const std::string & text, std::string & error) {
+
+    JsonValue configuration;
+    std::vector<MappingBinding> bindings;
+
+    if (!JsonValue::parse(text, configuration, error) || !readBindings(configuration, bindings, error)) {
+        return false;
+    }
+
+    // Order the bindings as they are evaluated: those setting a parameter, then those adding to it,
+    // then those multiplying it (each in the order they are listed in).
+
+    std::stable_sort(bindings.begin(), bindings.end(), [] (const MappingBinding & one, const MappingBinding & other) {
+        return one.operation < other.operation;
+    });
+
+    bindings_.swap(bindings);
+    is_compiled_ = false;
+
+    uses_pitch_classes_ = false;
+
+    for (const MappingBinding & binding : bindings_) {
+        uses_pitch_classes_ = uses_pitch_classes_ || binding.feature == MAPPING_FEATURE_PITCH_CLASS;
+    }
+
+    return true;
+
+}
+
+/**
+ * Reads the bindings from a parsed configuration.
+ */
+bool MappingEngine::readBindings(const JsonValue & configuration, std::vector<MappingBinding> & bindings,
+                                 std::string & error) {
+
+    const JsonValue & mappings = configuration["mappings"];
+
+    if (!mappings.is(JsonValue::TYPE_ARRAY)) {
+
+        error = "expected an array of \"mappings\"";
+
+        return false;
+    }
+
+    for (int index = 0; index < mappings.size(); index++) {
+
+        const JsonValue & mapping = mappings[index];
+
+        std::ostringstream where;
+        where << "mapping " << index + 1 << ": ";
+
+        if (!mapping.is(JsonValue::TYPE_OBJECT)) {
+
+            error = where.str() + "expected an object";
+
+            return false;
+        }
+
+        MappingBinding binding;
+
+        int feature = findName(kFeatureNames, mapping["feature"].asString(""));
+        int parameter = findName(kParameterNames, mapping["parameter"].asString(""));
+        int curve = findName(kCurveNames, mapping["curve"].asString("linear"));
+        int operation = findName(kOperationNames, mapping["operation"].asString("set"));
+
+        if (feature < 0) {
+
+            error = where.str() + "unknown feature \"" + mapping["feature"].asString("") + "\"";
+
+            return false;
+        }
+
+        if (parameter < 0) {
+
+            error = where.str() + "unknown parameter \"" + mapping["parameter"].asString("") + "\"";
+
+            return false;
+        }
+
+        if (curve < 0 || operation < 0) {
+
+            error = where.str() + "unknown curve or operation";
+
+            return false;
+        }
+
+        binding.feature = (MappingFeature) feature;
+        binding.parameter = (VisualParameter) parameter;
+        binding.curve = (MappingCurve) curve;
+        binding.operation = (MappingOperation) operation;
+
+        binding.frequency = mapping["frequency"].asNumber(-1);
+        binding.pitch_class = (int) mapping["pitch_class"].asNumber(-1);
+        binding.feature_index = -1;
+
+        if (binding.feature == MAPPING_FEATURE_BAND_ENERGY && binding.frequency < 0) {
+
+            error = where.str() + "a band needs a \"frequency\"";
+
+            return false;
+        }
+
+        if (binding.feature == MAPPING_FEATURE_PITCH_CLASS && (binding.pitch_class < 0 || binding.pitch_class > 11)) {
+
+            error = where.str() + "a pitch class needs a \"pitch_class\" in [0, 11]";
+
+            return false;
+        }
+
+        if (!readRange(mapping["input"], binding.input_minimum, binding.input_maximum) ||
+            !readRange(mapping["output"], binding.output_minimum, binding.output_maximum)) {
+
+            error = where.str() + "expected \"input\" and \"output\" ranges ([minimum, maximum])";
+
+            return false;
+        }
+
+        if (binding.input_minimum == binding.input_maximum) {
+
+            error = where.str() + "the input range is empty";
+
+            return false;
+        }
+
+        binding.exponent = mapping["exponent"].asNumber(2);
+        binding.is_clamped = mapping["clamp"].asBool(true);
+        binding.attack_seconds = mapping["attack"].asNumber(0);
+        binding.release_seconds = mapping["release"].asNumber(0);
+        binding.smoothed_value = 0;
+
+        bindings.push_back(binding);
+    }
+
+    return true;
+
+}
+
+/**
+ * Compiles the bindings for the bands.
+ */
+void MappingEngine::compile(const BandAggregator & band_aggregator, int number_of_bins, int sample_rate) {
+
+    for (MappingBinding & binding : bindings_) {
+
+        if (binding.feature == MAPPING_FEATURE_BAND_ENERGY) {
+            binding.feature_index = band_aggregator.getBandIndex(binding.frequency);
+        } else if (binding.feature == MAPPING_FEATURE_PITCH_CLASS) {
+            binding.feature_index = binding.pitch_class;
+        }
+    }
+
+    // Work out the pitch class of each bin (bin k being centered on k * bin_width) in the range counted,
+    // where A4 is 440 Hz, and C is pitch class 0.
+
+    bin_pitch_classes_.assign(number_of_bins, -1);
+
+    if (uses_pitch_classes_ && sample_rate > 0) {
+
+        float bin_width = sample_rate / (2.0f * number_of_bins);
+
+        for (int bin = 1; bin < number_of_bins; bin++) {
+
+            float frequency = bin * bin_width;
+
+            if (frequency >= kLowestPitchClassFrequency && frequency <= kHighestPitchClassFrequency) {
+
+                int semitones_from_a = (int) lround(12 * log2(frequency / 440.0f));
+                bin_pitch_classes_[bin] = ((semitones_from_a + 9) % 12 + 12) % 12;
+            }
+        }
+    }
+
+    is_compiled_ = true;
+
+}
+
+/**
+ * Getter for whether the bindings have been compiled since they were (last) loaded.
+ */
+bool MappingEngine::isCompiled() const {
+
+    return is_compiled_;
+
+}
+
+/**
+ * Evaluates the bindings, combining the mapped features into the visual parameters.
+ */
+void MappingEngine::evaluate(const MappingFeatures & features, float delta_seconds, float * parameters) {
+
+    if (!is_compiled_) {
+        return;
+    }
+
+    // The beat is an impulse on the frame a new beat is heard in (which a binding's release spreads out).
+
+    bool is_new_beat = features.beat_state.beat_count != last_beat_count_;
+    last_beat_count_ = features.beat_state.beat_count;
+
+    // Fold the spectrum into the pitch classes, relative to the strongest one (as a harmonic pitch class
+    // profile is), if any binding reads them.
+
+    if (uses_pitch_classes_) {
+
+        std::fill(pitch_class_values_, pitch_class_values_ + 12, 0.0f);
+
+        int number_of_bins = std::min(features.number_of_bins, (int) bin_pitch_classes_.size());
+
+        for (int bin = 0; bin < number_of_bins; bin++) {
+
+            if (bin_pitch_classes_[bin] >= 0) {
+                pitch_class_values_[bin_pitch_classes_[bin]] += features.bin_values[bin];
+            }
+        }
+
+        float maximum = *std::max_element(pitch_class_values_, pitch_class_values_ + 12);
+
+        for (int pitch_class = 0; pitch_class < 12; pitch_class++) {
+            pitch_class_values_[pitch_class] = (maximum > 0) ? pitch_class_values_[pitch_class] / maximum : 0;
+        }
+    }
+
+    delta_seconds = std::max(delta_seconds, 0.0f);
+
+    for (MappingBinding & binding : bindings_) {
+
+        float value = 0;
+
+        switch (binding.feature) {
+            case MAPPING_FEATURE_RMS:
+                value = features.rms;
+                break;
+            case MAPPING_FEATURE_BAND_ENERGY:
+                value = (binding.feature_index >= 0 && binding.feature_index < features.number_of_bands)
+                        ? features.band_values[binding.feature_index] : 0;
+                break;
+            case MAPPING_FEATURE_PITCH_CLASS:
+                value = pitch_class_values_[binding.feature_index];
+                break;
+            case MAPPING_FEATURE_BEAT:
+                value = is_new_beat ? 1 : 0;
+                break;
+            case MAPPING_FEATURE_BEAT_PHASE:
+                value = features.beat_state.beat_phase;
+                break;
+            case MAPPING_FEATURE_TEMPO:
+                value = features.beat_state.bpm;
+                break;
+            case MAPPING_FEATURE_ONSET_STRENGTH:
+                value = features.beat_state.onset_strength;
+                break;
+        }
+
+        if (binding.feature == MAPPING_FEATURE_TEMPO && value <= 0) {
+
+            // The tempo is not known yet: leave the parameter as it is.
+
+            continue;
+        }
+
+        // Normalize the feature to its input range, and put it through the curve.
+        // (The curves are mirrored below 0, for unclamped features.)
+
+        float normalized = (value - binding.input_minimum) / (binding.input_maximum - binding.input_minimum);
+
+        if (binding.is_clamped) {
+            normalized = ofClamp(normalized, 0, 1);
+        }
+
+        float magnitude = fabs(normalized);
+
+        switch (binding.curve) {
+            case MAPPING_CURVE_LINEAR:
+                break;
+            case MAPPING_CURVE_POWER:
+                magnitude = pow(magnitude, binding.exponent);
+                break;
+            case MAPPING_CURVE_LOGARITHMIC:
+                magnitude = log10(1 + 9 * magnitude);
+                break;
+            case MAPPING_CURVE_SMOOTHSTEP:
+                magnitude = std::min(magnitude, 1.0f);
+                magnitude = magnitude * magnitude * (3 - 2 * magnitude);
+                break;
+        }
+
+        normalized = (normalized < 0) ? - magnitude : magnitude;
+
+        // Follow the mapped value with the binding's attack (as it rises) and release (as it falls).
+
+        float retention = getRetention((normalized > binding.smoothed_value) ? binding.attack_seconds
+                                                                             : binding.release_seconds, delta_seconds);
+
+        binding.smoothed_value = normalized + (binding.smoothed_value - normalized) * retention;
+
+        float mapped_value = binding.output_minimum +
+                             binding.smoothed_value * (binding.output_maximum - binding.output_minimum);
+
+        float & parameter = parameters[binding.parameter];
+
+        switch (binding.operation) {
+            case MAPPING_OPERATION_SET:
+                parameter = mapped_value;
+                break;
+            case MAPPING_OPERATION_ADD:
+                parameter += mapped_value;
+                break;
+            case MAPPING_OPERATION_MULTIPLY:
+                parameter *= mapped_value;
+                break;
+        }
+    }
+
+}
+
+/**
+ * Returns the band the first band binding of a parameter reads (-1 if there is none, or it is not compiled).
+ */
+int MappingEngine::getBandIndex(VisualParameter parameter) const {
+
+    if (!is_compiled_) {
+        return -1;
+    }
+
+    for (const MappingBinding & binding : bindings_) {
+
+        if (binding.feature == MAPPING_FEATURE_BAND_ENERGY && binding.parameter == parameter) {
+            return binding.feature_index;
+        }
+    }
+
+    return -1;
+
+}
@@ -0,0 +1,207 @@
+//
+//  MappingEngine.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef MappingEngine_h
+#define MappingEngine_h
+
+#include "BandAggregator.h"
+#include "BeatTracker.h"
+#include "JsonValue.h"
+#include <string>
+#include <vector>
+
+/**
+ * The features of the sound a visual parameter can be mapped from.
+ */
+enum MappingFeature {
+    MAPPING_FEATURE_RMS, // "rms": the RMS amplitude of the sound since the last frame
+    MAPPING_FEATURE_BAND_ENERGY, // "band": the (smoothed) value of the band covering a frequency
+    MAPPING_FEATURE_PITCH_CLASS, // "pitch_class": how much of the spectrum is in a pitch class (C = 0, ..., B = 11),
+                                 // relative to the strongest pitch class
+    MAPPING_FEATURE_BEAT, // "beat": 1 on the frame of a beat, and 0 otherwise
+    MAPPING_FEATURE_BEAT_PHASE, // "beat_phase": how far into the current beat the sound is, in [0, 1)
+    MAPPING_FEATURE_TEMPO, // "tempo": the tempo, in beats per minute (a binding of it is skipped till it is known)
+    MAPPING_FEATURE_ONSET_STRENGTH // "onset": how strong the latest onset was, in [0, 1]
+};
+
+/**
+ * The visual parameters of the moving graph visualizers which can be mapped to.
+ */
+enum VisualParameter {
+    VISUAL_PARAMETER_GRAPH_RADIUS, // "graph_radius": the radius (in pixels) of the graph
+    VISUAL_PARAMETER_PARTICLE_VELOCITY, // "particle_velocity": how fast the particles move
+    VISUAL_PARAMETER_EDGE_DISTANCE, // "edge_distance": how close (in pixels) two particles are to have an edge
+    NUMBER_OF_VISUAL_PARAMETERS
+};
+
+/**
+ * The curves a feature can be mapped through (once it is normalized to its input range).
+ */
+enum MappingCurve {
+    MAPPING_CURVE_LINEAR, // "linear"
+    MAPPING_CURVE_POWER, // "power": raised to the binding's exponent
+    MAPPING_CURVE_LOGARITHMIC, // "log": log10(1 + 9x), which rises quickly, then levels off
+    MAPPING_CURVE_SMOOTHSTEP // "smoothstep": 3x^2 - 2x^3, which eases in and out
+};
+
+/**
+ * The ways a mapped value is combined into its visual parameter.
+ */
+enum MappingOperation {
+    MAPPING_OPERATION_SET, // "set": the parameter is set to the value
+    MAPPING_OPERATION_ADD, // "add": the value is added to the parameter
+    MAPPING_OPERATION_MULTIPLY // "multiply": the parameter is multiplied by the value
+};
+
+/**
+ * The features of the sound as of a frame, which the visual parameters are mapped from.
+ */
+struct MappingFeatures {
+
+    const float * band_values; // the (smoothed) value of each band
+
+    int number_of_bands; // the number of bands
+
+    const float * bin_values; // the value of each bin of the linear spectrum (for the pitch classes)
+
+    int number_of_bins; // the number of bins
+
+    float rms; // the RMS amplitude of the sound since the last frame
+
+    BeatState beat_state; // the beats of the sound
+
+};
+
+/**
+ * A binding of a feature of the sound to a visual parameter, as read from the configuration,
+ * and compiled for the current bands.
+ */
+struct MappingBinding {
+
+    MappingFeature feature; // the feature mapped from
+
+    float frequency; // the frequency (in Hz) of the band, for MAPPING_FEATURE_BAND_ENERGY
+
+    int pitch_class; // the pitch class, for MAPPING_FEATURE_PITCH_CLASS
+
+    int feature_index; // the band (or pitch class) the feature is read from, once compiled
+
+    VisualParameter parameter; // the visual parameter mapped to
+
+    MappingOperation operation; // how the mapped value is combined into the parameter
+
+    MappingCurve curve; // the curve the normalized feature is mapped through
+
+    float exponent; // the exponent, for MAPPING_CURVE_POWER
+
+    float input_minimum; // the value of the feature mapped to output_minimum
+
+    float input_maximum; // the value of the feature mapped to output_maximum
+
+    float output_minimum; // the value the parameter is mapped to at input_minimum
+
+    float output_maximum; // the value the parameter is mapped to at input_maximum
+
+    bool is_clamped; // whether the feature is clamped to its input range
+
+    float attack_seconds; // the time constant (in seconds) with which a rise of the mapped value is followed
+
+    float release_seconds; // the time constant (in seconds) with which a fall of the mapped value is followed
+
+    float smoothed_value; // the smoothed (normalized) value of the feature so far
+
+};
+
+/**
+ * Class that maps features of the sound (RMS, band energies, pitch classes and beats) to the visual parameters
+ * of the moving graph visualizers, through bindings read from a JSON configuration file, e.g.
+ *
+ *     {"mappings": [{"feature": "band", "frequency": 172, "parameter": "graph_radius",
+ *                    "input": [0.25, 3], "output": [450, 750], "curve": "linear", "release": 0.1}]}
+ *
+ * The names in the configuration are resolved when it is loaded, and the frequencies to bands when the bands
+ * are set up (compile()), so that every frame, the bindings are evaluated as a flat table of numbers: there are no
+ * string lookups (or allocations) while the visualizers run. The bindings setting a parameter are evaluated
+ * before those adding to it, and those before the ones multiplying it, whatever order they are listed in.
+ */
+class MappingEngine {
+
+    std::vector<MappingBinding> bindings_; // the bindings, in the order they are evaluated in
+
+    bool is_compiled_; // whether the bindings have been compiled for the current bands
+
+    std::vector<int> bin_pitch_classes_; // the pitch class of each bin of the spectrum (-1 if it is not counted)
+
+    float pitch_class_values_[12]; // the value of each pitch class as of the last frame
+
+    bool uses_pitch_classes_; // whether any binding is of a pitch class (so that they need to be computed)
+
+    long long last_beat_count_; // the number of beats as of the last frame
+
+    /**
+     * Reads the bindings from a parsed configuration.
+     */
+    bool readBindings(const JsonValue & configuration, std::vector<MappingBinding> & bindings, std::string & error);
+
+public:
+
+    /**
+     * Constructor for a MappingEngine object, with the default bindings (the moving graph visualizers' own:
+     * the graph radius follows the band at 172 Hz and pulses on the beats, and the particle velocity follows
+     * the band at 4300 Hz and the tempo).
+     */
+    MappingEngine() noexcept;
+
+    /**
+     * Loads the bindings from a JSON configuration file. If it cannot be read, the bindings are left as they are.
+     *
+     * @param file_path - the path of the file (relative to the data directory)
+     * @return true if the bindings were loaded, false otherwise
+     */
+    bool loadFile(const std::string & file_path);
+
+    /**
+     * Loads the bindings from the text of a JSON configuration. If it is not valid, the bindings are left as they are.
+     *
+     * @param text - the text of the configuration
+     * @param error - set to what is wrong with the configuration, if it is not valid
+     * @return true if the bindings were loaded, false otherwise
+     */
+    bool load(const std::string & text, std::string & error);
+
+    /**
+     * Compiles the bindings for the bands: the frequency of each band binding is resolved to the band covering it.
+     *
+     * @param band_aggregator - the aggregator the band values are grouped by
+     * @param number_of_bins - the number of bins of the linear spectrum
+     * @param sample_rate - the sample rate of the sound
+     */
+    void compile(const BandAggregator & band_aggregator, int number_of_bins, int sample_rate);
+
+    /**
+     * Getter for whether the bindings have been compiled since they were (last) loaded.
+     */
+    bool isCompiled() const;
+
+    /**
+     * Evaluates the bindings, combining the mapped features into the visual parameters.
+     *
+     * @param features - the features of the sound as of the frame
+     * @param delta_seconds - the time (in seconds) since the last frame
+     * @param parameters - the NUMBER_OF_VISUAL_PARAMETERS visual parameters, to be mapped (each starts out
+     *                     as the value it keeps if nothing is mapped to it)
+     */
+    void evaluate(const MappingFeatures & features, float delta_seconds, float * parameters);
+
+    /**
+     * Returns the band the first band binding of a parameter reads (-1 if there is none, or it is not compiled).
+     */
+    int getBandIndex(VisualParameter parameter) const;
+
+};
+
+#endif /* MappingEngine_h */
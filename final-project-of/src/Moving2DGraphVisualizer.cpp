@@ -8,8 +8,14 @@
 #include "Moving2DGraphVisualizer.h"
 #include <cmath>
 
-const float kSpectrumSmoothingFactor = 0.94f; // the float constant storing the smoothing factor for
-                                              // the moving graph visualizer
+const float kSpectrumReleaseSeconds = 0.27f; // the float constant storing the time (in seconds) the smoothed spectrum
+                                            // values of the moving graph visualizer take to decay by a factor of e
+                                            // (as a smoothing factor of 0.94 per frame does at 60 frames per second)
+
+const float kRestingGraphRadius = 450; // the float constant storing the graph radius when nothing is mapped to it
+
+const float kRestingParticleVelocity = 0.45f; // the float constant storing the particle velocity when nothing
+                                              // is mapped to it
 
 /**
  * The following function initializes all the resources for the
@@ -17,33 +23,37 @@ const float kSpectrumSmoothingFactor = 0.94f; // the float constant storing the
  */
 Moving2DGraphVisualizer::Moving2DGraphVisualizer() noexcept {
     
-    // Set number of bands in the spectrum to 256 (standard number of bands).
-    number_of_bands_ = 256;
+    // Start out with the default configuration (till one is applied).
     
-    // Initialize all index values in spectrum_values_vector_
-    // to zero.
+    config_ = VisualizerConfig().getMoving2DGraphConfig();
     
-    for (int index = 0; index < number_of_bands_; index++) {
-        spectrum_values_vector_.push_back(0.0);
-    }
+    // Set number of bands in the spectrum to 1024, so that even the lowest third-octave bands
+    // (about 6 Hz wide at 25 Hz) get a bin of about 21 Hz of their own, rather than one of 86 Hz.
+    number_of_bands_ = config_.number_of_bands;
     
-    // Set number of particles to 300.
-    total_number_of_particles_ = 300;
+    // The spectrum is grouped into third-octave bands by default. (Every bar, and the graph, reacts
+    // to a band the way hearing splits up the sound, rather than to a single linear bin.)
+    // The bands are set up for the sample rate with the first spectrum.
     
-    // The idea of using offsets values to get weighted Perlin Noise values
-    // is derived from explanations of Perlin Noise in
-    // https://www.safaribooksonline.com/library/view/mastering-openframeworks-creative/9781849518048/apb.html
-    //
-    // Intialize all particles' x and y positions to a random value
-    // between 0 and 2000. This uses ofRandom() function of openFrameworks.
+    band_scale_ = BAND_SCALE_THIRD_OCTAVE;
+    sample_rate_ = 0;
     
-    for (int particle_number = 0; particle_number < total_number_of_particles_; particle_number++) {
-        
-        particle_offset_x_axis_vector_.push_back(ofRandom(0, 500));
-        particle_offset_y_axis_vector_.push_back(ofRandom(0, 500));
-        particles_vector_.push_back(ofPoint());
-        
-    }
+    // The band values jump up with the sound, and decay smoothly (by time, rather than by frame).
+    
+    spectrum_smoother_.setup(SMOOTHING_MODE_DECAY, 0, kSpectrumReleaseSeconds);
+    
+    // Reserve room for as many particles as a graph may have, so that changing the number of particles
+    // (e.g. with the slider, while the song plays) never moves the particles' arrays, or allocates.
+    
+    int maximum_number_of_particles = VisualizerConfig::getMaximumNumberOfParticles();
+    
+    particle_offset_x_axis_vector_.reserve(maximum_number_of_particles);
+    particle_offset_y_axis_vector_.reserve(maximum_number_of_particles);
+    particles_vector_.reserve(maximum_number_of_particles);
+    
+    // Set number of particles to 300.
+    total_number_of_particles_ = 0;
+    setNumberOfParticles(config_.number_of_particles);
     
     // Set all particles' velocity to 0.1 intially.
     // It is best to keep this pretty small as,
@@ -51,24 +61,26 @@ Moving2DGraphVisualizer::Moving2DGraphVisualizer() noexcept {
     
     particle_velocity_ = 0.1;
     
-    // Set the index of the spectrum band which decides changes in particle velocity to 50.
+    // Set the index of the spectrum band which decides changes in particle velocity to the band of 4300 Hz.
+    // (It is worked out, from the mappings, once the bands are set up.)
     // Since this one of the higher frequencies, it is expected that this will NOT change often in a song,
     // changing only at a fewmoments during the visualization. Usually, these changes are not very prominent.
     // In a moving graph visualization, changing radius often is required more than chaging particles' velocity.
     
-    band_index_for_particle_velocity_ = 50;
+    band_index_for_particle_velocity_ = 0;
     
     // Set the moving graph's radius to 500 initially.
     // This changes with the changing spectrum value.
     
     graph_radius_ = 500;
     
-    // Set the index of the spectrum band which decides changes in graph radius to 2.
+    // Set the index of the spectrum band which decides changes in graph radius to the band of 172 Hz.
+    // (It is worked out, from the mappings, once the bands are set up.)
     // Since this one of the lower frequencies, it is expected that this will change often in a song,
     // and create an effect where the graph becomes bigger as sound becomes
     // "louder" or "faster" (in a colloquial sense).
     
-    band_index_for_graph_radius_ = 2;
+    band_index_for_graph_radius_ = 0;
     
     // Set the current time parameter to zero intially.
     // This will be changed in each update to reflect the last time at which the music was visualized.
@@ -79,7 +91,8 @@ Moving2DGraphVisualizer::Moving2DGraphVisualizer() noexcept {
     
     // Set the threshold distance for which two points are classified to be close, as 40.
     
-    threshold_distance_ = 40;
+    threshold_distance_ = config_.edge_distance;
+    edge_distance_ = threshold_distance_;
     
 }
 
@@ -89,32 +102,42 @@ Moving2DGraphVisualizer::Moving2DGraphVisualizer() noexcept {
  *
  * @param new_spectrum_values - the updated spectrum values which
  *                              spectrum_values_array_ must be updated with
+ * @param sample_rate - the sample rate of the sound the spectrum values are of
+ * @param beat_state - the beats of the sound, as of the spectrum values (the graph pulses
+ *                     out on every beat, and its particles move faster the faster the tempo)
+ * @param rms - the RMS amplitude of the sound since the last update
+ * @param clock_seconds - the time of the sound the spectrum values are of
+ *                        (the time of the playback clock, in seconds)
  */
-void Moving2DGraphVisualizer::update(float * new_spectrum_values) {
+void Moving2DGraphVisualizer::update(float * new_spectrum_values, int sample_rate, const BeatState & beat_state,
+                                     float rms, double clock_seconds) {
     
-    // Update the values in spectrum_values_array_
-    // to reflect the new spectrum band values.
+    // Set the bands up for the sample rate (and scale, and number of bands), if they have changed.
+    // The smoothed values start over from zero, and the mappings are compiled for the new bands
+    // (as they are when new mappings are loaded).
     
-    for (int index = 0; index < number_of_bands_; index++) {
+    if (band_aggregator_.getScale() != band_scale_ || sample_rate != sample_rate_ ||
+        band_aggregator_.getNumberOfBins() != number_of_bands_) {
         
-        // The idea of spectrum smoothing to get visually pleasing effects is derived from
-        // https://forum.openframeworks.cc/t/how-can-i-get-signal-from-audio-interface/21700/4
-        //
-        // First, the old spectrum values are multiplied by a factor of 0.96.
-        // Then, the new value is set to max(modified old value, new value).
-        // This is done to "smooth" out the values.
-        // Sounds change way too rapidly to be visually pleasing in its raw form.
-        // Such a smoothing ensures visualizations will appear smooth and visually appealing.
+        sample_rate_ = sample_rate;
+        band_aggregator_.setup(band_scale_, number_of_bands_, sample_rate_);
         
-        spectrum_values_vector_[index] *= kSpectrumSmoothingFactor;
-        spectrum_values_vector_[index] = max(spectrum_values_vector_[index], new_spectrum_values[index]);
+        spectrum_values_vector_.assign(band_aggregator_.getNumberOfBands(), 0.0);
+        spectrum_smoother_.reset();
         
+        compileMappings();
+        
+    } else if (!mapping_engine_.isCompiled()) {
+        
+        compileMappings();
     }
     
-    // Update the current_time_ with the current time,
+    // Update the current_time_ with the time of the sound,
     // and compute the change in time since last drawing of the visualization.
+    // (The time is that of the playback clock rather than the wall clock, so that the particles
+    // move with the sound, however long the visualization runs.)
     
-    float new_current_time = ofGetElapsedTimef();
+    double new_current_time = clock_seconds;
     float delta_time = new_current_time - current_time_;
     delta_time = ofClamp(delta_time, 0.0, 0.15); // ofClamp restricts delta (time) values to [0.0, 0.1).
                                                 // (Usage of clamp in various places helps "control" the visualization
@@ -123,24 +146,45 @@ void Moving2DGraphVisualizer::update(float * new_spectrum_values) {
     
     delta_time_ = delta_time;
     
-    // Using a similar approach to what is shown above,
-    // calculate the particle velocity.
+    // Group the linear spectrum into bands.
     
-    particle_velocity_ =
-            ofMap(spectrum_values_vector_[band_index_for_particle_velocity_], 0, 0.1, 0.45, 0.75);
+    band_aggregator_.aggregate(new_spectrum_values, band_values_vector_);
     
-    
-    // The below line finds a value for the graph_radius within the desired range by
-    // reading its value and its proportionality with the input range. The boolean parameter
-    // is a clamp ensuring values are restricted to the specified output range.
-    // From the openFrameworks documentation, ofMap() linearly maps the
-    // given value to a new value given an input and output range
+    // Update the values in spectrum_values_array_
+    // to reflect the new spectrum band values.
+    //
+    // The idea of spectrum smoothing to get visually pleasing effects is derived from
+    // https://forum.openframeworks.cc/t/how-can-i-get-signal-from-audio-interface/21700/4
     //
-    // Example: if the spectrum_value_array_[desired_index] value is 2, it is mid-way (50 %)
-    // between 1 and 3. The output is thereforce mid-way between 400 and 800, i.e. 600.
+    // First, the old spectrum values decay (by as much as the time since the last update calls for).
+    // Then, the new value is set to max(modified old value, new value).
+    // This is done to "smooth" out the values.
+    // Sounds change way too rapidly to be visually pleasing in its raw form.
+    // Such a smoothing ensures visualizations will appear smooth and visually appealing.
+    
+    const std::vector<float> & smoothed_values = spectrum_smoother_.process(band_values_vector_.data(),
+                                                                            band_values_vector_.size(), delta_time);
     
-    graph_radius_ =
-            ofMap(spectrum_values_vector_[band_index_for_graph_radius_], 0.25, 3, 450, 750, true);
+    spectrum_values_vector_.assign(smoothed_values.begin(), smoothed_values.end());
+    
+    // Map the features of the sound to the graph radius, particle velocity and edge distance,
+    // as the mappings say (by default, the graph radius follows the band of 172 Hz and pulses out on every beat,
+    // and the particle velocity follows the band of 4300 Hz and the tempo). What is not mapped to
+    // is left at its resting value (the edge distance, at the one set in the GUI).
+    
+    MappingFeatures features = {spectrum_values_vector_.data(), (int) spectrum_values_vector_.size(),
+                                new_spectrum_values, number_of_bands_, rms, beat_state};
+    
+    float parameters[NUMBER_OF_VISUAL_PARAMETERS];
+    parameters[VISUAL_PARAMETER_GRAPH_RADIUS] = kRestingGraphRadius;
+    parameters[VISUAL_PARAMETER_PARTICLE_VELOCITY] = kRestingParticleVelocity;
+    parameters[VISUAL_PARAMETER_EDGE_DISTANCE] = threshold_distance_;
+    
+    mapping_engine_.evaluate(features, delta_time, parameters);
+    
+    graph_radius_ = parameters[VISUAL_PARAMETER_GRAPH_RADIUS];
+    particle_velocity_ = parameters[VISUAL_PARAMETER_PARTICLE_VELOCITY];
+    edge_distance_ = parameters[VISUAL_PARAMETER_EDGE_DISTANCE];
     
     // For each particle,
     // compute its news x and y coordinates (its position).
@@ -166,115 +210,123 @@ void Moving2DGraphVisualizer::update(float * new_spectrum_values) {
 }
 
 /**
- * The following function is responsible for drawing
+ * The following function is responsible for computing
  * the moving graph and associated
- * equalizer bars.
+ * equalizer bars to be drawn.
+ *
+ * @param frame - the frame to fill in with the primitives to be drawn
+ * @param window_width - the width of the window the frame is drawn to
+ * @param window_height - the height of the window the frame is drawn to
  */
-void Moving2DGraphVisualizer::draw() {
+void Moving2DGraphVisualizer::computeFrame(VisualizerFrame & frame, int window_width, int window_height) {
     
     // NOTE: The values for drawing various objects are tuned for
     // a 1024 x 768 pixels window.
     
-    // Save the current coordinate system, so that it can be restored later.
-    ofPushMatrix();
+    frame.reset(window_width, window_height);
     
     // Translate (0,0) to the center of the application window.
     // This allows us to draw the moving graph in the center of the screen.
     
-    ofTranslate(ofGetWidth() / 2, ofGetHeight() / 2);
+    FrameLayer & graph_layer = frame.addLayer(window_width / 2, window_height / 2);
     
     // Draw a few concentric circles of decreasing intensity of a light purple colour.
+    // (The last circle has an alpha of 0.5, which is truncated to 0, exactly as ofSetColor() does.)
     
-    ofSetColor(123, 104, 238, 20);
-    ofDrawCircle(0, 0, (graph_radius_ - 250));
-    
-    ofSetColor(123, 104, 238, 17);
-    ofDrawCircle(0, 0, (graph_radius_ - 200));
-    
-    ofSetColor(123, 104, 238, 14);
-    ofDrawCircle(0, 0, (graph_radius_ - 150));
+    const int number_of_concentric_circles = 8;
+    const unsigned char concentric_circle_alphas[number_of_concentric_circles] = {20, 17, 14, 11, 8, 5, 2, 0};
     
-    ofSetColor(123, 104, 238, 11);
-    ofDrawCircle(0, 0, (graph_radius_ - 100));
-    
-    ofSetColor(123, 104, 238, 8);
-    ofDrawCircle(0, 0, (graph_radius_ - 50));
-    
-    ofSetColor(123, 104, 238, 5);
-    ofDrawCircle(0, 0, (graph_radius_));
-    
-    ofSetColor(123, 104, 238, 2);
-    ofDrawCircle(0, 0, (graph_radius_ + 50));
-    
-    ofSetColor(123, 104, 238, 0.5);
-    ofDrawCircle(0, 0, (graph_radius_ + 100));
+    for (int circle_number = 0; circle_number < number_of_concentric_circles; circle_number++) {
+        
+        FrameCircle circle = {0, 0, 0, graph_radius_ - 250 + circle_number * 50,
+                              {config_.circle_color.r, config_.circle_color.g, config_.circle_color.b,
+                               concentric_circle_alphas[circle_number]}};
+        graph_layer.circles.push_back(circle);
+        
+    }
     
     // For each particle,
     // draw a circle with a random colour at the specified position.
     
     for (int particleNumber = 0; particleNumber < total_number_of_particles_; particleNumber++) {
         
-        ofSetColor(ofRandom(255), ofRandom(255), ofRandom(255));
-        ofFill();
-        ofDrawCircle(particles_vector_[particleNumber], 3);
+        FrameCircle circle = {particles_vector_[particleNumber].x, particles_vector_[particleNumber].y, 0, 3,
+                              {(unsigned char) ofRandom(255), (unsigned char) ofRandom(255),
+                               (unsigned char) ofRandom(255), 255}};
+        graph_layer.circles.push_back(circle);
         
     }
     
-    // The below value is the threshold parameter for classifying the distance between two points
-    // as "close".
+    // The edge_distance_ (the threshold_distance_, unless it is mapped to) is the parameter for classifying
+    // the distance between two points as "close".
     // (If the distance between two points is close, an edge of a random colour will be drawn between them.)
     
     // For all the particles,
     // if any two particles are close to each other,
     // draw an edge of a random colour between them.
-    // (TODO: Visualization Mode can be switched to draw triangles instead.
-    // It will result in an entirely different visualization.)
+    // In the second visualization mode, a triangle is drawn instead.
     
     for (int index_one = 0; index_one < total_number_of_particles_; index_one++) {
         for (int index_two = index_one + 1; index_two < total_number_of_particles_; index_two++) {
             if (ofDist(particles_vector_[index_one].x, particles_vector_[index_one].y,
                        particles_vector_[index_two].x, particles_vector_[index_two].y)
-                < threshold_distance_) {
+                < edge_distance_) {
                 
                 // Set a random colour.
                 
-                ofSetColor(rand() % 255, rand() % 255, rand() % 255);
+                FrameColor color = {(unsigned char) (rand() % 255), (unsigned char) (rand() % 255),
+                                    (unsigned char) (rand() % 255), 255};
+                
+                const ofPoint & point_one = particles_vector_[index_one];
+                const ofPoint & point_two = particles_vector_[index_two];
                 
                 if (mode == 1) {
                     
-                    ofDrawLine(particles_vector_[index_one], particles_vector_[index_two]); // First Visualization Mode
+                    // First Visualization Mode
+                    
+                    FrameLine line = {point_one.x, point_one.y, 0, point_two.x, point_two.y, 0, color};
+                    graph_layer.lines.push_back(line);
                     
                 } else {
                     
-                    ofDrawTriangle(particles_vector_[index_one], particles_vector_[index_two], particles_vector_[index_one + 1]);
                     // Second Visualization Mode
                     
+                    const ofPoint & point_three = particles_vector_[index_one + 1];
+                    
+                    FrameTriangle triangle = {point_one.x, point_one.y, point_two.x, point_two.y,
+                                              point_three.x, point_three.y, color};
+                    graph_layer.triangles.push_back(triangle);
+                    
                 }
                 
             }
         }
     }
     
-    // Revert the translated coordinate system to the original system.
+    // The equalizer bars are drawn in the original coordinate system. (0,0) is at the upper left corner.
     
-    ofPopMatrix();
-    
-    // The coordinate system is now restored. (0,0) is at the upper left corner.
+    FrameLayer & bars_layer = frame.addLayer(0, 0);
     
     // For each band within the spectrum,
     // display the value with a rectangle.
     // (This results in the formation of the equalizer bars.)
     //
-    // The complicated expression for number of bars to be displayed is just based on what looks nicest. Also,
-    // higher indexed bars frequencies generally don't arise so it is alright to omit them.
+    // The bars are spread over the width of the window (less a margin of 20 pixels on either side, by default),
+    // each taking up 4/7 of its slot, as the bars of 4 pixels every 7 pixels used to.
+    
+    int number_of_bars = spectrum_values_vector_.size();
     
-    for (int bandNumber = 0; bandNumber < ((int) floor((ofGetWidth() - 40) / 7)); bandNumber++) {
+    float bar_spacing = (window_width - 2 * config_.bar_margin) / std::max(number_of_bars, 1);
+    float bar_width = bar_spacing * 4 / 7;
+    
+    for (int bandNumber = 0; bandNumber < number_of_bars; bandNumber++) {
         
-        // ofSetColor(128, 128, 128); // Gray color
-        ofSetColor(209, 38, 48, 100);
+        // Add the rectangle for the band with the specified colour.
         
-        // Draw the rectangle for the band with the specified colour.
-        ofDrawRectangle(20 + bandNumber * 7, ofGetHeight() - 75, 4, - spectrum_values_vector_[bandNumber] * 250);
+        FrameRectangle bar = {config_.bar_margin + bandNumber * bar_spacing, window_height - config_.bar_bottom,
+                              bar_width, - spectrum_values_vector_[bandNumber] * config_.bar_height,
+                              config_.bar_color};
+        bars_layer.rectangles.push_back(bar);
         
     }
     
@@ -299,6 +351,106 @@ void Moving2DGraphVisualizer::updateThresholdDistanceValue(float new_value) {
     
 }
 
+/**
+ * The following function is responsible for loading
+ * the mappings of the features of the sound to the visual parameters.
+ */
+bool Moving2DGraphVisualizer::loadMappings(const std::string & file_path) {
+    
+    // The mappings are compiled for the bands with the next spectrum.
+    
+    return mapping_engine_.loadFile(file_path);
+    
+}
+
+/**
+ * The following function compiles the mappings for the current bands,
+ * and looks up the bands the graph reacts to (whose bars are highlighted).
+ */
+void Moving2DGraphVisualizer::compileMappings() {
+    
+    mapping_engine_.compile(band_aggregator_, number_of_bands_, sample_rate_);
+    
+    band_index_for_graph_radius_ = mapping_engine_.getBandIndex(VISUAL_PARAMETER_GRAPH_RADIUS);
+    band_index_for_particle_velocity_ = mapping_engine_.getBandIndex(VISUAL_PARAMETER_PARTICLE_VELOCITY);
+    
+}
+
+/**
+ * The following function is responsible for applying
+ * a (new) configuration to the visualizer.
+ */
+void Moving2DGraphVisualizer::applyConfig(const GraphConfig & config) {
+    
+    // The threshold distance is set to the configured one (till it is changed in the GUI).
+    
+    if (config.edge_distance != config_.edge_distance) {
+        threshold_distance_ = config.edge_distance;
+    }
+    
+    config_ = config;
+    
+    // The bands are set up again (with the next spectrum) only if their number changed.
+    
+    number_of_bands_ = config_.number_of_bands;
+    
+    setNumberOfParticles(config_.number_of_particles);
+    
+}
+
+/**
+ * The following function is responsible for changing
+ * the number of particles, keeping the existing particles,
+ * and seeding any new ones.
+ */
+void Moving2DGraphVisualizer::setNumberOfParticles(int number_of_particles) {
+    
+    number_of_particles = ofClamp(number_of_particles, VisualizerConfig::getMinimumNumberOfParticles(),
+                                  VisualizerConfig::getMaximumNumberOfParticles());
+    
+    // The idea of using offsets values to get weighted Perlin Noise values
+    // is derived from explanations of Perlin Noise in
+    // https://www.safaribooksonline.com/library/view/mastering-openframeworks-creative/9781849518048/apb.html
+    //
+    // Intialize all (new) particles' x and y offsets to a random value
+    // between 0 and 500. This uses ofRandom() function of openFrameworks.
+    
+    for (int particle_number = total_number_of_particles_; particle_number < number_of_particles; particle_number++) {
+        
+        particle_offset_x_axis_vector_.push_back(ofRandom(0, 500));
+        particle_offset_y_axis_vector_.push_back(ofRandom(0, 500));
+        particles_vector_.push_back(ofPoint());
+        
+    }
+    
+    // If there are to be fewer particles, the last ones are dropped.
+    
+    particle_offset_x_axis_vector_.resize(number_of_particles);
+    particle_offset_y_axis_vector_.resize(number_of_particles);
+    particles_vector_.resize(number_of_particles);
+    
+    total_number_of_particles_ = number_of_particles;
+    
+}
+
+/**
+ * Getter for the number of particles.
+ */
+int Moving2DGraphVisualizer::getNumberOfParticles() {
+    
+    return total_number_of_particles_;
+    
+}
+
+/**
+ * Getter for the threshold distance value.
+ */
+float Moving2DGraphVisualizer::getThresholdDistanceValue() {
+    
+    return threshold_distance_;
+    
+}
+
 /**
  * The following function is responsible for updating
  * the display mode.
@@ -308,3 +460,15 @@ void Moving2DGraphVisualizer::updateDisplayMode(int new_mode) {
     mode = new_mode;
     
 }
+
+/**
+ * The following function is responsible for updating
+ * the scale of the bands (octave, third-octave or Bark).
+ */
+void Moving2DGraphVisualizer::updateBandScale(BandScale new_scale) {
+    
+    // The bands are set up again with the next spectrum.
+    
+    band_scale_ = new_scale;
+    
+}
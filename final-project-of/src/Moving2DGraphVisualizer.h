@@ -7,6 +7,12 @@
 
 #include "ofMain.h"
 #include "ofxGui.h"
+#include "VisualizerFrame.h"
+#include "BandAggregator.h"
+#include "SpectrumSmoother.h"
+#include "BeatTracker.h"
+#include "MappingEngine.h"
+#include "VisualizerConfig.h"
 #include <iostream>
 #ifndef Moving2DGraphVisualizer_h
 #define Moving2DGraphVisualizer_h
@@ -16,18 +22,28 @@ class Moving2DGraphVisualizer {
        protected:
     /* ***************** Moving Graph Visualizer resources ********************* */
     
-            int number_of_bands_;  // Number of bands in the spectrum
+            int number_of_bands_;  // Number of (linearly spaced) bands in the spectrum the visualizer is updated with
+            
+            BandAggregator band_aggregator_; // Aggregator grouping the spectrum into octave, third-octave or Bark bands
+            
+            BandScale band_scale_; // Scale of the bands the bars are drawn for (and the graph reacts to)
+            
+            int sample_rate_; // Sample rate of the sound the spectrum is of (0 till the first spectrum)
+            
+            std::vector<float> band_values_vector_; // Vector storing the aggregated band values of the last spectrum
+            
+            SpectrumSmoother spectrum_smoother_; // Smoother which smooths the band values over time
             
             std::vector<float> spectrum_values_vector_; // Vector storing
-                                                        // smoothed spectrum float values
+                                                        // smoothed band float values
             
             float graph_radius_;  // Graph radius parameter
             
             float particle_velocity_;  // Graph particle velocity parameter
             
-            int band_index_for_graph_radius_; // Band index in spectrum that affects the graph radius value
+            int band_index_for_graph_radius_; // Band index (of the aggregated bands) that affects the graph radius value
             
-            int band_index_for_particle_velocity_; // Band index in spectrum that affects the particle velocity value
+            int band_index_for_particle_velocity_; // Band index (of the aggregated bands) that affects the particle velocity value
             
             int total_number_of_particles_; // Number of graph particles
             
@@ -39,12 +55,25 @@ class Moving2DGraphVisualizer {
             
             std::vector<ofPoint> particles_vector_; // Moving graph's particles positions
             
-            float current_time_; // Current time value, used for computing delta (time)
+            double current_time_; // Current time value (of the playback clock), used for computing delta (time)
     
             float delta_time_; // stores the last updated time change
     
             float threshold_distance_;
     
+            float edge_distance_; // Distance below which two particles have an edge (the threshold distance,
+                                  // unless a feature of the sound is mapped to it)
+    
+            MappingEngine mapping_engine_; // Engine mapping the features of the sound to the graph's parameters
+    
+            GraphConfig config_; // Configuration of the graph (its bars' layout and colours, and its edges)
+    
+            /**
+             * The following function compiles the mappings for the current bands,
+             * and looks up the bands the graph reacts to (whose bars are highlighted).
+             */
+            void compileMappings();
+    
         public:
     
             int mode = 1; // display mode 1: lines, display mode 2: triangles
@@ -63,15 +92,26 @@ class Moving2DGraphVisualizer {
              *
              * @param new_spectrum_values - the updated spectrum values which
              *                              spectrum_values_array_ must be updated with
+             * @param sample_rate - the sample rate of the sound the spectrum values are of
+             * @param beat_state - the beats of the sound, as of the spectrum values (the graph pulses
+             *                     out on every beat, and its particles move faster the faster the tempo)
+             * @param rms - the RMS amplitude of the sound since the last update
+             * @param clock_seconds - the time of the sound the spectrum values are of
+             *                        (the time of the playback clock, in seconds)
              */
-            void update(float * new_spectrum_values);
+            void update(float * new_spectrum_values, int sample_rate, const BeatState & beat_state, float rms,
+                        double clock_seconds);
     
             /**
-             * The following function is responsible for drawing
+             * The following function is responsible for computing
              * the moving graph and associated
-             * equalizer bars.
+             * equalizer bars to be drawn.
+             *
+             * @param frame - the frame to fill in with the primitives to be drawn
+             * @param window_width - the width of the window the frame is drawn to
+             * @param window_height - the height of the window the frame is drawn to
              */
-            void draw();
+            void computeFrame(VisualizerFrame & frame, int window_width, int window_height);
     
             /**
              * Getter for the number of bands of the visualizer.
@@ -90,6 +130,52 @@ class Moving2DGraphVisualizer {
              */
             void updateDisplayMode(int new_mode);
     
+            /**
+             * The following function is responsible for updating
+             * the scale of the bands (octave, third-octave or Bark).
+             */
+            void updateBandScale(BandScale new_scale);
+    
+            /**
+             * The following function is responsible for loading
+             * the mappings of the features of the sound to the visual parameters
+             * from a JSON file (the default mappings are kept if it cannot be loaded).
+             *
+             * @param file_path - the path of the file (relative to the data directory)
+             * @return true if the mappings were loaded, false otherwise
+             */
+            bool loadMappings(const std::string & file_path);
+    
+            /**
+             * The following function is responsible for applying
+             * a (new) configuration to the visualizer. Only what changed is set up again:
+             * the existing particles are kept (as are their arrays, if their number did not change),
+             * and the bands are set up again with the next spectrum only if their number changed.
+             */
+            void applyConfig(const GraphConfig & config);
+    
+            /**
+             * The following function is responsible for changing
+             * the number of particles, keeping the existing particles,
+             * and seeding any new ones. (The room for the most particles a graph may have
+             * is reserved up front, so this neither moves the particles nor allocates.)
+             *
+             * @param number_of_particles - the new number of particles (clamped to
+             *                              [VisualizerConfig::getMinimumNumberOfParticles(),
+             *                              VisualizerConfig::getMaximumNumberOfParticles()])
+             */
+            void setNumberOfParticles(int number_of_particles);
+    
+            /**
+             * Getter for the number of particles.
+             */
+            int getNumberOfParticles();
+    
+            /**
+             * Getter for the threshold distance value.
+             */
+            float getThresholdDistanceValue();
+    
 };
 
 #endif /* Moving2DGraphVisualizer_h */
@@ -17,44 +17,35 @@ Moving3DGraphVisualizer::Moving3DGraphVisualizer() noexcept {
     Moving2DGraphVisualizer();
     
     // After intializing all resources of Moving (2D) graph [which will be used by the 3D graph],
-    // for each particle,]
-    // intialize z-coordinate value, z-offset value, theta value, phi value,
-    // theta-offset value and phi-offset value.
+    // reserve room for the extra values of as many particles as a graph may have (as the 2D graph does),
+    // then apply the default configuration of the 3D graph, which intializes the extra values of each particle.
     
-    for (int particle_number = 0; particle_number < total_number_of_particles_; particle_number++) {
-        
-        // Set z-coordinate to be a random number between 0 and 2000.
-        particle_offset_z_axis_vector_.push_back(ofRandom(0, 2000));
-        
-        // Set theta and phi to be random values in [0, 2PI] and [0, PI] respectively
-        
-        particle_theta_value_vector_.push_back(ofRandom(0, 2 * PI));
-        particle_phi_value_vector_.push_back(ofRandom(0, PI));
-        
-        // Set theta and phi offsets to be a random value in [0, 0.02]
-        
-        particle_theta_offset_vector_.push_back(ofRandom(0, 0.02));
-        particle_phi_offset_vector_.push_back(ofRandom(0, 0.02));
-        
-        // Assign a random colour for the particle.
-        particle_colors_.push_back(ofColor(ofRandom(255),ofRandom(255),ofRandom(255)));
-        
-    }
+    int maximum_number_of_particles = VisualizerConfig::getMaximumNumberOfParticles();
+    
+    particle_colors_.reserve(maximum_number_of_particles);
+    particle_offset_z_axis_vector_.reserve(maximum_number_of_particles);
+    particle_theta_value_vector_.reserve(maximum_number_of_particles);
+    particle_phi_value_vector_.reserve(maximum_number_of_particles);
+    particle_theta_offset_vector_.reserve(maximum_number_of_particles);
+    particle_phi_offset_vector_.reserve(maximum_number_of_particles);
+    
+    applyConfig(VisualizerConfig().getMoving3DGraphConfig());
 }
 
 /**
  * The following function updates all the extra values for
  * the moving 3D graph visualizer.
  */
-void Moving3DGraphVisualizer::update(float * new_spectrum_values) {
+void Moving3DGraphVisualizer::update(float * new_spectrum_values, int sample_rate, const BeatState & beat_state,
+                                     float rms, double clock_seconds) {
     
-    Moving2DGraphVisualizer::update(new_spectrum_values);
+    Moving2DGraphVisualizer::update(new_spectrum_values, sample_rate, beat_state, rms, clock_seconds);
     
     // After updating values which overlap with Graph (2D)
     // for all particles,
     // a new (x, y, z) position needs to be given, and theta and phi values have to be updated.
     
-    for (int particle_number; particle_number < total_number_of_particles_; particle_number++) {
+    for (int particle_number = 0; particle_number < total_number_of_particles_; particle_number++) {
         
         // Calculate the new z-offset by adding delta distance (= velocity * delta time).
         particle_offset_z_axis_vector_[particle_number] += particle_velocity_ * delta_time_;
@@ -85,110 +76,200 @@ void Moving3DGraphVisualizer::update(float * new_spectrum_values) {
 }
 
 /**
- * The following function is responsible for drawing
+ * The following function is responsible for computing
  * the 3D moving graph and associated
- * equalizer bars.
+ * equalizer bars to be drawn.
+ *
+ * @param frame - the frame to fill in with the primitives to be drawn
+ * @param window_width - the width of the window the frame is drawn to
+ * @param window_height - the height of the window the frame is drawn to
  */
-void Moving3DGraphVisualizer::draw() {
+void Moving3DGraphVisualizer::computeFrame(VisualizerFrame & frame, int window_width, int window_height) {
     
     // NOTE: The below values are tuned for a 1024 x 768 pixels window.
     
+    frame.reset(window_width, window_height);
+    
+    FrameLayer & bars_layer = frame.addLayer(0, 0);
+    
     // The below lines draw equalizer bars (rectangles) for the entire spectrum.
     //
     // For each band within the spectrum,
     // display the value with a rectangle.
     // (This results in the formation of the equalizer bars.)
+    //
+    // The bars are spread over the width of the window (less the margin, none by default), each taking up
+    // 5/7 of its slot (as the bars of 5 pixels every 7 pixels used to).
     
-    for (int bandNumber = 0; bandNumber < number_of_bands_; bandNumber++) {
+    int number_of_bars = spectrum_values_vector_.size();
+    
+    float bar_spacing = (window_width - 2 * config_.bar_margin) / std::max(number_of_bars, 1);
+    float bar_width = bar_spacing * 5 / 7;
+    
+    for (int bandNumber = 0; bandNumber < number_of_bars; bandNumber++) {
         
         // In case, the band is the index deciding changes in
         // graph radius and particle velocity,
-        // set draw colour to black.
+        // set draw colour to white.
         //
-        // Else, set draw colour to gray.
+        // Else, set draw colour to a random colour.
+        
+        FrameColor color = {255, 255, 255, 255}; // White color
         
-        if (bandNumber == band_index_for_graph_radius_
-            || bandNumber == band_index_for_particle_velocity_) {
+        if (bandNumber != band_index_for_graph_radius_
+            && bandNumber != band_index_for_particle_velocity_) {
             
-            ofSetColor(255, 255, 255); // White color
-        }
-        else {
-            ofSetColor(ofRandom(255), ofRandom(255), ofRandom(255)); // Random color
+            color = FrameColor{(unsigned char) ofRandom(255), (unsigned char) ofRandom(255),
+                               (unsigned char) ofRandom(255), 255}; // Random color
         }
         
-        // Draw the rectangle for the band with the specified colour.
+        // Add the rectangle for the band with the specified colour.
         
-        ofDrawRectangle(bandNumber * 7, 700, 5, -spectrum_values_vector_[bandNumber] * 150);
+        FrameRectangle bar = {config_.bar_margin + bandNumber * bar_spacing, window_height - config_.bar_bottom, bar_width,
+                              -spectrum_values_vector_[bandNumber] * config_.bar_height, color};
+        bars_layer.rectangles.push_back(bar);
     }
     
-    // Save the current coordinate system, so that it can be restored later.
-    ofPushMatrix();
-    
     // Translate (0,0) to the center of the application window.
     // This allows us to draw the moving graph in the center of the screen.
+    // The edges are drawn as thin as possible.
     
-    ofTranslate(ofGetWidth() / 2, ofGetHeight() / 2);
+    FrameLayer & graph_layer = frame.addLayer(window_width / 2, window_height / 2, 0.0001);
     
-    //Draw particles as circles.
+    // Draw particles as circles.
     
     // For each particle,
     // draw a circle at the specified position.
     // In this case, the circles are very small, and it is the edges that will be
     // more prominent with vibrant colours.
+    // (They take the colour of the last equalizer bar, as they did when drawn immediately after the bars.)
+    
+    FrameColor particle_color = bars_layer.rectangles.empty() ? FrameColor{255, 255, 255, 255}
+                                                              : bars_layer.rectangles.back().color;
     
     for (int particleNumber = 0; particleNumber < total_number_of_particles_; particleNumber++) {
-        ofDrawCircle(particles_vector_[particleNumber], 0.1);
+        
+        FrameCircle circle = {particles_vector_[particleNumber].x, particles_vector_[particleNumber].y,
+                              particles_vector_[particleNumber].z, 0.1, particle_color};
+        graph_layer.circles.push_back(circle);
+        
     }
     
     // The below value is the threshold parameter for classifying the distance between two points
-    // as "close".
+    // as "close" (140 pixels, unless it is configured otherwise).
     // (If the distance between two points is close, an edge of a random colour will be drawn between them.)
     
-    // TODO: Allow toggling this value.
-    
-    float threshold_distance = 140;
+    float threshold_distance = config_.edge_distance;
     
     // For all the particles,
     // if any two particles are close to each other,
-    // draw an edge of a random colour between them.
-    // (TODO: Visualization Mode can be switched to draw triangles instead.
-    // It will result in an entirely different visualization.)
+    // draw an edge between them in the colour of the first particle.
     
     for (int index_one = 0; index_one < total_number_of_particles_; index_one++) {
         for (int index_two = index_one + 1; index_two < total_number_of_particles_; index_two++) {
             
+            const ofPoint & point_one = particles_vector_[index_one];
+            const ofPoint & point_two = particles_vector_[index_two];
+            
             // Find the distance between the points.
             
             float distance_between_points =
-            ofDist(particles_vector_[index_one].x, particles_vector_[index_one].y, particles_vector_[index_one].z,
-                   particles_vector_[index_two].x, particles_vector_[index_two].y, particles_vector_[index_two].z);
+            ofDist(point_one.x, point_one.y, point_one.z, point_two.x, point_two.y, point_two.z);
             
             // If it is less than the threshold distance
             
             if (distance_between_points < threshold_distance) {
                 
                 // Decide the intensity of the colour of the line.
-                float alpha = ofMap(distance_between_points, 0, 180, 150, 0);
+                float alpha = ofMap(distance_between_points, 0, config_.edge_fade_distance, 150, 0, true);
                 
-                // Draw the line with the spcified colour and intensity.
+                // Add the line with the specified colour and intensity.
                 
-                ofSetColor(particle_colors_[index_one], alpha);
-                ofSetLineWidth(0.0001);
+                const ofColor & edge_color = particle_colors_[index_one];
                 
-                ofDrawLine(particles_vector_[index_one], particles_vector_[index_two]); // First Visualization Mode
-                // ofDrawTriangle(particles[index_one], particles[index_two], particles[index_one + 1]); // Second Visualization Mode
+                FrameLine line = {point_one.x, point_one.y, point_one.z, point_two.x, point_two.y, point_two.z,
+                                  {edge_color.r, edge_color.g, edge_color.b, (unsigned char) alpha}};
+                graph_layer.lines.push_back(line);
                 
             }
         }
     }
     
-    // Revert the translated coordinate system to the original system.
-    
-    ofPopMatrix();
-    
-    // The coordinate system is now restored. (0,0) is at the upper left corner.
 }
 
 int Moving3DGraphVisualizer::getNumberOfBands() {
     return number_of_bands_;
 }
+
+/**
+ * Getter for the number of particles.
+ */
+int Moving3DGraphVisualizer::getNumberOfParticles() {
+    return total_number_of_particles_;
+}
+
+/**
+ * The following function is responsible for loading
+ * the mappings of the features of the sound to the visual parameters
+ * from a JSON file (the default mappings are kept if it cannot be loaded).
+ */
+bool Moving3DGraphVisualizer::loadMappings(const std::string & file_path) {
+    return Moving2DGraphVisualizer::loadMappings(file_path);
+}
+
+/**
+ * The following function is responsible for applying
+ * a (new) configuration to the visualizer.
+ */
+void Moving3DGraphVisualizer::applyConfig(const GraphConfig & config) {
+    
+    Moving2DGraphVisualizer::applyConfig(config);
+    setNumberOfParticles(config.number_of_particles);
+    
+}
+
+/**
+ * The following function is responsible for changing
+ * the number of particles, keeping the existing particles,
+ * and seeding any new ones.
+ */
+void Moving3DGraphVisualizer::setNumberOfParticles(int number_of_particles) {
+    
+    Moving2DGraphVisualizer::setNumberOfParticles(number_of_particles);
+    number_of_particles = total_number_of_particles_;
+    
+    // For each new particle,
+    // intialize z-coordinate value, z-offset value, theta value, phi value,
+    // theta-offset value and phi-offset value.
+    
+    for (int particle_number = particle_offset_z_axis_vector_.size(); particle_number < number_of_particles;
+         particle_number++) {
+        
+        // Set z-coordinate to be a random number between 0 and 2000.
+        particle_offset_z_axis_vector_.push_back(ofRandom(0, 2000));
+        
+        // Set theta and phi to be random values in [0, 2PI] and [0, PI] respectively
+        
+        particle_theta_value_vector_.push_back(ofRandom(0, 2 * PI));
+        particle_phi_value_vector_.push_back(ofRandom(0, PI));
+        
+        // Set theta and phi offsets to be a random value in [0, 0.02]
+        
+        particle_theta_offset_vector_.push_back(ofRandom(0, 0.02));
+        particle_phi_offset_vector_.push_back(ofRandom(0, 0.02));
+        
+        // Assign a random colour for the particle.
+        particle_colors_.push_back(ofColor(ofRandom(255),ofRandom(255),ofRandom(255)));
+        
+    }
+    
+    // If there are to be fewer particles, the last ones are dropped.
+    
+    particle_offset_z_axis_vector_.resize(number_of_particles);
+    particle_theta_value_vector_.resize(number_of_particles);
+    particle_phi_value_vector_.resize(number_of_particles);
+    particle_theta_offset_vector_.resize(number_of_particles);
+    particle_phi_offset_vector_.resize(number_of_particles);
+    particle_colors_.resize(number_of_particles);
+    
+}
@@ -43,19 +43,49 @@ class Moving3DGraphVisualizer : protected Moving2DGraphVisualizer {
          * The following function updates all the extra values for
          * the moving 3D graph visualizer.
          */
-        void update(float * new_spectrum_values);
+        void update(float * new_spectrum_values, int sample_rate, const BeatState & beat_state, float rms,
+                double clock_seconds);
     
         /**
-         * The following function is responsible for drawing
+         * The following function is responsible for computing
          * the 3D moving graph and associated
-         * equalizer bars.
+         * equalizer bars to be drawn.
+         *
+         * @param frame - the frame to fill in with the primitives to be drawn
+         * @param window_width - the width of the window the frame is drawn to
+         * @param window_height - the height of the window the frame is drawn to
          */
-        void draw();
+        void computeFrame(VisualizerFrame & frame, int window_width, int window_height);
     
         /**
          * Getter for the number of bands of the visualizer.
          */
         int getNumberOfBands();
+    
+        /**
+         * The following function is responsible for loading
+         * the mappings of the features of the sound to the visual parameters
+         * from a JSON file (the default mappings are kept if it cannot be loaded).
+         */
+        bool loadMappings(const std::string & file_path);
+    
+        /**
+         * The following function is responsible for applying
+         * a (new) configuration to the visualizer.
+         */
+        void applyConfig(const GraphConfig & config);
+    
+        /**
+         * The following function is responsible for changing
+         * the number of particles, keeping the existing particles,
+         * and seeding any new ones.
+         */
+        void setNumberOfParticles(int number_of_particles);
+    
+        /**
+         * Getter for the number of particles.
+         */
+        int getNumberOfParticles();
 
 };
 
@@ -0,0 +1,176 @@
+//
+//  PlaybackClock.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "PlaybackClock.h"
+#include "ofMain.h"
+#include <algorithm>
+
+/**
+ * Constructor for a PlaybackClock object, at time 0.
+ */
+PlaybackClock::PlaybackClock() noexcept {
+    
+    sequence_ = 0;
+    buffer_stream_frame_ = 0;
+    buffer_track_frame_ = 0;
+    buffer_number_of_frames_ = 0;
+    is_track_playing_ = false;
+    buffer_time_micros_ = 0;
+    previous_buffer_track_frame_ = 0;
+    is_previous_track_playing_ = false;
+    frames_filled_ = 0;
+    sample_rate_ = 44100;
+    latency_frames_ = 0;
+    start_seconds_ = 0;
+    stream_frame_ = 0;
+    track_frame_ = 0;
+    
+}
+
+/**
+ * Restarts the count of the stream's frames, for a stream (re)opened at the given sample rate.
+ * The time of the clock carries on from where it was.
+ */
+void PlaybackClock::reset(int sample_rate, int latency_frames) {
+    
+    sample();
+    start_seconds_ = getSeconds();
+    
+    sample_rate_ = sample_rate;
+    latency_frames_ = latency_frames;
+    
+    frames_filled_ = 0;
+    stream_frame_ = 0;
+    
+    // Till the new stream's first buffer is filled, the clock stands still at its start.
+    
+    buffer_stream_frame_ = 0;
+    buffer_number_of_frames_ = 0;
+    buffer_track_frame_ = track_frame_;
+    is_track_playing_ = false;
+    buffer_time_micros_ = ofGetElapsedTimeMicros();
+    previous_buffer_track_frame_ = track_frame_;
+    is_previous_track_playing_ = false;
+    
+}
+
+/**
+ * Records that a buffer has been filled. Called on the audio thread, for every buffer.
+ */
+void PlaybackClock::advance(long long track_frame, int number_of_frames, bool is_track_playing) {
+    
+    unsigned sequence = sequence_.load(std::memory_order_relaxed);
+    
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    previous_buffer_track_frame_.store(buffer_track_frame_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    is_previous_track_playing_.store(is_track_playing_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    
+    buffer_stream_frame_.store(frames_filled_, std::memory_order_relaxed);
+    buffer_track_frame_.store(track_frame, std::memory_order_relaxed);
+    buffer_number_of_frames_.store(number_of_frames, std::memory_order_relaxed);
+    is_track_playing_.store(is_track_playing, std::memory_order_relaxed);
+    buffer_time_micros_.store(ofGetElapsedTimeMicros(), std::memory_order_relaxed);
+    
+    sequence_.store(sequence + 2, std::memory_order_release);
+    
+    frames_filled_ += number_of_frames;
+    
+}
+
+/**
+ * Works out which frames of the stream and of the track are being heard right now,
+ * which the getters return till the clock is sampled again. Called on the main thread.
+ */
+void PlaybackClock::sample() {
+    
+    // Read a consistent copy of the newest buffers' figures (trying again if the audio thread
+    // published another buffer's meanwhile).
+    
+    long long buffer_stream_frame, buffer_track_frame, previous_buffer_track_frame;
+    int buffer_number_of_frames;
+    bool is_track_playing, is_previous_track_playing;
+    uint64_t buffer_time_micros;
+    
+    unsigned sequence;
+    
+    do {
+        
+        sequence = sequence_.load(std::memory_order_acquire);
+        
+        buffer_stream_frame = buffer_stream_frame_.load(std::memory_order_relaxed);
+        buffer_track_frame = buffer_track_frame_.load(std::memory_order_relaxed);
+        buffer_number_of_frames = buffer_number_of_frames_.load(std::memory_order_relaxed);
+        is_track_playing = is_track_playing_.load(std::memory_order_relaxed);
+        buffer_time_micros = buffer_time_micros_.load(std::memory_order_relaxed);
+        previous_buffer_track_frame = previous_buffer_track_frame_.load(std::memory_order_relaxed);
+        is_previous_track_playing = is_previous_track_playing_.load(std::memory_order_relaxed);
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        
+    } while ((sequence & 1) != 0 || sequence != sequence_.load(std::memory_order_relaxed));
+    
+    // When the newest buffer was filled, the frames queued before it were about to be played.
+    // Since then, the device has played on at the sample rate, but never past the frames filled so far.
+    
+    uint64_t now_micros = ofGetElapsedTimeMicros();
+    long long elapsed_frames = now_micros > buffer_time_micros
+                             ? (long long) ((now_micros - buffer_time_micros) * sample_rate_ / 1000000) : 0;
+    
+    long long stream_frame = buffer_stream_frame - latency_frames_
+                           + std::min(elapsed_frames, (long long) buffer_number_of_frames);
+    
+    stream_frame_ = std::max(stream_frame_, stream_frame);
+    
+    // The frame heard is in the newest buffer, or (while the buffers queued before it are played)
+    // taken to be in a run of frames which follows on from the buffer before it.
+    
+    if (stream_frame_ >= buffer_stream_frame) {
+        
+        track_frame_ = is_track_playing ? buffer_track_frame + (stream_frame_ - buffer_stream_frame)
+                                        : buffer_track_frame;
+        
+    } else {
+        
+        long long previous_buffer_stream_frame = buffer_stream_frame - buffer_number_of_frames;
+        
+        track_frame_ = is_previous_track_playing
+                     ? previous_buffer_track_frame + (stream_frame_ - previous_buffer_stream_frame)
+                     : previous_buffer_track_frame;
+    }
+    
+    track_frame_ = std::max(track_frame_, 0LL);
+    
+}
+
+/**
+ * Returns the frame of the stream being heard, as of the last sample() (which never goes back).
+ */
+long long PlaybackClock::getStreamFrame() const {
+    
+    return stream_frame_;
+    
+}
+
+/**
+ * Returns the frame of the track being heard, as of the last sample().
+ */
+long long PlaybackClock::getTrackFrame() const {
+    
+    return track_frame_;
+    
+}
+
+/**
+ * Returns the time of the clock, as of the last sample() (in seconds of audio heard since it was started).
+ */
+double PlaybackClock::getSeconds() const {
+    
+    return start_seconds_ + (double) stream_frame_ / sample_rate_;
+    
+}
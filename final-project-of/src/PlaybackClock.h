@@ -0,0 +1,108 @@
+//
+//  PlaybackClock.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef PlaybackClock_h
+#define PlaybackClock_h
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Class that models a playback clock driven by the frames actually handed to the sound device,
+ * rather than by the wall clock (which drifts from the device's clock over long sessions).
+ *
+ * The audio thread calls advance() for every buffer it fills, recording which frames of the stream
+ * (and of the track) the buffer holds, and when it was filled. The main thread samples the clock once
+ * per frame (so the frames and the time read from it all describe the same instant), working out from
+ * this which frame is being heard right now: the newest buffer starts playing once the buffers queued before
+ * it (the output latency) have been played, and is interpolated through at the sample rate from then on.
+ * The interpolation never runs past the frames filled so far, so if the device stalls, so does the clock.
+ *
+ * The newest buffer's figures are published with a sequence lock, so the audio thread never blocks.
+ */
+class PlaybackClock {
+    
+    std::atomic<unsigned> sequence_; // odd while the audio thread is publishing a buffer's figures
+    
+    std::atomic<long long> buffer_stream_frame_; // the frame of the stream the newest buffer starts at
+    
+    std::atomic<long long> buffer_track_frame_; // the frame of the track the newest buffer starts at
+    
+    std::atomic<int> buffer_number_of_frames_; // the number of frames in the newest buffer
+    
+    std::atomic<bool> is_track_playing_; // whether the newest buffer plays the track (rather than silence)
+    
+    std::atomic<uint64_t> buffer_time_micros_; // the time the newest buffer was filled (as ofGetElapsedTimeMicros())
+    
+    std::atomic<long long> previous_buffer_track_frame_; // the frame of the track the buffer before the newest starts at
+    
+    std::atomic<bool> is_previous_track_playing_; // whether the buffer before the newest plays the track
+    
+    long long frames_filled_; // the number of frames of the stream filled so far (only used by the audio thread)
+    
+    int sample_rate_; // the sample rate of the stream
+    
+    int latency_frames_; // the number of frames queued ahead of a buffer which has just been filled
+    
+    double start_seconds_; // the time of the clock when the stream was (re)opened
+    
+    long long stream_frame_; // the frame of the stream being heard, as last sampled (it never goes back)
+    
+    long long track_frame_; // the frame of the track being heard, as last sampled
+    
+public:
+    
+    /**
+     * Constructor for a PlaybackClock object, at time 0.
+     */
+    PlaybackClock() noexcept;
+    
+    /**
+     * Restarts the count of the stream's frames, for a stream (re)opened at the given sample rate.
+     * The time of the clock carries on from where it was. This must not be called while the audio thread
+     * is advancing the clock.
+     *
+     * @param sample_rate - the sample rate of the stream
+     * @param latency_frames - the number of frames the device has queued when it asks for a buffer
+     *                         (the output latency of the stream)
+     */
+    void reset(int sample_rate, int latency_frames);
+    
+    /**
+     * Records that a buffer has been filled. Called on the audio thread, for every buffer.
+     *
+     * @param track_frame - the frame of the track the buffer starts at
+     * @param number_of_frames - the number of frames in the buffer
+     * @param is_track_playing - whether the buffer plays the track (if not, the track's position is held)
+     */
+    void advance(long long track_frame, int number_of_frames, bool is_track_playing);
+    
+    /**
+     * Works out which frames of the stream and of the track are being heard right now,
+     * which the getters return till the clock is sampled again. Called on the main thread.
+     */
+    void sample();
+    
+    /**
+     * Returns the frame of the stream being heard, as of the last sample() (which never goes back).
+     */
+    long long getStreamFrame() const;
+    
+    /**
+     * Returns the frame of the track being heard, as of the last sample() (which goes back if the track
+     * is sought, or restarted, once that is heard).
+     */
+    long long getTrackFrame() const;
+    
+    /**
+     * Returns the time of the clock, as of the last sample() (in seconds of audio heard since it was started).
+     */
+    double getSeconds() const;
+    
+};
+
+#endif /* PlaybackClock_h */
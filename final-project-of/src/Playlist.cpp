@@ -0,0 +1,394 @@
+//
+//  Playlist.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "Playlist.h"
+
+const int kDefaultPrefetchCount = 2; // the default number of songs which are decoded ahead of time
+
+const size_t kDefaultMemoryBudget = 512 * 1024 * 1024; // the default number of bytes the prefetched songs may take up
+
+/**
+ * Constructor for an (empty) Playlist object, which does not start the prefetch thread yet.
+ */
+Playlist::Playlist() noexcept {
+    
+    current_index_ = 0;
+    prefetch_count_ = kDefaultPrefetchCount;
+    memory_budget_ = kDefaultMemoryBudget;
+    is_running_ = false;
+    
+}
+
+/**
+ * Destructor, which stops the prefetch thread.
+ */
+Playlist::~Playlist() {
+    
+    stop();
+    
+}
+
+/**
+ * Fills the playlist with the .mp3 and .wav files in the given directory (relative to the data directory),
+ * in alphabetical order.
+ *
+ * @return whether any songs were found
+ */
+bool Playlist::loadDirectory(const std::string & directory_path) {
+    
+    ofDirectory directory(directory_path);
+    
+    directory.allowExt("mp3");
+    directory.allowExt("wav");
+    directory.listDir();
+    directory.sort();
+    
+    paths_.clear();
+    
+    for (size_t index = 0; index < directory.size(); index++) {
+        
+        std::string name = directory.getName(index);
+        paths_.push_back(directory_path.empty() ? name : ofFilePath::join(directory_path, name));
+    }
+    
+    if (paths_.empty()) {
+        ofLogError("Playlist") << "No songs found in " << directory_path;
+    }
+    
+    current_index_ = 0;
+    
+    return !paths_.empty();
+    
+}
+
+/**
+ * Fills the playlist with the songs listed in the given .m3u file (relative to the data directory).
+ * Relative paths in the file are relative to the directory the file is in.
+ *
+ * @return whether any songs were found
+ */
+bool Playlist::loadM3u(const std::string & m3u_path) {
+    
+    ofFile m3u_file(m3u_path);
+    
+    if (!m3u_file.exists()) {
+        
+        ofLogError("Playlist") << "Could not find " << m3u_path;
+        return false;
+        
+    }
+    
+    std::string m3u_directory = ofFilePath::getEnclosingDirectory(m3u_path, false);
+    std::vector<std::string> lines = ofSplitString(ofBufferFromFile(m3u_path).getText(), "\n", true, true);
+    
+    paths_.clear();
+    
+    for (size_t index = 0; index < lines.size(); index++) {
+        
+        // Lines starting with # are comments (or extended M3U directives such as #EXTINF).
+        
+        std::string line = ofTrim(lines[index]);
+        
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        
+        paths_.push_back(ofFilePath::isAbsolute(line) || m3u_directory.empty() ? line : ofFilePath::join(m3u_directory, line));
+    }
+    
+    if (paths_.empty()) {
+        ofLogError("Playlist") << "No songs found in " << m3u_path;
+    }
+    
+    current_index_ = 0;
+    
+    return !paths_.empty();
+    
+}
+
+/**
+ * Setter for the number of songs after the current one which are decoded ahead of time.
+ */
+void Playlist::setPrefetchCount(int prefetch_count) {
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        prefetch_count_ = std::max(prefetch_count, 0);
+        skipped_indices_.clear();
+    }
+    
+    condition_.notify_all();
+    
+}
+
+/**
+ * Setter for the number of bytes the prefetched songs may take up in all.
+ */
+void Playlist::setMemoryBudget(size_t memory_budget) {
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        memory_budget_ = memory_budget;
+        skipped_indices_.clear();
+    }
+    
+    condition_.notify_all();
+    
+}
+
+/**
+ * Starts the prefetch thread.
+ */
+void Playlist::start() {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (is_running_) {
+        return;
+    }
+    
+    is_running_ = true;
+    prefetch_thread_ = std::thread(&Playlist::run, this);
+    
+}
+
+/**
+ * Stops the prefetch thread, abandoning the song being prefetched.
+ */
+void Playlist::stop() {
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_running_ = false;
+    }
+    
+    condition_.notify_all();
+    
+    if (prefetch_thread_.joinable()) {
+        prefetch_thread_.join();
+    }
+    
+}
+
+/**
+ * Returns whether the song at the given index is in the prefetch window (the songs after the current one).
+ */
+bool Playlist::isInPrefetchWindow(int index) const {
+    
+    int number_of_songs = (int) paths_.size();
+    
+    if (number_of_songs == 0) {
+        return false;
+    }
+    
+    // The distance from the current song to the given one, going forwards (and wrapping around).
+    
+    int distance = ((index - current_index_) % number_of_songs + number_of_songs) % number_of_songs;
+    
+    return distance >= 1 && distance <= prefetch_count_;
+    
+}
+
+/**
+ * Returns the index of the next song to be prefetched, or -1 if there is none.
+ */
+int Playlist::findIndexToPrefetch() const {
+    
+    int number_of_songs = (int) paths_.size();
+    
+    for (int distance = 1; distance <= prefetch_count_ && distance < number_of_songs; distance++) {
+        
+        int index = (current_index_ + distance) % number_of_songs;
+        
+        if (prefetched_tracks_.count(index) == 0 && skipped_indices_.count(index) == 0) {
+            return index;
+        }
+    }
+    
+    return -1;
+    
+}
+
+/**
+ * Returns the number of bytes the prefetched songs take up.
+ */
+size_t Playlist::getPrefetchedMemoryUsage() const {
+    
+    size_t memory_usage = 0;
+    
+    for (std::map<int, std::shared_ptr<AudioSource> >::const_iterator iterator = prefetched_tracks_.begin();
+         iterator != prefetched_tracks_.end(); ++iterator) {
+        
+        memory_usage += iterator->second->getMemoryUsage();
+    }
+    
+    return memory_usage;
+    
+}
+
+/**
+ * The function run by the prefetch thread.
+ */
+void Playlist::run() {
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    
+    while (true) {
+        
+        // Sleep till there is a song in the prefetch window to be decoded (or the playlist is stopped).
+        
+        condition_.wait(lock, [this] { return !is_running_ || findIndexToPrefetch() != -1; });
+        
+        if (!is_running_) {
+            return;
+        }
+        
+        int index = findIndexToPrefetch();
+        std::string path = paths_[index];
+        
+        // A song which the decoder estimates would not fit in what is left of the memory budget is not decoded.
+        
+        size_t memory_usage = getPrefetchedMemoryUsage();
+        size_t memory_left = (memory_usage < memory_budget_) ? memory_budget_ - memory_usage : 0;
+        
+        lock.unlock();
+        
+        // Abandon the decoding if the song leaves the prefetch window (or the playlist is stopped).
+        
+        std::shared_ptr<AudioSource> track = TrackLoader::openTrack(path, [this, index] (float /* progress */) {
+            
+            std::lock_guard<std::mutex> lock(mutex_);
+            return is_running_ && isInPrefetchWindow(index);
+            
+        }, memory_left);
+        
+        lock.lock();
+        
+        if (!isInPrefetchWindow(index)) {
+            continue;
+        }
+        
+        // Keep the song if it fits in the memory budget (the estimate it was decoded by can fall short).
+        // Otherwise, it is decoded when it comes up.
+        
+        if (track && getPrefetchedMemoryUsage() + track->getMemoryUsage() <= memory_budget_) {
+            prefetched_tracks_[index] = track;
+        } else {
+            skipped_indices_.insert(index);
+        }
+    }
+    
+}
+
+/**
+ * Getter for the number of songs in the playlist.
+ */
+int Playlist::size() const {
+    
+    return (int) paths_.size();
+    
+}
+
+/**
+ * Getter for the path of the song at the given index.
+ */
+const std::string & Playlist::getPath(int index) const {
+    
+    return paths_[index];
+    
+}
+
+/**
+ * Returns the index of the song with the given path, or -1 if it is not in the playlist.
+ */
+int Playlist::findPath(const std::string & path) const {
+    
+    for (size_t index = 0; index < paths_.size(); index++) {
+        
+        if (paths_[index] == path) {
+            return (int) index;
+        }
+    }
+    
+    return -1;
+    
+}
+
+/**
+ * Getter for the index of the song being played.
+ */
+int Playlist::getCurrentIndex() {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    return current_index_;
+    
+}
+
+/**
+ * Returns the index of the song after the current one (wrapping around at the end of the playlist).
+ */
+int Playlist::getNextIndex() {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    return paths_.empty() ? 0 : (current_index_ + 1) % (int) paths_.size();
+    
+}
+
+/**
+ * Moves on to the song at the given index, which moves the prefetch window along.
+ * Prefetched songs which have left the window are handed to the given track loader,
+ * to be released on its thread (freeing a decoded song could stall a frame).
+ */
+void Playlist::setCurrentIndex(int index, TrackLoader & track_loader) {
+    
+    std::vector<std::shared_ptr<AudioSource> > released_tracks;
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        current_index_ = index;
+        skipped_indices_.clear();
+        
+        for (std::map<int, std::shared_ptr<AudioSource> >::iterator iterator = prefetched_tracks_.begin();
+             iterator != prefetched_tracks_.end(); ) {
+            
+            if (isInPrefetchWindow(iterator->first)) {
+                
+                ++iterator;
+                
+            } else {
+                
+                released_tracks.push_back(iterator->second);
+                prefetched_tracks_.erase(iterator++);
+            }
+        }
+    }
+    
+    condition_.notify_all();
+    
+    // The released songs are handed over outside the lock.
+    
+    for (int i = 0; i < (int) released_tracks.size(); i++) {
+        track_loader.release(std::move(released_tracks[i]));
+    }
+    
+}
+
+/**
+ * Returns the prefetched song at the given index, or nullptr if it has not been prefetched (yet).
+ */
+std::shared_ptr<AudioSource> Playlist::getPrefetchedTrack(int index) {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    std::map<int, std::shared_ptr<AudioSource> >::iterator iterator = prefetched_tracks_.find(index);
+    
+    return (iterator == prefetched_tracks_.end()) ? nullptr : iterator->second;
+    
+}
@@ -0,0 +1,160 @@
+//
+//  Playlist.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef Playlist_h
+#define Playlist_h
+
+#include "AudioSource.h"
+#include "TrackLoader.h"
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Class that models a playlist of songs (read from a directory or an .m3u file), and decodes the
+ * next few songs after the current one ahead of time on a prefetch thread, so that moving on to
+ * the next song never waits for it to be decoded.
+ *
+ * The prefetched songs are kept within a memory budget: a song which would not fit (going by the size
+ * its decoder estimates, before it is decoded) is not prefetched (it is then decoded when it comes up,
+ * as any other song is).
+ */
+class Playlist {
+    
+    std::vector<std::string> paths_; // the paths of the songs in the playlist
+    
+    int current_index_; // the index of the song being played
+    
+    int prefetch_count_; // the number of songs after the current one which are decoded ahead of time
+    
+    size_t memory_budget_; // the number of bytes the prefetched songs may take up in all
+    
+    std::map<int, std::shared_ptr<AudioSource> > prefetched_tracks_; // the prefetched songs, by index
+    
+    std::set<int> skipped_indices_; // the songs in the prefetch window which could not be (or did not fit to be) prefetched
+    
+    std::thread prefetch_thread_; // the thread which decodes the songs ahead of time
+    
+    std::mutex mutex_; // the mutex guarding all the above state (after the paths are read)
+    
+    std::condition_variable condition_; // signalled when the prefetch window moves, or the thread is to stop
+    
+    bool is_running_; // whether the prefetch thread should keep running
+    
+    /**
+     * Returns whether the song at the given index is in the prefetch window (the songs after the current one).
+     */
+    bool isInPrefetchWindow(int index) const;
+    
+    /**
+     * Returns the index of the next song to be prefetched, or -1 if there is none.
+     */
+    int findIndexToPrefetch() const;
+    
+    /**
+     * Returns the number of bytes the prefetched songs take up.
+     */
+    size_t getPrefetchedMemoryUsage() const;
+    
+    /**
+     * The function run by the prefetch thread.
+     */
+    void run();
+    
+public:
+    
+    /**
+     * Constructor for an (empty) Playlist object, which does not start the prefetch thread yet.
+     */
+    Playlist() noexcept;
+    
+    /**
+     * Destructor, which stops the prefetch thread.
+     */
+    ~Playlist();
+    
+    /**
+     * Fills the playlist with the .mp3 and .wav files in the given directory (relative to the data directory),
+     * in alphabetical order.
+     *
+     * @return whether any songs were found
+     */
+    bool loadDirectory(const std::string & directory_path);
+    
+    /**
+     * Fills the playlist with the songs listed in the given .m3u file (relative to the data directory).
+     * Relative paths in the file are relative to the directory the file is in.
+     *
+     * @return whether any songs were found
+     */
+    bool loadM3u(const std::string & m3u_path);
+    
+    /**
+     * Setter for the number of songs after the current one which are decoded ahead of time.
+     */
+    void setPrefetchCount(int prefetch_count);
+    
+    /**
+     * Setter for the number of bytes the prefetched songs may take up in all.
+     */
+    void setMemoryBudget(size_t memory_budget);
+    
+    /**
+     * Starts the prefetch thread.
+     */
+    void start();
+    
+    /**
+     * Stops the prefetch thread, abandoning the song being prefetched.
+     */
+    void stop();
+    
+    /**
+     * Getter for the number of songs in the playlist.
+     */
+    int size() const;
+    
+    /**
+     * Getter for the path of the song at the given index.
+     */
+    const std::string & getPath(int index) const;
+    
+    /**
+     * Returns the index of the song with the given path, or -1 if it is not in the playlist.
+     */
+    int findPath(const std::string & path) const;
+    
+    /**
+     * Getter for the index of the song being played.
+     */
+    int getCurrentIndex();
+    
+    /**
+     * Returns the index of the song after the current one (wrapping around at the end of the playlist).
+     */
+    int getNextIndex();
+    
+    /**
+     * Moves on to the song at the given index, which moves the prefetch window along.
+     * Prefetched songs which have left the window are handed to the given track loader,
+     * to be released on its thread (freeing a decoded song could stall a frame).
+     */
+    void setCurrentIndex(int index, TrackLoader & track_loader);
+    
+    /**
+     * Returns the prefetched song at the given index, or nullptr if it has not been prefetched (yet).
+     */
+    std::shared_ptr<AudioSource> getPrefetchedTrack(int index);
+    
+};
+
+#endif /* Playlist_h */
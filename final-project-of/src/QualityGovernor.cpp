@@ -0,0 +1,259 @@
+//
+//  QualityGovernor.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "QualityGovernor.h"
+#include "ofMain.h"
+#include <algorithm>
+
+const QualityLevel kQualityLevels[] = {{1.0, 1.0, 1, 4},    // the quality levels, from the highest (the configured
+                                       {0.7, 1.0, 2, 6},    // values) to the lowest. The graphs' work grows with
+                                       {0.5, 0.85, 4, 8},   // the square of their particles, so the first levels
+                                       {0.35, 0.7, 8, 12}}; // halve and quarter it.
+
+const int kNumberOfQualityLevels = sizeof(kQualityLevels) / sizeof(kQualityLevels[0]); // the number of quality levels
+
+const int kNumberOfFrameTimes = 60; // the number of frames the percentile is taken over (a second, at 60 FPS)
+
+const float kFrameTimePercentile = 0.95; // the percentile of the frame times which is held to the target
+
+const float kRaiseFraction = 0.6; // the fraction of the target the frames must be under for the quality to be raised
+
+const int kMinimumRaiseHoldFrames = 300; // the fewest frames the frames must be under it for (5 seconds, at 60 FPS)
+
+const int kMaximumRaiseHoldFrames = 4800; // the most frames the frames must be under it for (80 seconds, at 60 FPS)
+
+const int kMinimumNumberOfBands = 64; // the fewest bands a moving graph is drawn with (as few as it may be configured with)
+
+/**
+ * Constructor for a QualityGovernor object, which holds a frame time of 16.6 ms (60 FPS) at the highest quality.
+ */
+QualityGovernor::QualityGovernor() noexcept {
+
+    target_frame_time_ms_ = 16.6;
+    is_enabled_ = true;
+
+    frame_times_ms_.resize(kNumberOfFrameTimes);
+    sorted_frame_times_ms_.reserve(kNumberOfFrameTimes);
+    next_frame_time_index_ = 0;
+    number_of_frame_times_ = 0;
+
+    level_index_ = 0;
+    frames_since_change_ = 0;
+    frames_under_raise_fraction_ = 0;
+    was_last_change_raise_ = false;
+    raise_hold_frames_ = kMinimumRaiseHoldFrames;
+
+}
+
+/**
+ * Sets the 95th percentile frame time to hold.
+ */
+void QualityGovernor::setTargetFrameTime(float target_frame_time_ms) {
+
+    target_frame_time_ms_ = target_frame_time_ms;
+
+}
+
+/**
+ * Getter for the 95th percentile frame time held (in milliseconds).
+ */
+float QualityGovernor::getTargetFrameTime() const {
+
+    return target_frame_time_ms_;
+
+}
+
+/**
+ * Turns governing the quality on or off.
+ */
+bool QualityGovernor::setEnabled(bool is_enabled) {
+
+    is_enabled_ = is_enabled;
+
+    ofLogNotice("QualityGovernor") << "Quality governor " << (is_enabled_ ? "on" : "off");
+
+    clearFrameTimes();
+    raise_hold_frames_ = kMinimumRaiseHoldFrames;
+
+    if (!is_enabled_ && level_index_ != 0) {
+
+        changeLevel(0, "the quality governor was turned off");
+
+        return true;
+    }
+
+    return false;
+
+}
+
+/**
+ * Returns whether the quality is governed.
+ */
+bool QualityGovernor::isEnabled() const {
+
+    return is_enabled_;
+
+}
+
+/**
+ * Measures the time a frame took, and lowers or raises the quality if needed.
+ */
+bool QualityGovernor::addFrameTime(float frame_time_ms) {
+
+    frame_times_ms_[next_frame_time_index_] = frame_time_ms;
+    next_frame_time_index_ = (next_frame_time_index_ + 1) % kNumberOfFrameTimes;
+    number_of_frame_times_ = std::min(number_of_frame_times_ + 1, kNumberOfFrameTimes);
+    frames_since_change_++;
+
+    // Only judge a level by a full window of its own frames.
+
+    if (!is_enabled_ || number_of_frame_times_ < kNumberOfFrameTimes) {
+        return false;
+    }
+
+    float frame_time_percentile = getFrameTimePercentile();
+
+    // Count the frames in a row the percentile has been well under the target.
+
+    if (frame_time_percentile < kRaiseFraction * target_frame_time_ms_) {
+        frames_under_raise_fraction_++;
+    } else {
+        frames_under_raise_fraction_ = 0;
+    }
+
+    std::string reason = "p95 frame time " + ofToString(frame_time_percentile, 1) + " ms, target "
+                         + ofToString(target_frame_time_ms_, 1) + " ms";
+
+    if (frame_time_percentile > target_frame_time_ms_ && level_index_ < kNumberOfQualityLevels - 1) {
+
+        // If the quality was just raised to this level, and it did not hold, wait twice as long
+        // before raising it again.
+
+        if (was_last_change_raise_ && frames_since_change_ < 2 * raise_hold_frames_) {
+            raise_hold_frames_ = std::min(2 * raise_hold_frames_, kMaximumRaiseHoldFrames);
+        }
+
+        changeLevel(level_index_ + 1, reason);
+        was_last_change_raise_ = false;
+
+        return true;
+    }
+
+    // Only raise the quality once the frames have been well under the target for long enough in a row.
+
+    if (level_index_ > 0 && frames_under_raise_fraction_ >= raise_hold_frames_) {
+
+        changeLevel(level_index_ - 1, reason);
+        was_last_change_raise_ = true;
+
+        return true;
+    }
+
+    return false;
+
+}
+
+/**
+ * Changes the quality level, and logs the change.
+ */
+void QualityGovernor::changeLevel(int new_level_index, const std::string & reason) {
+
+    const QualityLevel & level = kQualityLevels[new_level_index];
+
+    ofLogNotice("QualityGovernor") << "Quality level " << level_index_ << " -> " << new_level_index
+                                   << " (" << reason << "): " << ofToString(level.particle_scale * 100, 0)
+                                   << "% particles, " << ofToString(level.edge_distance_scale * 100, 0)
+                                   << "% edge distance, 1/" << level.band_divisor << " bands, "
+                                   << level.waveform_column_width << " px waveform columns";
+
+    level_index_ = new_level_index;
+
+    // The frames measured so far were at the old level.
+
+    clearFrameTimes();
+
+}
+
+/**
+ * Forgets the frame times measured.
+ */
+void QualityGovernor::clearFrameTimes() {
+
+    next_frame_time_index_ = 0;
+    number_of_frame_times_ = 0;
+    frames_since_change_ = 0;
+    frames_under_raise_fraction_ = 0;
+
+}
+
+/**
+ * Returns the 95th percentile of the frame times measured (in milliseconds), or 0 if none have been.
+ */
+float QualityGovernor::getFrameTimePercentile() {
+
+    if (number_of_frame_times_ == 0) {
+        return 0;
+    }
+
+    // The frame times are partially sorted in a copy (whose capacity is kept), so the ring stays in order.
+
+    sorted_frame_times_ms_.assign(frame_times_ms_.begin(), frame_times_ms_.begin() + number_of_frame_times_);
+
+    int percentile_index = std::min((int) (kFrameTimePercentile * number_of_frame_times_), number_of_frame_times_ - 1);
+
+    std::nth_element(sorted_frame_times_ms_.begin(), sorted_frame_times_ms_.begin() + percentile_index,
+                     sorted_frame_times_ms_.end());
+
+    return sorted_frame_times_ms_[percentile_index];
+
+}
+
+/**
+ * Getter for the index of the quality level (0 is the highest quality).
+ */
+int QualityGovernor::getLevelIndex() const {
+
+    return level_index_;
+
+}
+
+/**
+ * Returns the number of quality levels.
+ */
+int QualityGovernor::getNumberOfLevels() {
+
+    return kNumberOfQualityLevels;
+
+}
+
+/**
+ * Getter for the settings of the quality level.
+ */
+const QualityLevel & QualityGovernor::getLevel() const {
+
+    return kQualityLevels[level_index_];
+
+}
+
+/**
+ * Returns the configuration of a moving graph visualizer, scaled down to the quality level.
+ */
+GraphConfig QualityGovernor::getGovernedConfig(const GraphConfig & config) const {
+
+    const QualityLevel & level = getLevel();
+
+    GraphConfig governed_config = config;
+
+    governed_config.number_of_particles = std::max((int) (config.number_of_particles * level.particle_scale), 1);
+    governed_config.edge_distance = config.edge_distance * level.edge_distance_scale;
+    governed_config.edge_fade_distance = config.edge_fade_distance * level.edge_distance_scale;
+    governed_config.number_of_bands = std::max(config.number_of_bands / level.band_divisor,
+                                               std::min(config.number_of_bands, kMinimumNumberOfBands));
+
+    return governed_config;
+
+}
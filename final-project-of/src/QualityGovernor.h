@@ -0,0 +1,143 @@
+//
+//  QualityGovernor.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef QualityGovernor_h
+#define QualityGovernor_h
+
+#include "VisualizerConfig.h"
+#include <vector>
+
+/**
+ * The settings of a quality level of the visualizations, relative to the configured ones.
+ */
+struct QualityLevel {
+
+    float particle_scale; // the fraction of the configured particles the moving graphs have
+
+    float edge_distance_scale; // the fraction of the configured edge distance the moving graphs have
+
+    int band_divisor; // how many times fewer bands the moving graphs (and bars the FFT visualization) are drawn with
+
+    int waveform_column_width; // the width (in pixels) of the columns the FFT visualization's time waveform
+                               // is decimated into
+
+};
+
+/**
+ * Class that governs the quality of the visualizations, so that they hold a frame time budget
+ * on whichever machine they run on.
+ *
+ * The time each frame takes is measured, and once the 95th percentile of the last second or so of frames
+ * is over the target, the quality is lowered a level (fewer particles, so a quadratically smaller graph, shorter
+ * edges, fewer bands and a coarser time waveform). The quality is only raised again once the frames have been
+ * well under the target for several seconds (longer each time raising it did not hold), so it does not
+ * flicker between two levels.
+ */
+class QualityGovernor {
+
+    float target_frame_time_ms_; // the 95th percentile frame time (in milliseconds) to hold
+
+    bool is_enabled_; // whether the quality is governed (otherwise it is kept at the highest level)
+
+    std::vector<float> frame_times_ms_; // the ring of the times (in milliseconds) of the last frames
+
+    int next_frame_time_index_; // the index in the ring the next frame time is written at
+
+    int number_of_frame_times_; // the number of frame times in the ring
+
+    std::vector<float> sorted_frame_times_ms_; // the frame times, partially sorted to find their percentile
+
+    int level_index_; // the index of the current quality level (0 is the highest quality)
+
+    int frames_since_change_; // the number of frames measured since the quality level last changed
+
+    int frames_under_raise_fraction_; // the number of frames in a row (since the quality level last changed)
+                                      // the percentile has been under the fraction of the target to raise it at
+
+    bool was_last_change_raise_; // whether the quality level was last changed by raising it
+
+    int raise_hold_frames_; // the number of frames to wait (under the target) before the quality is raised
+
+    /**
+     * Changes the quality level, and logs the change.
+     */
+    void changeLevel(int new_level_index, const std::string & reason);
+
+public:
+
+    /**
+     * Constructor for a QualityGovernor object, which holds a frame time of 16.6 ms (60 FPS) at the highest quality.
+     */
+    QualityGovernor() noexcept;
+
+    /**
+     * Sets the 95th percentile frame time to hold.
+     *
+     * @param target_frame_time_ms - the frame time (in milliseconds)
+     */
+    void setTargetFrameTime(float target_frame_time_ms);
+
+    /**
+     * Getter for the 95th percentile frame time held (in milliseconds).
+     */
+    float getTargetFrameTime() const;
+
+    /**
+     * Turns governing the quality on or off. Turning it off brings back the highest quality.
+     *
+     * @return true if the quality level changed, false otherwise
+     */
+    bool setEnabled(bool is_enabled);
+
+    /**
+     * Returns whether the quality is governed.
+     */
+    bool isEnabled() const;
+
+    /**
+     * Measures the time a frame took, and lowers or raises the quality if needed.
+     *
+     * @param frame_time_ms - the time (in milliseconds) the frame took
+     * @return true if the quality level changed (so the new one is to be applied), false otherwise
+     */
+    bool addFrameTime(float frame_time_ms);
+
+    /**
+     * Forgets the frame times measured (e.g. when switching to another visualization, which takes its own time).
+     */
+    void clearFrameTimes();
+
+    /**
+     * Returns the 95th percentile of the frame times measured (in milliseconds), or 0 if none have been.
+     */
+    float getFrameTimePercentile();
+
+    /**
+     * Getter for the index of the quality level (0 is the highest quality).
+     */
+    int getLevelIndex() const;
+
+    /**
+     * Returns the number of quality levels.
+     */
+    static int getNumberOfLevels();
+
+    /**
+     * Getter for the settings of the quality level.
+     */
+    const QualityLevel & getLevel() const;
+
+    /**
+     * Returns the configuration of a moving graph visualizer, scaled down to the quality level.
+     *
+     * @param config - the configuration (at the highest quality)
+     */
+    GraphConfig getGovernedConfig(const GraphConfig & config) const;
+
+};
+
+#endif /* QualityGovernor_h */
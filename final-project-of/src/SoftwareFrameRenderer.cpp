@@ -0,0 +1,859 @@
+//
+//  SoftwareFrameRenderer.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "SoftwareFrameRenderer.h"
+#include <algorithm>
+#include <cmath>
+
+const int kTileSize = 64; // the width and height (in pixels) of the tiles the screen is split into
+
+const float kFieldOfViewDegrees = 60; // the vertical field of view of openFrameworks' default screen perspective
+
+const float kNearDistance = 1; // the least distance (in pixels) from the camera a point is drawn at
+
+/**
+ * Constructor for a SoftwareFrameRenderer object, which does not start its worker threads yet.
+ */
+SoftwareFrameRenderer::SoftwareFrameRenderer() noexcept {
+
+    width_ = 0;
+    height_ = 0;
+    background_color_ = FrameColor{0, 0, 0, 255};
+    camera_distance_ = 0;
+
+    number_of_tile_columns_ = 0;
+    number_of_tiles_ = 0;
+
+    // The calling thread has an accumulation buffer, whether or not there are workers.
+
+    tile_buffers_.resize(1, std::vector<float>(kTileSize * kTileSize * 3));
+
+    frame_number_ = 0;
+    number_of_busy_workers_ = 0;
+    is_running_ = false;
+    next_tile_index_ = 0;
+
+}
+
+/**
+ * Destructor, which stops the worker threads.
+ */
+SoftwareFrameRenderer::~SoftwareFrameRenderer() {
+
+    stop();
+
+}
+
+/**
+ * Starts the worker threads.
+ */
+void SoftwareFrameRenderer::start(int number_of_threads) {
+
+    stop();
+
+    if (number_of_threads <= 0) {
+        number_of_threads = std::max((int) std::thread::hardware_concurrency(), 1);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    is_running_ = true;
+
+    // The calling thread rasterizes tiles too, so one thread fewer is started.
+    // Each thread has an accumulation buffer of its own.
+
+    tile_buffers_.resize(number_of_threads, std::vector<float>(kTileSize * kTileSize * 3));
+
+    for (int index = 1; index < number_of_threads; index++) {
+        workers_.push_back(std::thread(&SoftwareFrameRenderer::runWorker, this, index, frame_number_));
+    }
+
+}
+
+/**
+ * Stops the worker threads.
+ */
+void SoftwareFrameRenderer::stop() {
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        is_running_ = false;
+        condition_.notify_all();
+    }
+
+    for (int index = 0; index < (int) workers_.size(); index++) {
+        workers_[index].join();
+    }
+
+    workers_.clear();
+
+}
+
+/**
+ * The function run by the worker threads.
+ */
+void SoftwareFrameRenderer::runWorker(int thread_index, int frame_number) {
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+
+        // Sleep till the next frame is handed out (or the renderer is stopped).
+
+        condition_.wait(lock, [this, frame_number] { return frame_number_ != frame_number || !is_running_; });
+
+        if (!is_running_) {
+            break;
+        }
+
+        frame_number = frame_number_;
+
+        lock.unlock();
+        rasterizeTiles(thread_index);
+        lock.lock();
+
+        number_of_busy_workers_--;
+        condition_.notify_all();
+    }
+
+}
+
+/**
+ * Rasterizes a frame, at the size of the window it was computed for.
+ */
+void SoftwareFrameRenderer::draw(const VisualizerFrame & frame, const FrameColor & background_color) {
+
+    width_ = std::max(frame.width, 0);
+    height_ = std::max(frame.height, 0);
+    pixels_.resize((size_t) width_ * height_ * 3);
+
+    background_color_ = frame.has_background ? frame.background_color : background_color;
+
+    // openFrameworks' default screen perspective sees the z = 0 plane pixel for pixel,
+    // from a camera centred on the window.
+
+    camera_distance_ = (height_ / 2.0f) / std::tan(kFieldOfViewDegrees / 2 * M_PI / 180);
+
+    // Bring every primitive into screen coordinates once, in the order it is drawn,
+    // so the tiles only bin, clip and rasterize them.
+
+    primitives_.clear();
+
+    for (int index = 0; index < (int) frame.layers.size(); index++) {
+        addLayer(frame.layers[index]);
+    }
+
+    number_of_tile_columns_ = (width_ + kTileSize - 1) / kTileSize;
+    number_of_tiles_ = number_of_tile_columns_ * ((height_ + kTileSize - 1) / kTileSize);
+
+    binPrimitives();
+
+    next_tile_index_ = 0;
+
+    if (workers_.empty()) {
+
+        rasterizeTiles(0);
+        return;
+
+    }
+
+    // Hand the frame out to the workers, rasterize tiles along with them, then wait for them to finish theirs.
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    frame_number_++;
+    number_of_busy_workers_ = workers_.size();
+    condition_.notify_all();
+
+    lock.unlock();
+    rasterizeTiles(0);
+    lock.lock();
+
+    condition_.wait(lock, [this] { return number_of_busy_workers_ == 0; });
+
+}
+
+/**
+ * Getter for the width (in pixels) of the frame rasterized.
+ */
+int SoftwareFrameRenderer::getWidth() const {
+
+    return width_;
+
+}
+
+/**
+ * Getter for the height (in pixels) of the frame rasterized.
+ */
+int SoftwareFrameRenderer::getHeight() const {
+
+    return height_;
+
+}
+
+/**
+ * Returns the RGB pixels of the frame rasterized.
+ */
+const unsigned char * SoftwareFrameRenderer::getPixels() const {
+
+    return pixels_.data();
+
+}
+
+/**
+ * Projects a (translated) point through the perspective of the screen.
+ */
+bool SoftwareFrameRenderer::project(float x, float y, float z, float & screen_x, float & screen_y, float & scale) const {
+
+    if (z == 0) {
+
+        screen_x = x;
+        screen_y = y;
+        scale = 1;
+
+        return true;
+    }
+
+    // The camera looks down the z axis from camera_distance_ in front of the screen,
+    // so points in front of the screen (z > 0) are drawn larger, and further out from the centre.
+
+    float distance = camera_distance_ - z;
+
+    if (distance < kNearDistance) {
+        return false;
+    }
+
+    scale = camera_distance_ / distance;
+    screen_x = width_ / 2.0f + (x - width_ / 2.0f) * scale;
+    screen_y = height_ / 2.0f + (y - height_ / 2.0f) * scale;
+
+    return true;
+
+}
+
+/**
+ * Adds the primitives of a layer of a frame, in screen coordinates.
+ */
+void SoftwareFrameRenderer::addLayer(const FrameLayer & layer) {
+
+    float translate_x = layer.translate_x;
+    float translate_y = layer.translate_y;
+
+    // openGL draws lines at least a pixel wide.
+
+    float half_line_width = std::max(layer.line_width, 1.0f) / 2;
+
+    // Within a layer, the primitives are drawn in the order FrameRenderer draws them.
+
+    for (int index = 0; index < (int) layer.rectangles.size(); index++) {
+
+        const FrameRectangle & rectangle = layer.rectangles[index];
+
+        RasterPrimitive & primitive = primitives_.add();
+
+        primitive.type = RASTER_RECTANGLE;
+        primitive.x1 = std::min(rectangle.x, rectangle.x + rectangle.width) + translate_x;
+        primitive.y1 = std::min(rectangle.y, rectangle.y + rectangle.height) + translate_y;
+        primitive.x2 = std::max(rectangle.x, rectangle.x + rectangle.width) + translate_x;
+        primitive.y2 = std::max(rectangle.y, rectangle.y + rectangle.height) + translate_y;
+        primitive.color = rectangle.color;
+
+        setBounds(primitive, primitive.x1, primitive.y1, primitive.x2, primitive.y2);
+    }
+
+    for (int index = 0; index < (int) layer.circles.size(); index++) {
+
+        const FrameCircle & circle = layer.circles[index];
+
+        float x, y, scale;
+
+        if (!project(circle.x + translate_x, circle.y + translate_y, circle.z, x, y, scale)) {
+            continue;
+        }
+
+        RasterPrimitive & primitive = primitives_.add();
+
+        primitive.type = RASTER_CIRCLE;
+        primitive.x1 = x;
+        primitive.y1 = y;
+        primitive.size = circle.radius * scale;
+        primitive.color = circle.color;
+
+        // A circle smaller than a pixel is drawn as (a fraction of) the pixel its centre is in.
+
+        float reach = std::max(primitive.size + 0.5f, 0.0f);
+
+        if (primitive.size < 0.5) {
+            setBounds(primitive, std::floor(x), std::floor(y), std::floor(x) + 1, std::floor(y) + 1);
+        } else {
+            setBounds(primitive, x - reach, y - reach, x + reach, y + reach);
+        }
+    }
+
+    for (int index = 0; index < (int) layer.triangles.size(); index++) {
+
+        const FrameTriangle & triangle = layer.triangles[index];
+
+        RasterPrimitive & primitive = primitives_.add();
+
+        primitive.type = RASTER_TRIANGLE;
+        primitive.x1 = triangle.x1 + translate_x;
+        primitive.y1 = triangle.y1 + translate_y;
+        primitive.x2 = triangle.x2 + translate_x;
+        primitive.y2 = triangle.y2 + translate_y;
+        primitive.x3 = triangle.x3 + translate_x;
+        primitive.y3 = triangle.y3 + translate_y;
+        primitive.color = triangle.color;
+
+        setBounds(primitive, std::min(primitive.x1, std::min(primitive.x2, primitive.x3)),
+                  std::min(primitive.y1, std::min(primitive.y2, primitive.y3)),
+                  std::max(primitive.x1, std::max(primitive.x2, primitive.x3)),
+                  std::max(primitive.y1, std::max(primitive.y2, primitive.y3)));
+    }
+
+    for (int index = 0; index < (int) layer.lines.size(); index++) {
+
+        const FrameLine & line = layer.lines[index];
+
+        addLine(line.x1 + translate_x, line.y1 + translate_y, line.z1, line.x2 + translate_x, line.y2 + translate_y,
+                line.z2, half_line_width, line.color);
+    }
+
+    for (int index = 1; index < (int) layer.polyline.size(); index++) {
+
+        const FrameVertex & start = layer.polyline[index - 1];
+        const FrameVertex & end = layer.polyline[index];
+
+        addLine(start.x + translate_x, start.y + translate_y, 0, end.x + translate_x, end.y + translate_y, 0,
+                half_line_width, layer.polyline_color);
+    }
+
+}
+
+/**
+ * Adds a line between two (translated) points.
+ */
+void SoftwareFrameRenderer::addLine(float x1, float y1, float z1, float x2, float y2, float z2, float half_width,
+                                    const FrameColor & color) {
+
+    float screen_x1, screen_y1, screen_x2, screen_y2, scale;
+
+    if (!project(x1, y1, z1, screen_x1, screen_y1, scale) || !project(x2, y2, z2, screen_x2, screen_y2, scale)) {
+        return;
+    }
+
+    RasterPrimitive & primitive = primitives_.add();
+
+    primitive.type = RASTER_LINE;
+    primitive.x1 = screen_x1;
+    primitive.y1 = screen_y1;
+    primitive.x2 = screen_x2;
+    primitive.y2 = screen_y2;
+    primitive.size = half_width;
+    primitive.color = color;
+
+    float reach = half_width + 0.5f;
+
+    setBounds(primitive, std::min(screen_x1, screen_x2) - reach, std::min(screen_y1, screen_y2) - reach,
+              std::max(screen_x1, screen_x2) + reach, std::max(screen_y1, screen_y2) + reach);
+
+}
+
+/**
+ * Sets the pixels a primitive may cover, from its bounds (clipped to the screen).
+ */
+void SoftwareFrameRenderer::setBounds(RasterPrimitive & primitive, float left, float top, float right,
+                                      float bottom) const {
+
+    primitive.left = (int) std::max(std::floor(left), 0.0f);
+    primitive.top = (int) std::max(std::floor(top), 0.0f);
+    primitive.right = (int) std::min(std::ceil(right), (float) width_);
+    primitive.bottom = (int) std::min(std::ceil(bottom), (float) height_);
+
+}
+
+/**
+ * Sorts the primitives into the bins of the tiles they cover (keeping their order in each bin).
+ */
+void SoftwareFrameRenderer::binPrimitives() {
+
+    // First, list the tiles each primitive covers (a rectangle, circle or triangle all the tiles its bounds overlap,
+    // a line only those it crosses), in the order of the primitives.
+
+    bin_entries_.clear();
+
+    for (int index = 0; index < (int) primitives_.size(); index++) {
+
+        const RasterPrimitive & primitive = primitives_[index];
+
+        if (primitive.left >= primitive.right || primitive.top >= primitive.bottom) {
+            continue;
+        }
+
+        if (primitive.type == RASTER_LINE) {
+
+            binLine(index);
+
+        } else {
+
+            for (int tile_row = primitive.top / kTileSize; tile_row <= (primitive.bottom - 1) / kTileSize; tile_row++) {
+                addToBins(index, tile_row, primitive.left / kTileSize, (primitive.right - 1) / kTileSize);
+            }
+        }
+    }
+
+    // Then sort the entries by tile (a counting sort, which keeps the order of the primitives in each bin).
+
+    bin_offsets_.resize(number_of_tiles_ + 1);
+    std::fill(&bin_offsets_[0], &bin_offsets_[0] + number_of_tiles_ + 1, 0);
+
+    for (int index = 0; index < (int) bin_entries_.size(); index++) {
+        bin_offsets_[bin_entries_[index].tile_index + 1]++;
+    }
+
+    for (int tile_index = 0; tile_index < number_of_tiles_; tile_index++) {
+        bin_offsets_[tile_index + 1] += bin_offsets_[tile_index];
+    }
+
+    binned_primitives_.resize(bin_entries_.size());
+
+    for (int index = 0; index < (int) bin_entries_.size(); index++) {
+
+        const TileBinEntry & entry = bin_entries_[index];
+
+        // (Each tile's offset is moved on as its bin is filled in, and moved back after.)
+
+        binned_primitives_[bin_offsets_[entry.tile_index]++] = entry.primitive_index;
+    }
+
+    for (int tile_index = number_of_tiles_; tile_index > 0; tile_index--) {
+        bin_offsets_[tile_index] = bin_offsets_[tile_index - 1];
+    }
+
+    bin_offsets_[0] = 0;
+
+}
+
+/**
+ * Adds a primitive to the bins of a range of tiles of a row of tiles.
+ */
+void SoftwareFrameRenderer::addToBins(int primitive_index, int tile_row, int first_tile_column, int last_tile_column) {
+
+    for (int tile_column = first_tile_column; tile_column <= last_tile_column; tile_column++) {
+
+        TileBinEntry & entry = bin_entries_.add();
+
+        entry.tile_index = tile_row * number_of_tile_columns_ + tile_column;
+        entry.primitive_index = primitive_index;
+    }
+
+}
+
+/**
+ * Adds a line to the bins of the tiles it comes within reach of.
+ */
+void SoftwareFrameRenderer::binLine(int primitive_index) {
+
+    const RasterPrimitive & line = primitives_[primitive_index];
+
+    float reach = line.size + 0.5f;
+
+    float delta_x = line.x2 - line.x1;
+    float delta_y = line.y2 - line.y1;
+
+    // For each row of tiles, find the part of the line within reach of it,
+    // and add the line to the tiles that part is within reach of.
+
+    for (int tile_row = line.top / kTileSize; tile_row <= (line.bottom - 1) / kTileSize; tile_row++) {
+
+        float band_top = tile_row * kTileSize - reach;
+        float band_bottom = (tile_row + 1) * kTileSize + reach;
+
+        float t_from = 0;
+        float t_to = 1;
+
+        if (delta_y != 0) {
+
+            float t_a = (band_top - line.y1) / delta_y;
+            float t_b = (band_bottom - line.y1) / delta_y;
+
+            t_from = std::max(std::min(t_a, t_b), 0.0f);
+            t_to = std::min(std::max(t_a, t_b), 1.0f);
+
+            if (t_from > t_to) {
+                continue;
+            }
+        }
+
+        float x_a = line.x1 + t_from * delta_x;
+        float x_b = line.x1 + t_to * delta_x;
+
+        int left = std::max((int) std::floor(std::min(x_a, x_b) - reach), line.left);
+        int right = std::min((int) std::ceil(std::max(x_a, x_b) + reach), line.right);
+
+        if (left < right) {
+            addToBins(primitive_index, tile_row, left / kTileSize, (right - 1) / kTileSize);
+        }
+    }
+
+}
+
+/**
+ * Rasterizes tiles till there are none left.
+ */
+void SoftwareFrameRenderer::rasterizeTiles(int thread_index) {
+
+    float * tile_buffer = tile_buffers_[thread_index].data();
+
+    int tile_index;
+
+    while ((tile_index = next_tile_index_.fetch_add(1)) < number_of_tiles_) {
+        rasterizeTile(tile_index, tile_buffer);
+    }
+
+}
+
+/**
+ * Returns the pixel of the tile's accumulation buffer at the given pixel of the frame.
+ */
+float * SoftwareFrameRenderer::getTilePixel(const RasterTile & tile, int column, int row) {
+
+    return tile.pixels + ((row - tile.top) * kTileSize + (column - tile.left)) * 3;
+
+}
+
+/**
+ * Rasterizes the primitives of a tile's bin over it, then writes it to the frame.
+ */
+void SoftwareFrameRenderer::rasterizeTile(int tile_index, float * tile_buffer) {
+
+    RasterTile tile;
+
+    tile.pixels = tile_buffer;
+    tile.left = (tile_index % number_of_tile_columns_) * kTileSize;
+    tile.top = (tile_index / number_of_tile_columns_) * kTileSize;
+    tile.right = std::min(tile.left + kTileSize, width_);
+    tile.bottom = std::min(tile.top + kTileSize, height_);
+
+    // Clear the accumulation buffer to the background colour.
+
+    for (int index = 0; index < kTileSize * kTileSize * 3; index += 3) {
+
+        tile_buffer[index] = background_color_.r;
+        tile_buffer[index + 1] = background_color_.g;
+        tile_buffer[index + 2] = background_color_.b;
+    }
+
+    // Blend the primitives of the tile's bin, in order, clipped to it.
+
+    for (int entry = bin_offsets_[tile_index]; entry < bin_offsets_[tile_index + 1]; entry++) {
+
+        const RasterPrimitive & primitive = primitives_[binned_primitives_[entry]];
+
+        int left = std::max(primitive.left, tile.left);
+        int top = std::max(primitive.top, tile.top);
+        int right = std::min(primitive.right, tile.right);
+        int bottom = std::min(primitive.bottom, tile.bottom);
+
+        switch (primitive.type) {
+            case RASTER_RECTANGLE:
+                rasterizeRectangle(primitive, tile, left, top, right, bottom);
+                break;
+            case RASTER_CIRCLE:
+                rasterizeCircle(primitive, tile, left, top, right, bottom);
+                break;
+            case RASTER_TRIANGLE:
+                rasterizeTriangle(primitive, tile, left, top, right, bottom);
+                break;
+            case RASTER_LINE:
+                rasterizeLine(primitive, tile, left, top, right, bottom);
+                break;
+        }
+    }
+
+    // Write the tile to the frame.
+
+    for (int row = tile.top; row < tile.bottom; row++) {
+
+        const float * tile_pixel = getTilePixel(tile, tile.left, row);
+        unsigned char * pixel = &pixels_[((size_t) row * width_ + tile.left) * 3];
+
+        for (int index = 0; index < (tile.right - tile.left) * 3; index++) {
+            pixel[index] = (unsigned char) (tile_pixel[index] + 0.5f);
+        }
+    }
+
+}
+
+/**
+ * Blends a colour into a pixel, with the given coverage of the pixel.
+ */
+void SoftwareFrameRenderer::blend(float * pixel, const FrameColor & color, float coverage) {
+
+    // As openGL blends with (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA).
+
+    float alpha = color.a * coverage * (1 / 255.0f);
+
+    pixel[0] += (color.r - pixel[0]) * alpha;
+    pixel[1] += (color.g - pixel[1]) * alpha;
+    pixel[2] += (color.b - pixel[2]) * alpha;
+
+}
+
+/**
+ * Rasterizes a rectangle over the given pixels (with the edges anti-aliased by their coverage of each pixel).
+ */
+void SoftwareFrameRenderer::rasterizeRectangle(const RasterPrimitive & rectangle, const RasterTile & tile,
+                                               int left, int top, int right, int bottom) {
+
+    for (int row = top; row < bottom; row++) {
+
+        float row_coverage = std::min(row + 1.0f, rectangle.y2) - std::max((float) row, rectangle.y1);
+        float * pixel = getTilePixel(tile, left, row);
+
+        for (int column = left; column < right; column++, pixel += 3) {
+
+            float column_coverage = std::min(column + 1.0f, rectangle.x2) - std::max((float) column, rectangle.x1);
+            blend(pixel, rectangle.color, row_coverage * column_coverage);
+        }
+    }
+
+}
+
+/**
+ * Rasterizes an anti-aliased circle over the given pixels.
+ */
+void SoftwareFrameRenderer::rasterizeCircle(const RasterPrimitive & circle, const RasterTile & tile,
+                                            int left, int top, int right, int bottom) {
+
+    // A circle smaller than a pixel covers a fraction of the one pixel it is drawn in (its area).
+
+    if (circle.size < 0.5) {
+
+        blend(getTilePixel(tile, left, top), circle.color, M_PI * circle.size * circle.size);
+        return;
+
+    }
+
+    // Otherwise, each pixel is covered by how far inside the edge its centre is (up to a pixel).
+
+    float reach = circle.size + 0.5f;
+
+    for (int row = top; row < bottom; row++) {
+
+        float y_distance = row + 0.5f - circle.y1;
+        float * pixel = getTilePixel(tile, left, row);
+
+        for (int column = left; column < right; column++, pixel += 3) {
+
+            float x_distance = column + 0.5f - circle.x1;
+            float distance_squared = x_distance * x_distance + y_distance * y_distance;
+
+            if (distance_squared < reach * reach) {
+                blend(pixel, circle.color, std::min(reach - std::sqrt(distance_squared), 1.0f));
+            }
+        }
+    }
+
+}
+
+/**
+ * Rasterizes a triangle over the given pixels (the pixels whose centres are inside it).
+ */
+void SoftwareFrameRenderer::rasterizeTriangle(const RasterPrimitive & triangle, const RasterTile & tile,
+                                              int left, int top, int right, int bottom) {
+
+    float x[3] = {triangle.x1, triangle.x2, triangle.x3};
+    float y[3] = {triangle.y1, triangle.y2, triangle.y3};
+
+    // Order the vertices clockwise (on the screen), so a pixel is inside when it is on the right of every edge.
+
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+
+    if (area == 0) {
+        return;
+    }
+
+    if (area < 0) {
+
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+    }
+
+    // The edge functions, stepped across the pixels. A pixel centre right on an edge is only inside the triangle
+    // if the edge is a top or left edge, so two triangles sharing an edge never blend a pixel twice.
+
+    float step_x[3], step_y[3], start_value[3];
+    bool is_top_left[3];
+
+    for (int edge = 0; edge < 3; edge++) {
+
+        int next = (edge + 1) % 3;
+        float edge_x = x[next] - x[edge];
+        float edge_y = y[next] - y[edge];
+
+        step_x[edge] = - edge_y;
+        step_y[edge] = edge_x;
+        start_value[edge] = edge_x * (top + 0.5f - y[edge]) - edge_y * (left + 0.5f - x[edge]);
+        is_top_left[edge] = edge_y < 0 || (edge_y == 0 && edge_x > 0);
+    }
+
+    for (int row = top; row < bottom; row++) {
+
+        float value[3];
+
+        for (int edge = 0; edge < 3; edge++) {
+            value[edge] = start_value[edge] + (row - top) * step_y[edge];
+        }
+
+        float * pixel = getTilePixel(tile, left, row);
+
+        for (int column = left; column < right; column++, pixel += 3) {
+
+            bool is_inside = true;
+
+            for (int edge = 0; edge < 3; edge++) {
+                is_inside = is_inside && (value[edge] > 0 || (value[edge] == 0 && is_top_left[edge]));
+            }
+
+            if (is_inside) {
+                blend(pixel, triangle.color, 1);
+            }
+
+            for (int edge = 0; edge < 3; edge++) {
+                value[edge] += step_x[edge];
+            }
+        }
+    }
+
+}
+
+/**
+ * Rasterizes an anti-aliased line over the given pixels.
+ */
+void SoftwareFrameRenderer::rasterizeLine(const RasterPrimitive & line, const RasterTile & tile,
+                                          int left, int top, int right, int bottom) {
+
+    // Each pixel is covered by how far inside the line (a capsule half_width around the segment) its centre is,
+    // up to a pixel. Only the pixels near the segment are visited: along its major axis, those within its reach
+    // across it.
+
+    float delta_x = line.x2 - line.x1;
+    float delta_y = line.y2 - line.y1;
+    float length_squared = delta_x * delta_x + delta_y * delta_y;
+
+    float reach = line.size + 0.5f;
+
+    bool is_steep = std::fabs(delta_y) > std::fabs(delta_x);
+
+    float major_start = is_steep ? line.y1 : line.x1;
+    float minor_start = is_steep ? line.x1 : line.y1;
+    float major_delta = is_steep ? delta_y : delta_x;
+    float minor_delta = is_steep ? delta_x : delta_y;
+
+    float slope = (major_delta != 0) ? minor_delta / major_delta : 0;
+    float minor_reach = reach * std::sqrt(1 + slope * slope);
+
+    float major_minimum = std::min(major_start, major_start + major_delta);
+    float major_maximum = std::max(major_start, major_start + major_delta);
+
+    int major_first = is_steep ? top : left;
+    int major_end = is_steep ? bottom : right;
+    int minor_first = is_steep ? left : top;
+    int minor_end = is_steep ? right : bottom;
+
+    // Of the rows (or columns) given, only those where the line comes within reach of the columns (or rows) given
+    // are visited. (A long diagonal line's bounds overlap many tiles it does not cross.)
+
+    if (slope != 0) {
+
+        float crossing_a = major_start + (minor_first - minor_reach - minor_start) / slope;
+        float crossing_b = major_start + (minor_end + minor_reach - minor_start) / slope;
+
+        float crossing_from = std::max(std::min(crossing_a, crossing_b), major_minimum);
+        float crossing_to = std::min(std::max(crossing_a, crossing_b), major_maximum);
+
+        if (crossing_from > crossing_to) {
+            return;
+        }
+
+        // Beyond its ends, the line is held at its ends (which are within reach, if the crossing reaches them).
+
+        if (crossing_from > major_minimum) {
+            major_first = std::max(major_first, (int) std::floor(crossing_from - 0.5f));
+        }
+
+        if (crossing_to < major_maximum) {
+            major_end = std::min(major_end, (int) std::ceil(crossing_to - 0.5f) + 1);
+        }
+    }
+
+    // Away from its ends, a pixel's distance from the line is its distance from the centre across the line,
+    // foreshortened by the slope. Only near the ends (the round caps) is the distance to the end points needed.
+
+    float inverse_stretch = 1 / std::sqrt(1 + slope * slope);
+
+    float inverse_length_squared = (length_squared > 0) ? 1 / length_squared : 0;
+
+    float cap_from = major_minimum + minor_reach + 1;
+    float cap_to = major_maximum - minor_reach - 1;
+
+    int pixel_step = is_steep ? 3 : kTileSize * 3;
+
+    for (int major = major_first; major < major_end; major++) {
+
+        // The centre of the line across this row (or column), beyond the ends held at the ends.
+
+        float major_position = std::min(std::max(major + 0.5f, major_minimum), major_maximum);
+        float minor_centre = minor_start + (major_position - major_start) * slope;
+
+        int minor_from = std::max((int) std::floor(minor_centre - minor_reach), minor_first);
+        int minor_to = std::min((int) std::floor(minor_centre + minor_reach) + 1, minor_end);
+
+        if (minor_from >= minor_to) {
+            continue;
+        }
+
+        bool is_near_end = major + 0.5f < cap_from || major + 0.5f > cap_to;
+
+        int first_column = is_steep ? minor_from : major;
+        int first_row = is_steep ? major : minor_from;
+
+        float * pixel = getTilePixel(tile, first_column, first_row);
+
+        for (int minor = minor_from; minor < minor_to; minor++, pixel += pixel_step) {
+
+            float distance;
+
+            if (!is_near_end) {
+
+                distance = std::fabs(minor + 0.5f - minor_centre) * inverse_stretch;
+
+            } else {
+
+                // The distance from the pixel centre to the nearest point of the segment.
+
+                float offset_x = (is_steep ? minor : major) + 0.5f - line.x1;
+                float offset_y = (is_steep ? major : minor) + 0.5f - line.y1;
+
+                float t = (offset_x * delta_x + offset_y * delta_y) * inverse_length_squared;
+                t = std::min(std::max(t, 0.0f), 1.0f);
+
+                float distance_x = offset_x - t * delta_x;
+                float distance_y = offset_y - t * delta_y;
+
+                distance = std::sqrt(distance_x * distance_x + distance_y * distance_y);
+            }
+
+            if (distance < reach) {
+                blend(pixel, line.color, std::min(reach - distance, 1.0f));
+            }
+        }
+    }
+
+}
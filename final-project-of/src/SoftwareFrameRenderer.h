@@ -0,0 +1,263 @@
+//
+//  SoftwareFrameRenderer.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef SoftwareFrameRenderer_h
+#define SoftwareFrameRenderer_h
+
+#include "VisualizerFrame.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Class that rasterizes a VisualizerFrame on the CPU (into RGB pixels), so that the visualizations can be
+ * rendered without a GPU, e.g. headless on a server.
+ *
+ * It draws what FrameRenderer draws with openGL, in the same order: filled rectangles, circles and triangles,
+ * and anti-aliased lines and polylines, all alpha blended, with 3D points seen through the same perspective
+ * as openFrameworks' default screen. (The texts are not drawn, as there is no font rasterizer.)
+ *
+ * The screen is split into tiles of 64 x 64 pixels, which are rasterized in parallel. First, the primitives are
+ * binned into the tiles they cover (a line only into the tiles it crosses, not all those its bounds overlap),
+ * keeping their order. Then each thread takes the next tile there is, and blends the primitives of its bin,
+ * in order, into an accumulation buffer of its own (in floating point, so that thousands of faint edges add up
+ * without rounding away), which is written to the frame once the tile is done. No two threads ever touch
+ * the same pixel, so there is no locking (or atomics) on the pixels.
+ */
+class SoftwareFrameRenderer {
+
+    /**
+     * The kinds of primitives rasterized.
+     */
+    enum RasterPrimitiveType {
+        RASTER_RECTANGLE,
+        RASTER_CIRCLE,
+        RASTER_TRIANGLE,
+        RASTER_LINE
+    };
+
+    /**
+     * A primitive of the frame, in screen coordinates (translated, and projected).
+     */
+    struct RasterPrimitive {
+
+        RasterPrimitiveType type; // the kind of primitive
+
+        float x1, y1, x2, y2, x3, y3; // the points of the primitive (the corners of a rectangle, the centre of
+                                      // a circle, the end points of a line, or the vertices of a triangle)
+
+        float size; // the radius of a circle, or half the width of a line
+
+        FrameColor color; // the colour of the primitive
+
+        int left, top, right, bottom; // the pixels the primitive may cover (right and bottom excluded)
+
+    };
+
+    /**
+     * An entry of a tile's bin: a primitive which covers (some of) the tile.
+     */
+    struct TileBinEntry {
+
+        int tile_index; // the index of the tile
+
+        int primitive_index; // the index of the primitive
+
+    };
+
+    /**
+     * A tile being rasterized, along with the accumulation buffer its pixels are blended in.
+     */
+    struct RasterTile {
+
+        float * pixels; // the RGB pixels of the tile (each component in [0, 255]), kTileSize pixels a row
+
+        int left, top, right, bottom; // the pixels of the frame the tile covers (right and bottom excluded)
+
+    };
+
+    int width_, height_; // the size (in pixels) of the frame rasterized
+
+    std::vector<unsigned char> pixels_; // the RGB pixels of the frame rasterized, row by row
+
+    FrameColor background_color_; // the colour the frame is cleared to
+
+    float camera_distance_; // the distance of the camera from the screen (in pixels), for 3D points
+
+    GeometryBuffer<RasterPrimitive> primitives_; // the primitives of the frame, in the order they are drawn
+
+    int number_of_tile_columns_; // the number of columns of tiles the screen is split into
+
+    int number_of_tiles_; // the number of tiles the screen is split into
+
+    GeometryBuffer<TileBinEntry> bin_entries_; // the entries of all the bins, in the order of their primitives
+
+    GeometryBuffer<int> bin_offsets_; // where the primitives of each tile's bin start in binned_primitives_
+                                      // (with the number of entries at the end)
+
+    GeometryBuffer<int> binned_primitives_; // the indices of the primitives of each bin, in order, bin after bin
+
+    std::vector<std::vector<float> > tile_buffers_; // the accumulation buffer of each thread (the calling thread's first)
+
+    std::vector<std::thread> workers_; // the worker threads which rasterize tiles along with the calling thread
+
+    std::mutex mutex_; // the mutex guarding the state below
+
+    std::condition_variable condition_; // the condition the workers and the calling thread wait on
+
+    int frame_number_; // the number of frames handed to the workers so far
+
+    int number_of_busy_workers_; // the number of workers still rasterizing the current frame
+
+    bool is_running_; // whether the worker threads should keep running
+
+    std::atomic<int> next_tile_index_; // the index of the next tile to be rasterized
+
+    /**
+     * The function run by the worker threads.
+     *
+     * @param thread_index - the index of the thread (the calling thread's is 0)
+     * @param frame_number - the number of frames handed to the workers when the thread was started
+     */
+    void runWorker(int thread_index, int frame_number);
+
+    /**
+     * Rasterizes tiles till there are none left.
+     *
+     * @param thread_index - the index of the thread (whose accumulation buffer the tiles are blended in)
+     */
+    void rasterizeTiles(int thread_index);
+
+    /**
+     * Rasterizes the primitives of a tile's bin over it, then writes it to the frame.
+     */
+    void rasterizeTile(int tile_index, float * tile_buffer);
+
+    /**
+     * Sorts the primitives into the bins of the tiles they cover (keeping their order in each bin).
+     */
+    void binPrimitives();
+
+    /**
+     * Adds a primitive to the bins of a range of tiles of a row of tiles.
+     */
+    void addToBins(int primitive_index, int tile_row, int first_tile_column, int last_tile_column);
+
+    /**
+     * Adds a line to the bins of the tiles it comes within reach of.
+     */
+    void binLine(int primitive_index);
+
+    /**
+     * Returns the pixel of the tile's accumulation buffer at the given pixel of the frame.
+     */
+    static float * getTilePixel(const RasterTile & tile, int column, int row);
+
+    /**
+     * Projects a (translated) point through the perspective of the screen.
+     *
+     * @return false if the point is behind the camera, true otherwise
+     */
+    bool project(float x, float y, float z, float & screen_x, float & screen_y, float & scale) const;
+
+    /**
+     * Adds the primitives of a layer of a frame, in screen coordinates.
+     */
+    void addLayer(const FrameLayer & layer);
+
+    /**
+     * Adds a line between two (translated) points.
+     */
+    void addLine(float x1, float y1, float z1, float x2, float y2, float z2, float half_width, const FrameColor & color);
+
+    /**
+     * Sets the pixels a primitive may cover, from its bounds (clipped to the screen).
+     */
+    void setBounds(RasterPrimitive & primitive, float left, float top, float right, float bottom) const;
+
+    /**
+     * Blends a colour into a pixel, with the given coverage of the pixel.
+     */
+    static void blend(float * pixel, const FrameColor & color, float coverage);
+
+    /**
+     * Rasterizes a rectangle over the given pixels (with the edges anti-aliased by their coverage of each pixel).
+     */
+    void rasterizeRectangle(const RasterPrimitive & rectangle, const RasterTile & tile,
+                            int left, int top, int right, int bottom);
+
+    /**
+     * Rasterizes an anti-aliased circle over the given pixels.
+     */
+    void rasterizeCircle(const RasterPrimitive & circle, const RasterTile & tile,
+                         int left, int top, int right, int bottom);
+
+    /**
+     * Rasterizes a triangle over the given pixels (the pixels whose centres are inside it).
+     */
+    void rasterizeTriangle(const RasterPrimitive & triangle, const RasterTile & tile,
+                           int left, int top, int right, int bottom);
+
+    /**
+     * Rasterizes an anti-aliased line over the given pixels.
+     */
+    void rasterizeLine(const RasterPrimitive & line, const RasterTile & tile,
+                       int left, int top, int right, int bottom);
+
+public:
+
+    /**
+     * Constructor for a SoftwareFrameRenderer object, which does not start its worker threads yet.
+     */
+    SoftwareFrameRenderer() noexcept;
+
+    /**
+     * Destructor, which stops the worker threads.
+     */
+    ~SoftwareFrameRenderer();
+
+    /**
+     * Starts the worker threads.
+     *
+     * @param number_of_threads - the number of threads to rasterize with (the calling thread included),
+     *                            or 0 for as many as there are cores
+     */
+    void start(int number_of_threads = 0);
+
+    /**
+     * Stops the worker threads (the frames are then rasterized on the calling thread alone).
+     */
+    void stop();
+
+    /**
+     * Rasterizes a frame, at the size of the window it was computed for.
+     *
+     * @param frame - the frame to be rasterized
+     * @param background_color - the colour the frame is cleared to, if it does not set its own background
+     */
+    void draw(const VisualizerFrame & frame, const FrameColor & background_color);
+
+    /**
+     * Getter for the width (in pixels) of the frame rasterized.
+     */
+    int getWidth() const;
+
+    /**
+     * Getter for the height (in pixels) of the frame rasterized.
+     */
+    int getHeight() const;
+
+    /**
+     * Returns the RGB pixels of the frame rasterized (3 bytes per pixel, row by row from the top).
+     */
+    const unsigned char * getPixels() const;
+
+};
+
+#endif /* SoftwareFrameRenderer_h */
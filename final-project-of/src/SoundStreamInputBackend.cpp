@@ -0,0 +1,85 @@
+//
+//  SoundStreamInputBackend.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "SoundStreamInputBackend.h"
+
+const int kNumberOfStreamBuffers = 4; // the number of buffers the sound stream queues
+
+/**
+ * Constructor for a SoundStreamInputBackend object, which does not open the sound stream yet.
+ */
+SoundStreamInputBackend::SoundStreamInputBackend() noexcept {
+    
+    is_open_ = false;
+    sample_rate_ = 44100;
+    
+}
+
+/**
+ * Destructor for a SoundStreamInputBackend object, which closes the sound stream.
+ */
+SoundStreamInputBackend::~SoundStreamInputBackend() {
+    
+    stop();
+    
+}
+
+/**
+ * Opens the sound stream, which delivers its blocks to the listener.
+ */
+bool SoundStreamInputBackend::start(ofBaseSoundInput * listener, int sample_rate, int buffer_size,
+                                    int number_of_channels) {
+    
+    stop();
+    
+    sound_stream_.setInput(listener);
+    
+    if (!sound_stream_.setup(0, number_of_channels, sample_rate, buffer_size, kNumberOfStreamBuffers)) {
+        
+        ofLogError("SoundStreamInputBackend") << "Could not open the sound input at " << sample_rate << " Hz";
+        return false;
+        
+    }
+    
+    is_open_ = true;
+    sample_rate_ = sample_rate;
+    
+    return true;
+    
+}
+
+/**
+ * Closes the sound stream.
+ */
+void SoundStreamInputBackend::stop() {
+    
+    if (is_open_) {
+        
+        sound_stream_.close();
+        is_open_ = false;
+        
+    }
+    
+}
+
+/**
+ * Getter for the sample rate of the sound stream.
+ */
+int SoundStreamInputBackend::getSampleRate() const {
+    
+    return sample_rate_;
+    
+}
+
+/**
+ * Getter for the name of the backend (to be displayed).
+ */
+std::string SoundStreamInputBackend::getName() const {
+    
+    return "Sound Input";
+    
+}
@@ -0,0 +1,58 @@
+//
+//  SoundStreamInputBackend.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef SoundStreamInputBackend_h
+#define SoundStreamInputBackend_h
+
+#include "AudioInputBackend.h"
+
+/**
+ * Class that delivers the blocks captured from the default sound input device, through an ofSoundStream.
+ */
+class SoundStreamInputBackend : public AudioInputBackend {
+    
+    ofSoundStream sound_stream_; // the sound stream the blocks are captured from
+    
+    bool is_open_; // whether the sound stream is open
+    
+    int sample_rate_; // the sample rate of the sound stream
+    
+public:
+    
+    /**
+     * Constructor for a SoundStreamInputBackend object, which does not open the sound stream yet.
+     */
+    SoundStreamInputBackend() noexcept;
+    
+    /**
+     * Destructor for a SoundStreamInputBackend object, which closes the sound stream.
+     */
+    ~SoundStreamInputBackend();
+    
+    /**
+     * Opens the sound stream, which delivers its blocks to the listener.
+     */
+    bool start(ofBaseSoundInput * listener, int sample_rate, int buffer_size, int number_of_channels);
+    
+    /**
+     * Closes the sound stream.
+     */
+    void stop();
+    
+    /**
+     * Getter for the sample rate of the sound stream.
+     */
+    int getSampleRate() const;
+    
+    /**
+     * Getter for the name of the backend (to be displayed).
+     */
+    std::string getName() const;
+    
+};
+
+#endif /* SoundStreamInputBackend_h */
@@ -0,0 +1,133 @@
+//
+//  SpectrumAnalyzer.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "SpectrumAnalyzer.h"
+#include <algorithm>
+#include <cmath>
+
+const int kMinimumNumberOfFftBins = 64; // the smallest number of bins analyzed (as with FMOD)
+
+const int kMaximumNumberOfBands = 8192; // the largest number of bands that can be asked for (as with FMOD)
+
+/**
+ * Constructor for a SpectrumAnalyzer object.
+ */
+SpectrumAnalyzer::SpectrumAnalyzer() noexcept {
+    
+    window_sum_ = 0;
+    
+}
+
+/**
+ * Returns the FFT size used for the given number of bands.
+ */
+int SpectrumAnalyzer::getFftSize(int number_of_bands) {
+    
+    // The number of bins is the next power of 2 of the number of bands, and the FFT is twice as large.
+    
+    int number_of_bins = kMinimumNumberOfFftBins;
+    
+    while (number_of_bins < number_of_bands && number_of_bins < kMaximumNumberOfBands) {
+        number_of_bins *= 2;
+    }
+    
+    return 2 * number_of_bins;
+    
+}
+
+/**
+ * Computes the window function, and gets the FFT plan, for the given FFT size.
+ */
+void SpectrumAnalyzer::setupFft(int fft_size) {
+    
+    fft_plan_ = FftBackend::getPlan(fft_size);
+    
+    window_.resize(fft_size);
+    windowed_samples_.resize(fft_size);
+    fft_buffer_.resize(fft_size / 2 + 1);
+    magnitudes_.resize(fft_size / 2);
+    
+    window_sum_ = 0;
+    
+    for (int index = 0; index < fft_size; index++) {
+        
+        window_[index] = 0.5f * (1 - cos(2 * M_PI * index / (fft_size - 1)));
+        window_sum_ += window_[index];
+    }
+    
+}
+
+/**
+ * Computes the spectrum band values of a window of samples (mixed down to mono).
+ */
+const std::vector<float> & SpectrumAnalyzer::getSpectrum(const float * samples, int number_of_channels,
+                                                         int number_of_bands) {
+    
+    int fft_size = getFftSize(number_of_bands);
+    
+    if (!fft_plan_ || fft_size != fft_plan_->getSize()) {
+        setupFft(fft_size);
+    }
+    
+    // Mix the channels down to mono (the mixer's default mode).
+    
+    if (number_of_channels > 1) {
+        
+        mixer_.mix(samples, fft_size, number_of_channels);
+        samples = mixer_.getChannel(0);
+    }
+    
+    // Window the samples, and transform them.
+    
+    for (int index = 0; index < fft_size; index++) {
+        windowed_samples_[index] = samples[index] * window_[index];
+    }
+    
+    fft_plan_->transform(windowed_samples_.data(), fft_buffer_.data());
+    
+    // Normalize the magnitudes so that a full-scale sine reads about 1,
+    // then convert them to the scale ofSoundGetSpectrum() uses.
+    
+    int number_of_bins = fft_size / 2;
+    
+    for (int bin = 0; bin < number_of_bins; bin++) {
+        
+        float magnitude = 2 * std::abs(fft_buffer_[bin]) / window_sum_;
+        magnitudes_[bin] = 10.0f * log10(1 + magnitude) * 2.0f;
+    }
+    
+    // Fit the bins into the number of bands, averaging the bins (and fractions of bins) that
+    // fall in each band, and capping the averages at 1 (as ofSoundGetSpectrum() does).
+    
+    spectrum_.assign(number_of_bands, 0);
+    
+    if (number_of_bins == number_of_bands) {
+        
+        std::copy(magnitudes_.begin(), magnitudes_.end(), spectrum_.begin());
+        return spectrum_;
+        
+    }
+    
+    float step = (float) number_of_bins / number_of_bands;
+    
+    for (int band = 0; band < number_of_bands; band++) {
+        
+        float band_start = band * step;
+        float band_end = band_start + step;
+        
+        for (int bin = (int) band_start; bin < number_of_bins && bin < band_end; bin++) {
+            
+            float overlap = std::min(band_end, (float) bin + 1) - std::max(band_start, (float) bin);
+            spectrum_[band] += overlap * magnitudes_[bin];
+        }
+        
+        spectrum_[band] = std::min(spectrum_[band] / step, 1.0f);
+    }
+    
+    return spectrum_;
+    
+}
@@ -0,0 +1,71 @@
+//
+//  SpectrumAnalyzer.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef SpectrumAnalyzer_h
+#define SpectrumAnalyzer_h
+
+#include "FftBackend.h"
+#include "ChannelMixer.h"
+#include <memory>
+#include <complex>
+#include <vector>
+
+/**
+ * Class that computes the spectrum band values the moving graph visualizers react to,
+ * the same way ofSoundGetSpectrum() does for the FMOD sound player: a Hann-windowed FFT of
+ * (2 * the next power of 2 of) the number of bands, with magnitudes converted to 20 * log10(1 + magnitude).
+ *
+ * The window function is computed once per FFT size, and the FFT plan is shared (see FftBackend).
+ */
+class SpectrumAnalyzer {
+    
+    std::shared_ptr<const FftPlan> fft_plan_; // the plan of the FFT (null till the first spectrum is computed)
+    
+    std::vector<float> window_; // the Hann window
+    
+    float window_sum_; // the sum of the Hann window (which the magnitudes are normalized by)
+    
+    ChannelMixer mixer_; // the mixer which mixes the channels of the analyzed samples down to mono
+    
+    std::vector<float> windowed_samples_; // the windowed samples the FFT is computed of
+    
+    std::vector<std::complex<float> > fft_buffer_; // the bins of the FFT
+    
+    std::vector<float> magnitudes_; // the (log-scaled) magnitude of each FFT bin
+    
+    std::vector<float> spectrum_; // the spectrum band values
+    
+    /**
+     * Computes the window function, and gets the FFT plan, for the given FFT size.
+     */
+    void setupFft(int fft_size);
+    
+public:
+    
+    /**
+     * Constructor for a SpectrumAnalyzer object.
+     */
+    SpectrumAnalyzer() noexcept;
+    
+    /**
+     * Returns the FFT size used for the given number of bands.
+     */
+    static int getFftSize(int number_of_bands);
+    
+    /**
+     * Computes the spectrum band values of a window of samples (mixed down to mono).
+     *
+     * @param samples - the most recent getFftSize(number_of_bands) frames of interleaved samples
+     * @param number_of_channels - the number of interleaved channels
+     * @param number_of_bands - the number of spectrum bands
+     * @return the spectrum band values (valid till the next call)
+     */
+    const std::vector<float> & getSpectrum(const float * samples, int number_of_channels, int number_of_bands);
+    
+};
+
+#endif /* SpectrumAnalyzer_h */
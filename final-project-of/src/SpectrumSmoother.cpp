@@ -0,0 +1,230 @@
+//
+//  SpectrumSmoother.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "SpectrumSmoother.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define SPECTRUM_SMOOTHER_USE_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SPECTRUM_SMOOTHER_USE_NEON 1
+#endif
+
+const float kDefaultReleaseSeconds = 0.27f; // the release time which decays as much per second as a factor of 0.94
+                                            // every frame does at 60 frames per second (-1 / (60 * ln 0.94))
+
+/**
+ * Returns the fraction of the distance to a new value which is still to go after the given time,
+ * when it is followed with the given time constant (0 if it is followed at once).
+ */
+static float getRetention(float time_constant_seconds, float delta_seconds) {
+
+    if (time_constant_seconds <= 0) {
+        return 0;
+    }
+
+    return exp(- delta_seconds / time_constant_seconds);
+
+}
+
+#if defined(SPECTRUM_SMOOTHER_USE_SSE)
+
+/**
+ * Picks the lanes of if_true where the mask is set, and the lanes of if_false elsewhere.
+ */
+static inline __m128 select(__m128 mask, __m128 if_true, __m128 if_false) {
+
+    return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false));
+
+}
+
+#endif
+
+/**
+ * Constructor for a SpectrumSmoother object, which decays with a release time of 0.27 seconds.
+ */
+SpectrumSmoother::SpectrumSmoother() noexcept {
+
+    setup(SMOOTHING_MODE_DECAY, 0, kDefaultReleaseSeconds);
+
+}
+
+/**
+ * Sets the way the values are smoothed, and its time constants.
+ */
+void SpectrumSmoother::setup(SmoothingMode mode, float attack_seconds, float release_seconds, float hold_seconds) {
+
+    mode_ = mode;
+    attack_seconds_ = attack_seconds;
+    release_seconds_ = release_seconds;
+    hold_seconds_ = hold_seconds;
+
+}
+
+/**
+ * Sets all the values back to zero.
+ */
+void SpectrumSmoother::reset() {
+
+    std::fill(values_.begin(), values_.end(), 0.0f);
+    std::fill(hold_times_.begin(), hold_times_.end(), 0.0f);
+
+}
+
+/**
+ * Smooths new values into the values so far.
+ */
+const std::vector<float> & SpectrumSmoother::process(const float * new_values, int number_of_values,
+                                                     float delta_seconds) {
+
+    if ((int) values_.size() != number_of_values) {
+
+        values_.assign(number_of_values, 0);
+        hold_times_.assign(number_of_values, 0);
+    }
+
+    delta_seconds = std::max(delta_seconds, 0.0f);
+
+    // Work out how much of a rise (or fall) is still to go after this update.
+
+    float attack_retention = getRetention(attack_seconds_, delta_seconds);
+    float release_retention = getRetention(release_seconds_, delta_seconds);
+
+    float * values = values_.data();
+    float * hold_times = hold_times_.data();
+
+    int index = 0;
+
+#if defined(SPECTRUM_SMOOTHER_USE_SSE)
+
+    __m128 attack = _mm_set1_ps(attack_retention);
+    __m128 release = _mm_set1_ps(release_retention);
+    __m128 hold = _mm_set1_ps(hold_seconds_);
+    __m128 delta = _mm_set1_ps(delta_seconds);
+    __m128 zero = _mm_setzero_ps();
+
+    for (; index + 4 <= number_of_values; index += 4) {
+
+        __m128 value = _mm_loadu_ps(values + index);
+        __m128 new_value = _mm_loadu_ps(new_values + index);
+
+        if (mode_ == SMOOTHING_MODE_DECAY) {
+
+            value = _mm_max_ps(_mm_mul_ps(value, release), new_value);
+
+        } else if (mode_ == SMOOTHING_MODE_ATTACK_RELEASE) {
+
+            __m128 retention = select(_mm_cmpgt_ps(new_value, value), attack, release);
+            value = _mm_add_ps(new_value, _mm_mul_ps(_mm_sub_ps(value, new_value), retention));
+
+        } else {
+
+            __m128 hold_time = _mm_loadu_ps(hold_times + index);
+
+            __m128 is_rising = _mm_cmpge_ps(new_value, value);
+            __m128 is_holding = _mm_cmpgt_ps(hold_time, zero);
+
+            __m128 decayed_value = _mm_max_ps(_mm_mul_ps(value, release), new_value);
+
+            value = select(is_rising, new_value, select(is_holding, value, decayed_value));
+            hold_time = select(is_rising, hold, _mm_sub_ps(hold_time, delta));
+
+            _mm_storeu_ps(hold_times + index, hold_time);
+        }
+
+        _mm_storeu_ps(values + index, value);
+    }
+
+#elif defined(SPECTRUM_SMOOTHER_USE_NEON)
+
+    float32x4_t hold = vdupq_n_f32(hold_seconds_);
+    float32x4_t delta = vdupq_n_f32(delta_seconds);
+    float32x4_t zero = vdupq_n_f32(0);
+
+    for (; index + 4 <= number_of_values; index += 4) {
+
+        float32x4_t value = vld1q_f32(values + index);
+        float32x4_t new_value = vld1q_f32(new_values + index);
+
+        if (mode_ == SMOOTHING_MODE_DECAY) {
+
+            value = vmaxq_f32(vmulq_n_f32(value, release_retention), new_value);
+
+        } else if (mode_ == SMOOTHING_MODE_ATTACK_RELEASE) {
+
+            float32x4_t retention = vbslq_f32(vcgtq_f32(new_value, value), vdupq_n_f32(attack_retention),
+                                              vdupq_n_f32(release_retention));
+            value = vmlaq_f32(new_value, vsubq_f32(value, new_value), retention);
+
+        } else {
+
+            float32x4_t hold_time = vld1q_f32(hold_times + index);
+
+            uint32x4_t is_rising = vcgeq_f32(new_value, value);
+            uint32x4_t is_holding = vcgtq_f32(hold_time, zero);
+
+            float32x4_t decayed_value = vmaxq_f32(vmulq_n_f32(value, release_retention), new_value);
+
+            value = vbslq_f32(is_rising, new_value, vbslq_f32(is_holding, value, decayed_value));
+            hold_time = vbslq_f32(is_rising, hold, vsubq_f32(hold_time, delta));
+
+            vst1q_f32(hold_times + index, hold_time);
+        }
+
+        vst1q_f32(values + index, value);
+    }
+
+#endif
+
+    for (; index < number_of_values; index++) {
+
+        float value = values[index];
+        float new_value = new_values[index];
+
+        if (mode_ == SMOOTHING_MODE_DECAY) {
+
+            value = std::max(value * release_retention, new_value);
+
+        } else if (mode_ == SMOOTHING_MODE_ATTACK_RELEASE) {
+
+            float retention = (new_value > value) ? attack_retention : release_retention;
+            value = new_value + (value - new_value) * retention;
+
+        } else if (new_value >= value) {
+
+            // A new peak: hold it.
+
+            value = new_value;
+            hold_times[index] = hold_seconds_;
+
+        } else {
+
+            if (hold_times[index] <= 0) {
+                value = std::max(value * release_retention, new_value);
+            }
+
+            hold_times[index] -= delta_seconds;
+        }
+
+        values[index] = value;
+    }
+
+    return values_;
+
+}
+
+/**
+ * Getter for the smoothed value of each band.
+ */
+const std::vector<float> & SpectrumSmoother::getValues() const {
+
+    return values_;
+
+}
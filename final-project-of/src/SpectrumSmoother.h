@@ -0,0 +1,86 @@
+//
+//  SpectrumSmoother.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef SpectrumSmoother_h
+#define SpectrumSmoother_h
+
+#include <vector>
+
+/**
+ * The ways the values of a spectrum can be smoothed from one update to the next.
+ */
+enum SmoothingMode {
+    SMOOTHING_MODE_DECAY, // a rise is followed at once, and a fall decays exponentially (with the release time)
+    SMOOTHING_MODE_ATTACK_RELEASE, // a rise is followed with the attack time, and a fall with the release time
+    SMOOTHING_MODE_PEAK_HOLD // a rise is followed at once and held for the hold time, then decays (with the release time)
+};
+
+/**
+ * Class that smooths the values of a spectrum (or of any set of bands) over time, so that they change
+ * smoothly enough to be pleasant to watch.
+ *
+ * The time constants are in seconds, and every update is given the time since the last one, so the values
+ * move as fast whatever the frame rate (or hop size) they are updated at. The per-update coefficients are
+ * worked out once per update, and all the bands are then smoothed in one vectorized pass (SSE on x86, NEON
+ * on ARM, with a scalar fallback).
+ */
+class SpectrumSmoother {
+
+    SmoothingMode mode_; // the way the values are smoothed
+
+    float attack_seconds_; // the time constant (in seconds) of a rise, in the SMOOTHING_MODE_ATTACK_RELEASE mode
+
+    float release_seconds_; // the time constant (in seconds) of a fall
+
+    float hold_seconds_; // the time (in seconds) a peak is held, in the SMOOTHING_MODE_PEAK_HOLD mode
+
+    std::vector<float> values_; // the smoothed value of each band
+
+    std::vector<float> hold_times_; // the time (in seconds) each band's peak is still to be held for
+
+public:
+
+    /**
+     * Constructor for a SpectrumSmoother object, which decays with a release time of 0.27 seconds
+     * (as multiplying the values by 0.94 every frame does, at 60 frames per second).
+     */
+    SpectrumSmoother() noexcept;
+
+    /**
+     * Sets the way the values are smoothed, and its time constants.
+     *
+     * @param mode - the way the values are smoothed
+     * @param attack_seconds - the time constant of a rise (0 to follow rises at once)
+     * @param release_seconds - the time constant of a fall (0 to follow falls at once)
+     * @param hold_seconds - the time a peak is held (in the SMOOTHING_MODE_PEAK_HOLD mode)
+     */
+    void setup(SmoothingMode mode, float attack_seconds, float release_seconds, float hold_seconds = 0);
+
+    /**
+     * Sets all the values back to zero.
+     */
+    void reset();
+
+    /**
+     * Smooths new values into the values so far. If there are not as many new values as before,
+     * the smoothing starts over from zero.
+     *
+     * @param new_values - the new value of each band
+     * @param number_of_values - the number of bands
+     * @param delta_seconds - the time (in seconds) since the last update
+     * @return the smoothed value of each band (valid till the next call)
+     */
+    const std::vector<float> & process(const float * new_values, int number_of_values, float delta_seconds);
+
+    /**
+     * Getter for the smoothed value of each band.
+     */
+    const std::vector<float> & getValues() const;
+
+};
+
+#endif /* SpectrumSmoother_h */
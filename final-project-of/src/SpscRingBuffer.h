@@ -0,0 +1,130 @@
+//
+//  SpscRingBuffer.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef SpscRingBuffer_h
+#define SpscRingBuffer_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Class template that models a lock-free single-producer, single-consumer ring buffer
+ * (e.g. for handing audio samples from the audio thread to the main thread).
+ *
+ * Exactly one thread may push, and exactly one (other) thread may pop. Neither ever blocks:
+ * push() only writes as many values as there is space for, and pop() only reads as many as are available.
+ *
+ * The capacity is a power of 2, so that the (ever-increasing) read and write positions
+ * can be mapped to the storage with a mask.
+ */
+template <typename T>
+class SpscRingBuffer {
+    
+    std::vector<T> storage_; // the storage of the ring buffer
+    
+    size_t mask_; // the capacity of the ring buffer minus one
+    
+    std::atomic<size_t> write_position_; // the number of values pushed so far (only written by the producer)
+    
+    std::atomic<size_t> read_position_; // the number of values popped so far (only written by the consumer)
+    
+public:
+    
+    /**
+     * Constructor for an (empty) SpscRingBuffer object, with no capacity.
+     */
+    SpscRingBuffer() noexcept : mask_(0), write_position_(0), read_position_(0) {}
+    
+    /**
+     * Allocates the storage of the ring buffer, for at least the given number of values, and empties it.
+     * This must not be called while the producer or the consumer is using the ring buffer.
+     */
+    void allocate(size_t minimum_capacity) {
+        
+        size_t capacity = 1;
+        
+        while (capacity < minimum_capacity) {
+            capacity *= 2;
+        }
+        
+        storage_.assign(capacity, T());
+        mask_ = capacity - 1;
+        
+        write_position_ = 0;
+        read_position_ = 0;
+        
+    }
+    
+    /**
+     * Getter for the number of values the ring buffer can hold.
+     */
+    size_t capacity() const {
+        return storage_.size();
+    }
+    
+    /**
+     * Returns the number of values which can be popped (only exact when called by the consumer).
+     */
+    size_t getReadAvailable() const {
+        return write_position_.load(std::memory_order_acquire) - read_position_.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * Returns the number of values which can be pushed (only exact when called by the producer).
+     */
+    size_t getWriteAvailable() const {
+        return storage_.size() - (write_position_.load(std::memory_order_relaxed)
+                                  - read_position_.load(std::memory_order_acquire));
+    }
+    
+    /**
+     * Pushes up to the given number of values (as many as there is space for). Only called by the producer.
+     *
+     * @return the number of values pushed
+     */
+    size_t push(const T * values, size_t number_of_values) {
+        
+        size_t write_position = write_position_.load(std::memory_order_relaxed);
+        number_of_values = std::min(number_of_values, getWriteAvailable());
+        
+        for (size_t index = 0; index < number_of_values; index++) {
+            storage_[(write_position + index) & mask_] = values[index];
+        }
+        
+        // Publish the values to the consumer.
+        write_position_.store(write_position + number_of_values, std::memory_order_release);
+        
+        return number_of_values;
+        
+    }
+    
+    /**
+     * Pops up to the given number of values (as many as are available). Only called by the consumer.
+     *
+     * @return the number of values popped
+     */
+    size_t pop(T * values, size_t number_of_values) {
+        
+        size_t read_position = read_position_.load(std::memory_order_relaxed);
+        number_of_values = std::min(number_of_values, getReadAvailable());
+        
+        for (size_t index = 0; index < number_of_values; index++) {
+            values[index] = storage_[(read_position + index) & mask_];
+        }
+        
+        // Hand the space back to the producer.
+        read_position_.store(read_position + number_of_values, std::memory_order_release);
+        
+        return number_of_values;
+        
+    }
+    
+};
+
+#endif /* SpscRingBuffer_h */
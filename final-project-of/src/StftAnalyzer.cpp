@@ -0,0 +1,191 @@
+//
+//  StftAnalyzer.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "StftAnalyzer.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Constructor for a StftAnalyzer object, with windows of 2048 frames every 512 frames.
+ */
+StftAnalyzer::StftAnalyzer() noexcept {
+    
+    setup(2048, 512, 32);
+    
+}
+
+/**
+ * Sets the size of the windows (a power of 2) and of the hop between them, and the number of spectra kept.
+ */
+void StftAnalyzer::setup(int window_size, int hop_size, int number_of_spectra_kept) {
+    
+    framer_.setup(window_size, hop_size);
+    fft_plan_ = FftBackend::getPlan(window_size);
+    
+    window_function_.resize(window_size);
+    windowed_samples_.resize(window_size);
+    fft_output_.resize(window_size / 2 + 1);
+    
+    window_sum_ = 0;
+    
+    for (int index = 0; index < window_size; index++) {
+        
+        window_function_[index] = 0.5f * (1 - cos(2 * M_PI * index / (window_size - 1)));
+        window_sum_ += window_function_[index];
+    }
+    
+    spectra_.assign(std::max(number_of_spectra_kept, 2), std::vector<float>(getNumberOfBins(), 0));
+    
+    number_of_spectra_ = 0;
+    reset();
+    
+}
+
+/**
+ * Drops the spectra (and samples) so far.
+ */
+void StftAnalyzer::reset() {
+    
+    framer_.reset();
+    
+    first_spectrum_ = number_of_spectra_;
+    first_spectrum_center_frame_ = 0;
+    
+}
+
+/**
+ * Getter for the number of frames in a window.
+ */
+int StftAnalyzer::getWindowSize() const {
+    
+    return framer_.getWindowSize();
+    
+}
+
+/**
+ * Getter for the number of frames from the start of a window to the start of the next.
+ */
+int StftAnalyzer::getHopSize() const {
+    
+    return framer_.getHopSize();
+    
+}
+
+/**
+ * Getter for the number of bins of a spectrum (from 0 Hz up to half the sample rate).
+ */
+int StftAnalyzer::getNumberOfBins() const {
+    
+    return framer_.getWindowSize() / 2 + 1;
+    
+}
+
+/**
+ * Pushes frames of the stream, and computes the spectra of the windows they complete.
+ */
+int StftAnalyzer::push(const float * samples, int number_of_frames, int number_of_channels, long long start_frame) {
+    
+    framer_.push(samples, number_of_frames, number_of_channels, start_frame);
+    
+    const float * window;
+    long long window_start_frame;
+    
+    int spectra_computed = 0;
+    
+    while (framer_.popWindow(window, window_start_frame)) {
+        
+        addSpectrum(window, framer_.getNumberOfChannels(), window_start_frame);
+        spectra_computed++;
+    }
+    
+    return spectra_computed;
+    
+}
+
+/**
+ * Computes the spectrum of a window, and adds it to the stream.
+ */
+void StftAnalyzer::addSpectrum(const float * window, int number_of_channels, long long window_start_frame) {
+    
+    int window_size = framer_.getWindowSize();
+    long long center_frame = window_start_frame + window_size / 2;
+    
+    // If this window is not a hop after the one before, the stream has started over (the framer was reset):
+    // a new run of spectra starts with it.
+    
+    long long expected_center_frame = first_spectrum_center_frame_
+                                    + (number_of_spectra_ - first_spectrum_) * framer_.getHopSize();
+    
+    if (number_of_spectra_ == first_spectrum_ || center_frame != expected_center_frame) {
+        
+        first_spectrum_ = number_of_spectra_;
+        first_spectrum_center_frame_ = center_frame;
+    }
+    
+    // Mix the channels down to mono, and window them.
+    
+    for (int frame = 0; frame < window_size; frame++) {
+        
+        float sum = 0;
+        
+        for (int channel = 0; channel < number_of_channels; channel++) {
+            sum += window[frame * number_of_channels + channel];
+        }
+        
+        windowed_samples_[frame] = sum / number_of_channels * window_function_[frame];
+    }
+    
+    fft_plan_->transform(windowed_samples_.data(), fft_output_.data());
+    
+    // Normalize the magnitudes so that a full-scale sine reads about 1.
+    
+    std::vector<float> & spectrum = spectra_[number_of_spectra_ % spectra_.size()];
+    
+    for (int bin = 0; bin < (int) spectrum.size(); bin++) {
+        spectrum[bin] = 2 * std::abs(fft_output_[bin]) / window_sum_;
+    }
+    
+    number_of_spectra_++;
+    
+}
+
+/**
+ * Samples the stream of spectra at a position in the stream, interpolating between the spectra whose windows
+ * are centered around it.
+ */
+bool StftAnalyzer::sample(double frame, std::vector<float> & magnitudes) const {
+    
+    // Only the spectra of the current run which are still kept can be sampled.
+    
+    long long oldest_spectrum = std::max(first_spectrum_, number_of_spectra_ - (long long) spectra_.size());
+    long long newest_spectrum = number_of_spectra_ - 1;
+    
+    if (newest_spectrum < oldest_spectrum) {
+        return false;
+    }
+    
+    // The spectra of a run are centered a hop apart.
+    
+    double position = (frame - first_spectrum_center_frame_) / framer_.getHopSize() + first_spectrum_;
+    position = std::min(std::max(position, (double) oldest_spectrum), (double) newest_spectrum);
+    
+    long long earlier_spectrum = (long long) position;
+    long long later_spectrum = std::min(earlier_spectrum + 1, newest_spectrum);
+    float weight = (float) (position - earlier_spectrum);
+    
+    const std::vector<float> & earlier = spectra_[earlier_spectrum % spectra_.size()];
+    const std::vector<float> & later = spectra_[later_spectrum % spectra_.size()];
+    
+    magnitudes.resize(earlier.size());
+    
+    for (int bin = 0; bin < (int) earlier.size(); bin++) {
+        magnitudes[bin] = earlier[bin] + (later[bin] - earlier[bin]) * weight;
+    }
+    
+    return true;
+    
+}
@@ -0,0 +1,111 @@
+//
+//  StftAnalyzer.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef StftAnalyzer_h
+#define StftAnalyzer_h
+
+#include "FftBackend.h"
+#include "HopFramer.h"
+#include <complex>
+#include <memory>
+#include <vector>
+
+/**
+ * Class that computes the short-time Fourier transform (STFT) of a stream of samples: the magnitude spectrum
+ * of a Hann-windowed window of window_size frames, every hop_size frames, over every frame pushed
+ * (however often, and however many frames at a time, they are pushed).
+ *
+ * The most recent spectra are kept as a continuous stream, which the visualizers sample at the position
+ * in the stream they are drawing (interpolating between the spectra around it), so that what they show
+ * does not depend on the frame rate.
+ *
+ * The magnitudes are normalized so that a full-scale sine reads about 1 (as Essentia's normalized
+ * windowing does).
+ */
+class StftAnalyzer {
+    
+    HopFramer framer_; // the framer which cuts the stream into overlapping windows
+    
+    std::shared_ptr<const FftPlan> fft_plan_; // the plan of the FFT (shared with the other analyzers)
+    
+    std::vector<float> window_function_; // the Hann window
+    
+    float window_sum_; // the sum of the Hann window (which the magnitudes are normalized by)
+    
+    std::vector<float> windowed_samples_; // the (mono) windowed samples the FFT is computed of
+    
+    std::vector<std::complex<float> > fft_output_; // the bins of the FFT
+    
+    std::vector<std::vector<float> > spectra_; // the most recent spectra, spectrum i being at i % spectra_.size()
+    
+    long long number_of_spectra_; // the number of spectra computed so far
+    
+    long long first_spectrum_; // the first spectrum of the current run (spectra before it are of another stream)
+    
+    long long first_spectrum_center_frame_; // the position in the stream of the center of the first spectrum's window
+    
+    /**
+     * Computes the spectrum of a window, and adds it to the stream.
+     */
+    void addSpectrum(const float * window, int number_of_channels, long long window_start_frame);
+    
+public:
+    
+    /**
+     * Constructor for a StftAnalyzer object, with windows of 2048 frames every 512 frames.
+     */
+    StftAnalyzer() noexcept;
+    
+    /**
+     * Sets the size of the windows (a power of 2) and of the hop between them, and the number of spectra kept.
+     */
+    void setup(int window_size, int hop_size, int number_of_spectra_kept);
+    
+    /**
+     * Drops the spectra (and samples) so far.
+     */
+    void reset();
+    
+    /**
+     * Getter for the number of frames in a window.
+     */
+    int getWindowSize() const;
+    
+    /**
+     * Getter for the number of frames from the start of a window to the start of the next.
+     */
+    int getHopSize() const;
+    
+    /**
+     * Getter for the number of bins of a spectrum (from 0 Hz up to half the sample rate).
+     */
+    int getNumberOfBins() const;
+    
+    /**
+     * Pushes frames of the stream, and computes the spectra of the windows they complete.
+     *
+     * @param samples - the interleaved samples of the frames (mixed down to mono for the analysis)
+     * @param number_of_frames - the number of frames
+     * @param number_of_channels - the number of interleaved channels
+     * @param start_frame - the position in the stream of the first frame
+     * @return the number of spectra computed
+     */
+    int push(const float * samples, int number_of_frames, int number_of_channels, long long start_frame);
+    
+    /**
+     * Samples the stream of spectra at a position in the stream, interpolating between the spectra whose windows
+     * are centered around it. (Before the first spectrum kept, or after the last, the nearest one is used.)
+     *
+     * @param frame - the position in the stream
+     * @param magnitudes - set to the magnitudes of each bin
+     * @return whether there was a spectrum to sample
+     */
+    bool sample(double frame, std::vector<float> & magnitudes) const;
+    
+};
+
+#endif /* StftAnalyzer_h */
@@ -0,0 +1,341 @@
+//
+//  StreamingTrack.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "StreamingTrack.h"
+#include "audiodecoder.h"
+#include <limits>
+
+const float kSecondsDecodedAhead = 4.0f; // how far ahead of the playhead the frames are decoded
+
+const float kSecondsKeptBehind = 1.0f; // how long the frames are kept after they are played
+                                       // (the spectrum is computed from the frames just before the playhead)
+
+const int kDecodeChunkFrames = 4096; // the number of frames decoded at a time
+
+/**
+ * Constructor for an (empty) StreamingTrack object.
+ */
+StreamingTrack::StreamingTrack() noexcept {
+    
+    number_of_channels_ = 2;
+    sample_rate_ = 44100;
+    number_of_frames_ = 0;
+    ring_buffer_capacity_ = 0;
+    buffer_start_frame_ = 0;
+    buffer_end_frame_ = 0;
+    playhead_frame_ = 0;
+    decoder_frame_ = 0;
+    has_decoded_to_end_ = false;
+    is_running_ = false;
+    
+}
+
+/**
+ * Destructor for a StreamingTrack object, which stops the decode thread.
+ */
+StreamingTrack::~StreamingTrack() {
+    
+    stop();
+    
+}
+
+/**
+ * Opens the audio (.wav or .mp3) file at the given path (relative to the data directory),
+ * without decoding it yet.
+ *
+ * @return whether the file could be opened
+ */
+bool StreamingTrack::load(const std::string & path) {
+    
+    stop();
+    
+    decoder_.reset(new AudioDecoder(ofToDataPath(path)));
+    
+    if (decoder_->open() != AUDIODECODER_OK) {
+        
+        ofLogError("StreamingTrack") << "Could not decode " << path;
+        decoder_.reset();
+        return false;
+        
+    }
+    
+    path_ = path;
+    number_of_channels_ = decoder_->channels();
+    sample_rate_ = decoder_->sampleRate();
+    number_of_frames_ = decoder_->numSamples() / number_of_channels_;
+    
+    // The ring buffer holds the frames kept behind the playhead, the frames decoded ahead of it,
+    // and the chunk which is decoded when the frames ahead run low.
+    
+    ring_buffer_capacity_ = (long long) ((kSecondsDecodedAhead + kSecondsKeptBehind) * sample_rate_) + kDecodeChunkFrames;
+    
+    ring_buffer_.assign(ring_buffer_capacity_ * number_of_channels_, 0);
+    decode_chunk_.resize(kDecodeChunkFrames * number_of_channels_);
+    
+    buffer_start_frame_ = 0;
+    buffer_end_frame_ = 0;
+    playhead_frame_ = 0;
+    decoder_frame_ = 0;
+    has_decoded_to_end_ = false;
+    
+    return true;
+    
+}
+
+/**
+ * Starts the decode thread, which fills the ring buffer from the start of the track.
+ */
+void StreamingTrack::start() {
+    
+    if (is_running_ || !decoder_) {
+        return;
+    }
+    
+    is_running_ = true;
+    decode_thread_ = std::thread(&StreamingTrack::run, this);
+    
+}
+
+/**
+ * Stops the decode thread.
+ */
+void StreamingTrack::stop() {
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        if (!is_running_) {
+            return;
+        }
+        
+        is_running_ = false;
+    }
+    
+    condition_.notify_one();
+    decode_thread_.join();
+    
+}
+
+/**
+ * Returns whether the playhead has left the frames held in (or being decoded into) the ring buffer.
+ */
+bool StreamingTrack::isSeekNeeded() const {
+    
+    long long kept_behind_frames = (long long) (kSecondsKeptBehind * sample_rate_);
+    
+    return playhead_frame_ < buffer_start_frame_
+           || (playhead_frame_ > buffer_end_frame_ + kept_behind_frames);
+    
+}
+
+/**
+ * Returns whether there are frames ahead of the playhead which are yet to be decoded.
+ */
+bool StreamingTrack::isDecodeNeeded() const {
+    
+    long long decoded_ahead_frames = (long long) (kSecondsDecodedAhead * sample_rate_);
+    
+    // The track is decoded till the decoder reports its end, as the number of frames reported up front
+    // can be an estimate (e.g. for mp3 files) which falls short of it.
+    
+    return buffer_end_frame_ < playhead_frame_ + decoded_ahead_frames && !has_decoded_to_end_;
+    
+}
+
+/**
+ * The loop which the decode thread runs.
+ */
+void StreamingTrack::run() {
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    
+    while (true) {
+        
+        condition_.wait(lock, [this] { return !is_running_ || isSeekNeeded() || isDecodeNeeded(); });
+        
+        if (!is_running_) {
+            return;
+        }
+        
+        if (isSeekNeeded()) {
+            
+            // Start decoding again from a little before the playhead.
+            // (A short jump forward is just decoded through, as it would be played through.)
+            
+            long long kept_behind_frames = (long long) (kSecondsKeptBehind * sample_rate_);
+            long long seek_frame = std::max(playhead_frame_ - kept_behind_frames, 0LL);
+            
+            buffer_start_frame_ = seek_frame;
+            buffer_end_frame_ = seek_frame;
+            has_decoded_to_end_ = false;
+            
+            // The decoder takes the position as an int number of samples, so a frame past the last one it can
+            // seek to (over 3 hours into a stereo track) is reached by decoding through from there.
+            // (If the decoder is already on its way there, it just carries on.)
+            
+            long long last_seekable_frame = std::numeric_limits<int>::max() / number_of_channels_;
+            long long decoder_seek_frame = std::min(seek_frame, last_seekable_frame);
+            
+            if (decoder_frame_ < decoder_seek_frame || decoder_frame_ > seek_frame) {
+                
+                // Seek without holding the lock (seeking an mp3 file can take a while).
+                
+                lock.unlock();
+                
+                decoder_->seek((int) (decoder_seek_frame * number_of_channels_));
+                decoder_frame_ = decoder_seek_frame;
+                
+                lock.lock();
+            }
+            
+            continue;
+        }
+        
+        // Decode the next chunk without holding the lock, so that the audio thread is never kept waiting.
+        
+        lock.unlock();
+        
+        int samples_read = decoder_->read((int) decode_chunk_.size(), decode_chunk_.data());
+        int frames_read = std::max(samples_read, 0) / number_of_channels_;
+        
+        long long chunk_start_frame = decoder_frame_;
+        decoder_frame_ += frames_read;
+        
+        lock.lock();
+        
+        if (frames_read == 0) {
+            
+            // The number of frames reported up front can be an estimate (e.g. for mp3 files).
+            
+            has_decoded_to_end_ = true;
+            number_of_frames_ = decoder_frame_;
+            continue;
+        }
+        
+        // If the playhead moved away while the chunk was decoded, the chunk is dropped (the next pass seeks).
+        // Otherwise, the frames of the chunk before the ones to be buffered (when decoding through to them
+        // after a seek) are dropped, and the rest are added to the ring buffer.
+        
+        if (isSeekNeeded() || decoder_frame_ <= buffer_end_frame_) {
+            continue;
+        }
+        
+        int first_frame = (int) std::max(buffer_end_frame_ - chunk_start_frame, 0LL);
+        
+        for (int frame = first_frame; frame < frames_read; frame++) {
+            
+            long long ring_buffer_index = ((chunk_start_frame + frame) % ring_buffer_capacity_) * number_of_channels_;
+            
+            for (int channel = 0; channel < number_of_channels_; channel++) {
+                ring_buffer_[ring_buffer_index + channel] = decode_chunk_[frame * number_of_channels_ + channel];
+            }
+        }
+        
+        buffer_end_frame_ = decoder_frame_;
+        buffer_start_frame_ = std::max(buffer_start_frame_, buffer_end_frame_ - ring_buffer_capacity_);
+        
+        // The track goes on past the number of frames estimated up front, if the estimate fell short.
+        
+        if (buffer_end_frame_ > number_of_frames_) {
+            number_of_frames_ = buffer_end_frame_;
+        }
+    }
+    
+}
+
+/**
+ * Getter for the path of the audio file the track is decoded from.
+ */
+const std::string & StreamingTrack::getPath() const {
+    
+    return path_;
+    
+}
+
+/**
+ * Getter for the number of channels of the track.
+ */
+int StreamingTrack::getNumberOfChannels() const {
+    
+    return number_of_channels_;
+    
+}
+
+/**
+ * Getter for the sample rate of the track.
+ */
+int StreamingTrack::getSampleRate() const {
+    
+    return sample_rate_;
+    
+}
+
+/**
+ * Getter for the number of frames (samples per channel) of the track.
+ * For mp3 files, this is an estimate till the end of the track has been decoded.
+ */
+long long StreamingTrack::getNumberOfFrames() const {
+    
+    return number_of_frames_;
+    
+}
+
+/**
+ * Returns the number of bytes of memory the samples of the track take up.
+ */
+size_t StreamingTrack::getMemoryUsage() const {
+    
+    return (ring_buffer_.capacity() + decode_chunk_.capacity()) * sizeof(float);
+    
+}
+
+/**
+ * Copies a window of frames of the track into an array of interleaved samples.
+ * Frames outside the track, or not held in the ring buffer, are silent.
+ */
+void StreamingTrack::readFrames(long long start_frame, int number_of_frames, float * samples, bool loop) const {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    long long number_of_track_frames = number_of_frames_;
+    
+    for (int frame = 0; frame < number_of_frames; frame++) {
+        
+        long long track_frame = start_frame + frame;
+        
+        if (loop && number_of_track_frames > 0) {
+            
+            track_frame %= number_of_track_frames;
+            
+            if (track_frame < 0) {
+                track_frame += number_of_track_frames;
+            }
+        }
+        
+        bool is_buffered = track_frame >= buffer_start_frame_ && track_frame < buffer_end_frame_;
+        long long ring_buffer_index = (track_frame % std::max(ring_buffer_capacity_, 1LL)) * number_of_channels_;
+        
+        for (int channel = 0; channel < number_of_channels_; channel++) {
+            samples[frame * number_of_channels_ + channel] = is_buffered ? ring_buffer_[ring_buffer_index + channel] : 0;
+        }
+    }
+    
+}
+
+/**
+ * Tells the decode thread which frame of the track is played next.
+ */
+void StreamingTrack::setPlayheadFrame(long long playhead_frame) {
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        playhead_frame_ = playhead_frame;
+    }
+    
+    condition_.notify_one();
+    
+}
@@ -0,0 +1,152 @@
+//
+//  StreamingTrack.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef StreamingTrack_h
+#define StreamingTrack_h
+
+#include "AudioSource.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class AudioDecoder;
+
+/**
+ * Class that models a track which is decoded while it plays, for tracks too long to be held in memory
+ * (e.g. hour-long DJ sets, which take hundreds of megabytes as float samples).
+ *
+ * A decode thread keeps a bounded ring buffer filled with the frames from a little before the playhead
+ * to a few seconds ahead of it, so the memory used is the same whatever the length of the track.
+ * Reading frames that are not in the ring buffer (e.g. right after a seek, or when the track loops
+ * around) gives silence till the decode thread has caught up. The decode thread only holds the lock
+ * to hand over the frames it has decoded, never while it seeks or decodes.
+ */
+class StreamingTrack : public AudioSource {
+    
+    std::string path_; // the path of the audio file the track is decoded from
+    
+    int number_of_channels_; // the number of channels of the track
+    
+    int sample_rate_; // the sample rate of the track
+    
+    std::atomic<long long> number_of_frames_; // the number of frames (samples per channel) of the track
+    
+    std::unique_ptr<AudioDecoder> decoder_; // the decoder of the audio file (only used by the decode thread)
+    
+    std::vector<float> ring_buffer_; // the interleaved samples of the decoded frames, frame f being at f % capacity
+    
+    long long ring_buffer_capacity_; // the number of frames the ring buffer holds
+    
+    long long buffer_start_frame_; // the first frame held in the ring buffer
+    
+    long long buffer_end_frame_; // the frame just past the last one held in the ring buffer
+    
+    long long playhead_frame_; // the frame of the track which is played next
+    
+    long long decoder_frame_; // the frame the decoder reads next (only used by the decode thread)
+    
+    bool has_decoded_to_end_; // whether the decoder has reported the end of the track since it last sought
+    
+    std::vector<float> decode_chunk_; // the samples decoded (outside the lock) before they are added to the ring buffer
+    
+    std::thread decode_thread_; // the thread which decodes the frames ahead of the playhead
+    
+    mutable std::mutex mutex_; // the mutex guarding the ring buffer and the playhead
+    
+    std::condition_variable condition_; // signalled when the playhead moves, or the thread is to stop
+    
+    bool is_running_; // whether the decode thread is running
+    
+    /**
+     * Returns whether the playhead has left the frames held in (or being decoded into) the ring buffer.
+     */
+    bool isSeekNeeded() const;
+    
+    /**
+     * Returns whether there are frames ahead of the playhead which are yet to be decoded.
+     */
+    bool isDecodeNeeded() const;
+    
+    /**
+     * The loop which the decode thread runs.
+     */
+    void run();
+    
+public:
+    
+    /**
+     * Constructor for an (empty) StreamingTrack object.
+     */
+    StreamingTrack() noexcept;
+    
+    /**
+     * Destructor for a StreamingTrack object, which stops the decode thread.
+     */
+    ~StreamingTrack();
+    
+    /**
+     * Opens the audio (.wav or .mp3) file at the given path (relative to the data directory),
+     * without decoding it yet.
+     *
+     * @return whether the file could be opened
+     */
+    bool load(const std::string & path);
+    
+    /**
+     * Starts the decode thread, which fills the ring buffer from the start of the track.
+     */
+    void start();
+    
+    /**
+     * Stops the decode thread.
+     */
+    void stop();
+    
+    /**
+     * Getter for the path of the audio file the track is decoded from.
+     */
+    const std::string & getPath() const;
+    
+    /**
+     * Getter for the number of channels of the track.
+     */
+    int getNumberOfChannels() const;
+    
+    /**
+     * Getter for the sample rate of the track.
+     */
+    int getSampleRate() const;
+    
+    /**
+     * Getter for the number of frames (samples per channel) of the track.
+     * For mp3 files, this is an estimate till the end of the track has been decoded.
+     */
+    long long getNumberOfFrames() const;
+    
+    /**
+     * Returns the number of bytes of memory the samples of the track take up.
+     */
+    size_t getMemoryUsage() const;
+    
+    /**
+     * Copies a window of frames of the track into an array of interleaved samples.
+     * Frames outside the track, or not held in the ring buffer, are silent.
+     */
+    void readFrames(long long start_frame, int number_of_frames, float * samples, bool loop) const;
+    
+    /**
+     * Tells the decode thread which frame of the track is played next.
+     */
+    void setPlayheadFrame(long long playhead_frame);
+    
+};
+
+#endif /* StreamingTrack_h */
@@ -8,15 +8,34 @@
 #include <stdio.h>
 #include "TechnicalVisualizer.h"
 
+const FrameColor kPlotColors[2] = {{255, 105, 180, 255}, // the colours the plots and bars of each channel are drawn in
+                                   {105, 180, 255, 160}}; // (pink, and translucent blue over it)
+
+const FrameColor kTextColor = {255, 255, 255, 255}; // the colour (white) the texts are displayed in
+
+const int kTextFontSize = 10; // the size of the font the texts are displayed in
+
+const float kPlotAttackSeconds = 0.01f; // the time (in seconds) the plots take to rise (most of the way) to a new value
+
+const float kPlotReleaseSeconds = 0.15f; // the time (in seconds) the plots take to fall (most of the way) to a new value
+
 /**
  * Constructor for an TechnicalVisualizer object that initializes
  * resources for the object
  */
 TechnicalVisualizer::TechnicalVisualizer() noexcept {
     
-    // Set smoothing to zero intially.
+    // Set the audio analyzer's smoothing to zero.
+    // Instead, the plots rise quickly and fall slowly, by time (so however many windows are analyzed per frame).
     smoothing_value_ = 0;
     
+    for (int channel = 0; channel < 2; channel++) {
+        
+        spectrum_smoothers_[channel].setup(SMOOTHING_MODE_ATTACK_RELEASE, kPlotAttackSeconds, kPlotReleaseSeconds);
+        mel_band_smoothers_[channel].setup(SMOOTHING_MODE_ATTACK_RELEASE, kPlotAttackSeconds, kPlotReleaseSeconds);
+        hpcp_smoothers_[channel].setup(SMOOTHING_MODE_ATTACK_RELEASE, kPlotAttackSeconds, kPlotReleaseSeconds);
+    }
+    
     // Set the music sample rate to the default, commonly used value - 44,100.
     sample_rate_ = 44100;
     
@@ -28,21 +47,31 @@ TechnicalVisualizer::TechnicalVisualizer() noexcept {
     
     number_of_bands_ = 1024;
     
-    // The number of audio channels of the music.
-    // It is set to 2. (The left and right channel.)
-    //
-    // Note that, I only use 1 channel for my visualization currently.
+    // The number of audio channels analyzed.
+    // By default, the left and right channels are mixed down to mono, so the audio analyzer only does the work
+    // of one channel. (In the CHANNEL_MODE_BOTH mode, it analyzes the left and right channel, one after
+    // the other, within the same job on the frame pipeline's worker thread.)
     
-    int number_of_channels = 2;
+    number_of_analyzed_channels_ = 1;
     
     // Set up the audio analyzer (the ofxAddon which uses the Essentia Music Library).
     
-    audio_analyzer_.setup(sample_rate_, number_of_bands_, number_of_channels);
+    audio_analyzer_.setup(sample_rate_, number_of_bands_, number_of_analyzed_channels_);
+    
+    for (int channel = 0; channel < 2; channel++) {
+        values_[channel] = TechnicalValues();
+    }
+    
+    // Every sample of the music is analyzed: a window of 1024 samples is analyzed every 512 samples
+    // (rather than one window per frame drawn), so the values do not depend on the frame rate.
+    
+    framer_.setup(number_of_bands_, number_of_bands_ / 2);
     
 }
 
 /**
- * Getter for the number of bands of the visualizer.
+ * Getter for the number of bands of the visualizer
+ * (the number of samples the audio analyzer analyzes at a time).
  */
 int TechnicalVisualizer::getNumberOfBands() {
     
@@ -51,235 +80,350 @@ int TechnicalVisualizer::getNumberOfBands() {
 }
 
 /**
- * The following function updates all the values for
- * the Technical visualizer.
- *
- * @param sound_buffer - the sound buffer which
- *                              contains sound for the moment, to be updated with
+ * Sets the channels of the sound which are analyzed and displayed (starting the analysis over).
  */
-void TechnicalVisualizer::update(ofSoundBuffer sound_buffer) {
+void TechnicalVisualizer::setChannelMode(ChannelMode mode) {
     
-    // Let the audio analyzer analyze the current sound buffer.
-    audio_analyzer_.analyze(sound_buffer);
+    mixer_.setMode(mode);
+    framer_.reset();
     
-    // From the analyzer, get all the required values..
+    // The values so far are of other channels.
+    
+    for (int channel = 0; channel < 2; channel++) {
+        
+        values_[channel] = TechnicalValues();
+        
+        spectrum_smoothers_[channel].reset();
+        mel_band_smoothers_[channel].reset();
+        hpcp_smoothers_[channel].reset();
+    }
+    
+}
+
+/**
+ * Getter for the channels of the sound which are analyzed and displayed.
+ */
+ChannelMode TechnicalVisualizer::getChannelMode() const {
     
-    sound_spectrum_ = audio_analyzer_.getValues(SPECTRUM, 0, smoothing_value_);
+    return mixer_.getMode();
     
-    tristimulus_ = audio_analyzer_.getValues(TRISTIMULUS, 0, smoothing_value_);
+}
+
+/**
+ * The following function updates all the values for
+ * the Technical visualizer.
+ *
+ * @param new_sound_buffer - the sound which has not been analyzed yet, to be updated with
+ * @param new_start_frame - the position in the track (in frames) of the first frame of new_sound_buffer
+ */
+void TechnicalVisualizer::update(const ofSoundBuffer & new_sound_buffer, long long new_start_frame) {
     
-    mel_bands_ = audio_analyzer_.getValues(MEL_BANDS, 0, smoothing_value_);
-    mfcc_ = audio_analyzer_.getValues(MFCC, 0, smoothing_value_);
+    // Mix the new sound into the channels analyzed.
     
-    hpcp_ = audio_analyzer_.getValues(HPCP, 0, smoothing_value_);
+    int number_of_frames = new_sound_buffer.getNumFrames();
+    int number_of_channels = mixer_.mix(new_sound_buffer.getBuffer().data(), number_of_frames,
+                                        new_sound_buffer.getNumChannels());
     
-    rms_ = audio_analyzer_.getValue(RMS, 0, smoothing_value_);
-    rms_normalized_ = audio_analyzer_.getValue(RMS, 0, smoothing_value_, TRUE);
+    const float * samples = mixer_.getChannel(0);
     
-    power_ = audio_analyzer_.getValue(POWER, 0, smoothing_value_);
+    if (number_of_channels == 2) {
+        
+        // The audio analyzer takes the left and right channels interleaved.
+        
+        mixed_samples_.resize(2 * number_of_frames);
+        
+        const float * left_samples = mixer_.getChannel(0);
+        const float * right_samples = mixer_.getChannel(1);
+        
+        for (int frame = 0; frame < number_of_frames; frame++) {
+            
+            mixed_samples_[2 * frame] = left_samples[frame];
+            mixed_samples_[2 * frame + 1] = right_samples[frame];
+        }
+        
+        samples = mixed_samples_.data();
+    }
     
-    pitch_frequency_ = audio_analyzer_.getValue(PITCH_FREQ, 0, smoothing_value_);
-    pitch_frequency_normalized_ = audio_analyzer_.getValue(PITCH_FREQ, 0, smoothing_value_, TRUE);
+    // If the song has been switched to one at another sample rate (or another number of channels is analyzed),
+    // set the audio analyzer up for it again.
     
-    pitch_confidence_ = audio_analyzer_.getValue(PITCH_CONFIDENCE, 0, smoothing_value_);
+    if (new_sound_buffer.getSampleRate() != sample_rate_ || number_of_channels != number_of_analyzed_channels_) {
+        
+        sample_rate_ = new_sound_buffer.getSampleRate();
+        number_of_analyzed_channels_ = number_of_channels;
+        
+        audio_analyzer_.reset(sample_rate_, number_of_bands_, number_of_analyzed_channels_);
+        
+        analysis_buffer_.setSampleRate(sample_rate_);
+        analysis_buffer_.allocate(number_of_bands_, number_of_analyzed_channels_);
+        
+    }
     
-    hfc_ = audio_analyzer_.getValue(HFC, 0, smoothing_value_);
-    hfc_normalized_ = audio_analyzer_.getValue(HFC, 0, smoothing_value_, TRUE);
+    // Let the audio analyzer analyze every window the new sound completes,
+    // reading (and smoothing) the values of every channel after each one.
     
-    odd_to_even_harmonic_ratio_ = audio_analyzer_.getValue(ODD_TO_EVEN, 0, smoothing_value_);
-    odd_to_even_harmonic_ratio_normalized_ = audio_analyzer_.getValue(ODD_TO_EVEN, 0, smoothing_value_, TRUE);
+    framer_.push(samples, number_of_frames, number_of_channels, new_start_frame);
     
-    inharmonicity_ = audio_analyzer_.getValue(INHARMONICITY, 0, smoothing_value_);
-    dissonance_ = audio_analyzer_.getValue(DISSONANCE, 0, smoothing_value_);
+    const float * window;
+    long long window_start_frame;
     
-    strong_peak_ = audio_analyzer_.getValue(STRONG_PEAK, 0, smoothing_value_);
-    strong_peak_normalized_ = audio_analyzer_.getValue(STRONG_PEAK, 0, smoothing_value_, TRUE);
+    while (framer_.popWindow(window, window_start_frame)) {
+        
+        analysis_buffer_.copyFrom(window, number_of_bands_, framer_.getNumberOfChannels(), sample_rate_);
+        audio_analyzer_.analyze(analysis_buffer_);
+        
+        for (int channel = 0; channel < number_of_analyzed_channels_; channel++) {
+            readValues(channel);
+        }
+    }
     
-    strong_decay_ = audio_analyzer_.getValue(STRONG_DECAY, 0, smoothing_value_);
-    strong_decay_normalized_ = audio_analyzer_.getValue(STRONG_DECAY, 0, smoothing_value_, TRUE);
 }
 
 /**
- * The following function is responsible for drawing
- * the technical visualization
+ * Reads (and smooths) all the values of a channel from the audio analyzer, after it has analyzed a window.
  */
-void TechnicalVisualizer::draw() {
+void TechnicalVisualizer::readValues(int channel) {
     
-    int left_column_x_offset = 10;
-    int initial_plot_y_position = 15;
+    TechnicalValues & values = values_[channel];
     
-    // Set a width and height for all graphs/plots
-    int graph_width = 450;
-    int graph_height = 150;
+    // From the analyzer, get all the required values..
     
-    int plot_y_offset = graph_height + 50;
+    // The spectrum, mel bands and HPCP are smoothed over the time from one window to the next (a hop).
     
-    // First, load the font to be used.
+    float hop_seconds = (float) framer_.getHopSize() / sample_rate_;
     
-    ofTrueTypeFont temporary_font_loader_;
-    temporary_font_loader_.load("helvetica.ttf", 10);
+    const std::vector<float> & sound_spectrum = audio_analyzer_.getValues(SPECTRUM, channel, smoothing_value_);
+    values.sound_spectrum = spectrum_smoothers_[channel].process(sound_spectrum.data(), sound_spectrum.size(),
+                                                                 hop_seconds);
     
-    // Set the background color to light gray.
-    //ofBackground(240,240,240);
+    values.tristimulus = audio_analyzer_.getValues(TRISTIMULUS, channel, smoothing_value_);
     
-    ofBackground(34, 34, 34);
+    const std::vector<float> & mel_bands = audio_analyzer_.getValues(MEL_BANDS, channel, smoothing_value_);
+    values.mel_bands = mel_band_smoothers_[channel].process(mel_bands.data(), mel_bands.size(), hop_seconds);
     
-    // Set drawing color to dark blue.
-    ofSetColor(255, 105, 180);
+    values.mfcc = audio_analyzer_.getValues(MFCC, channel, smoothing_value_);
     
-    // For each plot/bar,
-    // translate the coordinate system to the desired point.
-    // Draw the plot/bar.
-    // Restore the original system.
+    const std::vector<float> & hpcp = audio_analyzer_.getValues(HPCP, channel, smoothing_value_);
+    values.hpcp = hpcp_smoothers_[channel].process(hpcp.data(), hpcp.size(), hop_seconds);
     
-    // Do this for all technical qualities being visualized.
-    // Unfrotunately, there isn't a simpler way to do this due to the way openFrameworks works, so I can't put repeated code (which
-    // shifts coordinates and changes value normalizations) in a loop.
+    values.rms = audio_analyzer_.getValue(RMS, channel, smoothing_value_);
+    values.rms_normalized = audio_analyzer_.getValue(RMS, channel, smoothing_value_, TRUE);
     
-    drawPlot(sound_spectrum_, graph_width, graph_height, left_column_x_offset,
-             initial_plot_y_position, true, false);
+    values.power = audio_analyzer_.getValue(POWER, channel, smoothing_value_);
     
-    drawPlot(tristimulus_, graph_width, graph_height, left_column_x_offset,
-             initial_plot_y_position + plot_y_offset, false, false);
+    values.pitch_frequency = audio_analyzer_.getValue(PITCH_FREQ, channel, smoothing_value_);
+    values.pitch_frequency_normalized = audio_analyzer_.getValue(PITCH_FREQ, channel, smoothing_value_, TRUE);
     
-    drawPlot(mel_bands_, graph_width, graph_height, left_column_x_offset,
-             initial_plot_y_position + 2 * plot_y_offset, true, false);
+    values.pitch_confidence = audio_analyzer_.getValue(PITCH_CONFIDENCE, channel, smoothing_value_);
     
-    drawPlot(mfcc_, graph_width, graph_height, left_column_x_offset,
-             initial_plot_y_position + 3 * plot_y_offset - ((plot_y_offset - graph_height) / 2),
-             true, true);
+    values.hfc = audio_analyzer_.getValue(HFC, channel, smoothing_value_);
+    values.hfc_normalized = audio_analyzer_.getValue(HFC, channel, smoothing_value_, TRUE);
     
-    ofPushMatrix();
+    values.odd_to_even_harmonic_ratio = audio_analyzer_.getValue(ODD_TO_EVEN, channel, smoothing_value_);
+    values.odd_to_even_harmonic_ratio_normalized = audio_analyzer_.getValue(ODD_TO_EVEN, channel, smoothing_value_, TRUE);
     
-    int right_column_x_offset = 550;
-    int right_column_initial_y_offset = 30;
+    values.inharmonicity = audio_analyzer_.getValue(INHARMONICITY, channel, smoothing_value_);
+    values.dissonance = audio_analyzer_.getValue(DISSONANCE, channel, smoothing_value_);
     
-    ofTranslate(left_column_x_offset + right_column_x_offset, right_column_initial_y_offset + initial_plot_y_position);
+    values.strong_peak = audio_analyzer_.getValue(STRONG_PEAK, channel, smoothing_value_);
+    values.strong_peak_normalized = audio_analyzer_.getValue(STRONG_PEAK, channel, smoothing_value_, TRUE);
     
-    float bar_width = (float) graph_width / hpcp_.size();
+    values.strong_decay = audio_analyzer_.getValue(STRONG_DECAY, channel, smoothing_value_);
+    values.strong_decay_normalized = audio_analyzer_.getValue(STRONG_DECAY, channel, smoothing_value_, TRUE);
+}
+
+/**
+ * Formats a value of each channel analyzed (separated by a slash) to be displayed.
+ */
+std::string TechnicalVisualizer::formatValue(float TechnicalValues::* value) const {
     
-    for (int index = 0; index < hpcp_.size(); index++){
-        
-        float scaled_value = hpcp_[index];
-        
-        float bar_height = (- 1) * scaled_value * graph_height;
-        ofDrawRectangle(index * bar_width, graph_height, bar_width, bar_height);
+    std::string text = ofToString(values_[0].*value, 2);
+    
+    if (number_of_analyzed_channels_ == 2) {
+        text += " / " + ofToString(values_[1].*value, 2);
     }
     
-    ofPopMatrix();
+    return text;
     
-    int bar_height = 20;
-    int bar_y_offset = 50;
+}
+
+/**
+ * The following function is responsible for computing
+ * the technical visualization to be drawn.
+ *
+ * @param frame - the frame to fill in with the primitives to be drawn
+ * @param window_width - the width of the window the frame is drawn to
+ * @param window_height - the height of the window the frame is drawn to
+ */
+void TechnicalVisualizer::computeFrame(VisualizerFrame & frame, int window_width, int window_height) {
+    
+    int left_column_x_offset = 10;
+    int initial_plot_y_position = 15;
+    
+    // Set a width and height for all graphs/plots
+    int graph_width = 450;
+    int graph_height = 150;
     
-    drawBar(rms_normalized_,left_column_x_offset + right_column_x_offset,
-            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset,
-            graph_width, bar_height);
+    int plot_y_offset = graph_height + 50;
     
-    drawBar(power_,left_column_x_offset + right_column_x_offset,
-            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + bar_y_offset,
-            graph_width, bar_height);
+    frame.reset(window_width, window_height);
     
-    drawBar(pitch_frequency_normalized_,left_column_x_offset + right_column_x_offset,
-            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
-            + 2 * bar_y_offset,
-            graph_width, bar_height);
+    // Set the background color to dark gray.
     
-    drawBar(pitch_confidence_,left_column_x_offset + right_column_x_offset,
-            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
-            + 3 * bar_y_offset,
-            graph_width, bar_height);
+    frame.has_background = true;
+    frame.background_color = FrameColor{34, 34, 34, 255};
     
-    drawBar(hfc_normalized_,left_column_x_offset + right_column_x_offset,
-            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
-            + 4 * bar_y_offset,
-            graph_width, bar_height);
+    // All plots, bars and texts are drawn in the original coordinate system.
     
-    drawBar(odd_to_even_harmonic_ratio_normalized_,left_column_x_offset + right_column_x_offset,
-            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
-            + 5 * bar_y_offset,
-            graph_width, bar_height);
+    FrameLayer & layer = frame.addLayer(0, 0);
     
-    drawBar(inharmonicity_,left_column_x_offset + right_column_x_offset,
-            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
-            + 6 * bar_y_offset,
-            graph_width, bar_height);
+    int right_column_x_offset = 550;
+    int right_column_initial_y_offset = 30;
+    
+    int bar_height = 20;
+    int bar_y_offset = 50;
     
-    drawBar(dissonance_,left_column_x_offset + right_column_x_offset,
-            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
-            + 7 * bar_y_offset,
-            graph_width, bar_height);
+    // For each channel analyzed, and each plot/bar,
+    // add its rectangles, offset to the desired point.
+    // (The plots of the right channel are drawn over the left's, and the bars of the two channels share
+    // the height of one bar.)
     
-    drawBar(strong_peak_normalized_,left_column_x_offset + right_column_x_offset,
-            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
-            + 8 * bar_y_offset,
-            graph_width, bar_height);
+    // Do this for all technical qualities being visualized.
     
-    drawBar(strong_decay_normalized_,left_column_x_offset + right_column_x_offset,
-            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
-            + 9 * bar_y_offset,
-            graph_width, bar_height);
+    for (int channel = 0; channel < number_of_analyzed_channels_; channel++) {
+        
+        const TechnicalValues & values = values_[channel];
+        const FrameColor & color = kPlotColors[channel];
+        
+        int channel_bar_height = bar_height / number_of_analyzed_channels_;
+        int channel_bar_y_offset = channel * channel_bar_height;
+        
+        addPlot(layer, values.sound_spectrum, graph_width, graph_height, left_column_x_offset,
+                 initial_plot_y_position, true, false, color);
+        
+        addPlot(layer, values.tristimulus, graph_width, graph_height, left_column_x_offset,
+                 initial_plot_y_position + plot_y_offset, false, false, color);
+        
+        addPlot(layer, values.mel_bands, graph_width, graph_height, left_column_x_offset,
+                 initial_plot_y_position + 2 * plot_y_offset, true, false, color);
+        
+        addPlot(layer, values.mfcc, graph_width, graph_height, left_column_x_offset,
+                 initial_plot_y_position + 3 * plot_y_offset - ((plot_y_offset - graph_height) / 2),
+                 true, true, color);
+        
+        // The HPCP plot is never scaled.
+        
+        addPlot(layer, values.hpcp, graph_width, graph_height, left_column_x_offset + right_column_x_offset,
+                right_column_initial_y_offset + initial_plot_y_position, false, false, color);
+        
+        addBar(layer, values.rms_normalized, left_column_x_offset + right_column_x_offset,
+                right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + channel_bar_y_offset,
+                graph_width, channel_bar_height, color);
+        
+        addBar(layer, values.power, left_column_x_offset + right_column_x_offset,
+                right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
+                + bar_y_offset + channel_bar_y_offset,
+                graph_width, channel_bar_height, color);
+        
+        addBar(layer, values.pitch_frequency_normalized, left_column_x_offset + right_column_x_offset,
+                right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
+                + 2 * bar_y_offset + channel_bar_y_offset,
+                graph_width, channel_bar_height, color);
+        
+        addBar(layer, values.pitch_confidence, left_column_x_offset + right_column_x_offset,
+                right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
+                + 3 * bar_y_offset + channel_bar_y_offset,
+                graph_width, channel_bar_height, color);
+        
+        addBar(layer, values.hfc_normalized, left_column_x_offset + right_column_x_offset,
+                right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
+                + 4 * bar_y_offset + channel_bar_y_offset,
+                graph_width, channel_bar_height, color);
+        
+        addBar(layer, values.odd_to_even_harmonic_ratio_normalized, left_column_x_offset + right_column_x_offset,
+                right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
+                + 5 * bar_y_offset + channel_bar_y_offset,
+                graph_width, channel_bar_height, color);
+        
+        addBar(layer, values.inharmonicity, left_column_x_offset + right_column_x_offset,
+                right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
+                + 6 * bar_y_offset + channel_bar_y_offset,
+                graph_width, channel_bar_height, color);
+        
+        addBar(layer, values.dissonance, left_column_x_offset + right_column_x_offset,
+                right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
+                + 7 * bar_y_offset + channel_bar_y_offset,
+                graph_width, channel_bar_height, color);
+        
+        addBar(layer, values.strong_peak_normalized, left_column_x_offset + right_column_x_offset,
+                right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
+                + 8 * bar_y_offset + channel_bar_y_offset,
+                graph_width, channel_bar_height, color);
+        
+        addBar(layer, values.strong_decay_normalized, left_column_x_offset + right_column_x_offset,
+                right_column_initial_y_offset + initial_plot_y_position + plot_y_offset
+                + 9 * bar_y_offset + channel_bar_y_offset,
+                graph_width, channel_bar_height, color);
+    }
     
-    // After drawing all the visualizations, display the texts.
+    // After adding all the visualizations, display the texts.
     
-    ofSetColor(255, 255, 255);
-    temporary_font_loader_.drawString("Spectrum: ", left_column_x_offset, initial_plot_y_position);
+    addText(layer, "Spectrum (" + ChannelMixer::getModeName(getChannelMode()) + "): ", left_column_x_offset,
+            initial_plot_y_position);
     
-    temporary_font_loader_.drawString("Tristimulus: ", left_column_x_offset, initial_plot_y_position + plot_y_offset);
+    addText(layer, "Tristimulus: ", left_column_x_offset, initial_plot_y_position + plot_y_offset);
     
-    temporary_font_loader_.drawString("Mel Bands: ", left_column_x_offset, initial_plot_y_position + 2 * plot_y_offset);
+    addText(layer, "Mel Bands: ", left_column_x_offset, initial_plot_y_position + 2 * plot_y_offset);
     
-    temporary_font_loader_.drawString("MFCC: ", left_column_x_offset,
-                                      initial_plot_y_position + 3 * plot_y_offset - ((plot_y_offset - graph_height) / 2));
+    addText(layer, "MFCC: ", left_column_x_offset,
+            initial_plot_y_position + 3 * plot_y_offset - ((plot_y_offset - graph_height) / 2));
     
-    temporary_font_loader_.drawString("HPCP: ", left_column_x_offset + right_column_x_offset,
-                                       right_column_initial_y_offset + initial_plot_y_position);
+    addText(layer, "HPCP: ", left_column_x_offset + right_column_x_offset,
+            right_column_initial_y_offset + initial_plot_y_position);
     
-    temporary_font_loader_.drawString("RMS: " + ofToString(rms_, 2), left_column_x_offset + right_column_x_offset,
-                                      right_column_initial_y_offset + initial_plot_y_position + plot_y_offset);
+    addText(layer, "RMS: " + formatValue(&TechnicalValues::rms), left_column_x_offset + right_column_x_offset,
+            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset);
     
-    temporary_font_loader_.drawString("Power: " + ofToString(power_, 2), left_column_x_offset + right_column_x_offset,
-                                      right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + bar_y_offset);
+    addText(layer, "Power: " + formatValue(&TechnicalValues::power), left_column_x_offset + right_column_x_offset,
+            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + bar_y_offset);
     
-    temporary_font_loader_.drawString("Pitch Frequency: " + ofToString(pitch_frequency_, 2), left_column_x_offset + right_column_x_offset,
-                                      right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 2 * bar_y_offset);
+    addText(layer, "Pitch Frequency: " + formatValue(&TechnicalValues::pitch_frequency), left_column_x_offset + right_column_x_offset,
+            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 2 * bar_y_offset);
     
-    temporary_font_loader_.drawString("Pitch Confidence: " + ofToString(pitch_confidence_, 2), left_column_x_offset + right_column_x_offset,
-                                      right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 3 * bar_y_offset);
+    addText(layer, "Pitch Confidence: " + formatValue(&TechnicalValues::pitch_confidence), left_column_x_offset + right_column_x_offset,
+            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 3 * bar_y_offset);
     
-    temporary_font_loader_.drawString("HFC: " + ofToString(hfc_, 2), left_column_x_offset + right_column_x_offset,
-                                      right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 4 * bar_y_offset);
+    addText(layer, "HFC: " + formatValue(&TechnicalValues::hfc), left_column_x_offset + right_column_x_offset,
+            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 4 * bar_y_offset);
     
-    temporary_font_loader_.drawString("Odd to Even Harmonic Energy Ratio: " +
-                                      ofToString(odd_to_even_harmonic_ratio_, 2), left_column_x_offset + right_column_x_offset,
-                                      right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 5 * bar_y_offset);
+    addText(layer, "Odd to Even Harmonic Energy Ratio: " +
+            formatValue(&TechnicalValues::odd_to_even_harmonic_ratio), left_column_x_offset + right_column_x_offset,
+            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 5 * bar_y_offset);
     
-    temporary_font_loader_.drawString("Inharmonicity: " +
-                                      ofToString(inharmonicity_, 2), left_column_x_offset + right_column_x_offset,
-                                      right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 6 * bar_y_offset);
+    addText(layer, "Inharmonicity: " +
+            formatValue(&TechnicalValues::inharmonicity), left_column_x_offset + right_column_x_offset,
+            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 6 * bar_y_offset);
     
-    temporary_font_loader_.drawString("Dissonance: " +
-                                      ofToString(dissonance_, 2), left_column_x_offset + right_column_x_offset,
-                                      right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 7 * bar_y_offset);
+    addText(layer, "Dissonance: " +
+            formatValue(&TechnicalValues::dissonance), left_column_x_offset + right_column_x_offset,
+            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 7 * bar_y_offset);
     
-    temporary_font_loader_.drawString("Strong Peak: " +
-                                      ofToString(strong_peak_, 2), left_column_x_offset + right_column_x_offset,
-                                      right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 8 * bar_y_offset);
+    addText(layer, "Strong Peak: " +
+            formatValue(&TechnicalValues::strong_peak), left_column_x_offset + right_column_x_offset,
+            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 8 * bar_y_offset);
     
-    temporary_font_loader_.drawString("Strong Decay: " +
-                                      ofToString(strong_decay_, 2), left_column_x_offset + right_column_x_offset,
-                                      right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 9 * bar_y_offset);
+    addText(layer, "Strong Decay: " +
+            formatValue(&TechnicalValues::strong_decay), left_column_x_offset + right_column_x_offset,
+            right_column_initial_y_offset + initial_plot_y_position + plot_y_offset + 9 * bar_y_offset);
     
 }
 
 /**
- * Helper function to draw plots.
+ * Helper function to add plots to a layer.
  */
-void TechnicalVisualizer::drawPlot(const std::vector<float> & values,
-                                   int graph_width, int graph_height, int x, int y, bool should_scale, bool is_mfcc) {
-    
-    ofPushMatrix();
-    
-    ofTranslate(x, y);
+void TechnicalVisualizer::addPlot(FrameLayer & layer, const std::vector<float> & values,
+                                  int graph_width, int graph_height, int x, int y, bool should_scale, bool is_mfcc,
+                                  const FrameColor & color) {
     
     float bar_width = (float) graph_width / values.size();
     
@@ -300,23 +444,37 @@ void TechnicalVisualizer::drawPlot(const std::vector<float> & values,
         }
         
         float bar_height = (- 1) * scaled_value * graph_height;
-        ofDrawRectangle(index * bar_width, graph_height, bar_width, bar_height);
+        
+        FrameRectangle bar = {x + index * bar_width, (float) (y + graph_height), bar_width, bar_height, color};
+        layer.rectangles.push_back(bar);
     }
     
-    ofPopMatrix();
+}
+
+/**
+ * Helper function to add bars to a layer.
+ */
+void TechnicalVisualizer::addBar(FrameLayer & layer, float value, int x, int y, int bar_width, int bar_height,
+                                 const FrameColor & color) {
+    
+    FrameRectangle bar = {(float) x, (float) (y + 5), value * bar_width, (float) bar_height, color};
+    layer.rectangles.push_back(bar);
     
 }
 
 /**
- * Helper function to draw bars.
+ * Helper function to add a text to a layer.
  */
-void TechnicalVisualizer::drawBar(float value, int x, int y, int bar_width, int bar_height) {
+void TechnicalVisualizer::addText(FrameLayer & layer, const std::string & text, int x, int y) {
     
-    ofPushMatrix();
-    ofTranslate(x, y);
+    // The text is filled in in place, so that the string reuses the capacity it had in the last frame.
     
-    ofDrawRectangle(0, 5, value * bar_width, bar_height);
+    FrameText & frame_text = layer.texts.add();
     
-    ofPopMatrix();
+    frame_text.text.assign(text);
+    frame_text.x = x;
+    frame_text.y = y;
+    frame_text.font_size = kTextFontSize;
+    frame_text.color = kTextColor;
     
 }
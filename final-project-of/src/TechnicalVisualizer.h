@@ -9,6 +9,10 @@
 #include "ofxGui.h"
 #include "ofxAudioAnalyzer.h"
 #include "ofSoundPlayerExtended.h"
+#include "VisualizerFrame.h"
+#include "HopFramer.h"
+#include "ChannelMixer.h"
+#include "SpectrumSmoother.h"
 #include <iostream>
 
 #ifndef TechnicalVisualizer_h
@@ -19,48 +23,84 @@
  */
 class TechnicalVisualizer {
     
-    ofxAudioAnalyzer audio_analyzer_; // the audio analyzer that obtains frequency band values and spectrum
-    
-    int sample_rate_; // the sample rate of the music
+    /**
+     * The technical values of one channel of the music.
+     */
+    struct TechnicalValues {
+        
+        std::vector<float> sound_spectrum; // the float array storing the sound spectrum values
+        
+        std::vector<float> hpcp; // the float array storing a Harmonic Pitch Class Profile (HPCP), that is a k*12 dimensional vector which
+                                 // represents the intensities of the twelve (k==1) semitone pitch classes
+        
+        std::vector<float> tristimulus; // the float array storing the tristimulus of a signal given its harmonic peaks
+        
+        std::vector<float> mel_bands; // the float array storing the frequency/intensity values for each mel band
+        std::vector<float> mfcc; // the float array storing the mel-frequency cepstrum coefficients
+        
+        float rms; // RMS value of the music
+        float rms_normalized;
+        
+        float power; // the power value of the music
+        
+        float pitch_frequency; // the pitch frequency of the music
+        float pitch_frequency_normalized;
+        
+        float pitch_confidence; // the pitch confidence of the music
+        
+        float hfc; // the HFC of the music
+        float hfc_normalized;
+        
+        float odd_to_even_harmonic_ratio; // the odd to even harmonic enery ratio of the music
+        float odd_to_even_harmonic_ratio_normalized;
+        
+        float inharmonicity; // the inharmonicity of the music
+        float dissonance; // the dissonance of the music
+        
+        float strong_peak; // the strong peak of the music
+        float strong_peak_normalized;
+        
+        float strong_decay; // the strong decay of the music
+        float strong_decay_normalized;
+        
+    };
     
-    int number_of_bands_; // the number of bands for the music spectrum
+    ofxAudioAnalyzer audio_analyzer_; // the audio analyzer that obtains frequency band values and spectrum
     
-    std::vector<float> sound_spectrum_; // the float array storing the sound spectrum values
+    ChannelMixer mixer_; // the mixer which mixes the sound into the channels analyzed
     
-    std::vector<float> hpcp_; // the float array storing a Harmonic Pitch Class Profile (HPCP), that is a k*12 dimensional vector which
-                              // represents the intensities of the twelve (k==1) semitone pitch classes
+    std::vector<float> mixed_samples_; // the (interleaved) samples of the channels analyzed, when there are two
     
-    std::vector<float> tristimulus_; // the float array storing the tristimulus of a signal given its harmonic peaks
+    int number_of_analyzed_channels_; // the number of channels analyzed (2 in the CHANNEL_MODE_BOTH mode, otherwise 1)
     
-    std::vector<float> mel_bands_; // the float array storing the frequency/intensity values for each mel band
-    std::vector<float> mfcc_; // the float array storing the mel-frequency cepstrum coefficients
+    HopFramer framer_; // the framer which cuts the sound into the overlapping windows the audio analyzer analyzes
     
-    float smoothing_value_; // the smoothing value for the different computations
+    ofSoundBuffer analysis_buffer_; // the window of samples being analyzed
     
-    float rms_; // RMS value of the music
-    float rms_normalized_;
+    int sample_rate_; // the sample rate of the music
     
-    float power_; // the power value of the music
+    int number_of_bands_; // the number of bands for the music spectrum
     
-    float pitch_frequency_; // the pitch frequency of the music
-    float pitch_frequency_normalized_;
+    TechnicalValues values_[2]; // the technical values of each channel analyzed
     
-    float pitch_confidence_; // the pitch confidence of the music
+    float smoothing_value_; // the smoothing value the audio analyzer applies to the different computations
+                            // (none: the plots are smoothed over time by the smoothers below)
     
-    float hfc_; // the HFC of the music
-    float hfc_normalized_;
+    SpectrumSmoother spectrum_smoothers_[2]; // the smoothers of the spectrum of each channel analyzed
     
-    float odd_to_even_harmonic_ratio_; // the odd to even harmonic enery ratio of the music
-    float odd_to_even_harmonic_ratio_normalized_;
+    SpectrumSmoother mel_band_smoothers_[2]; // the smoothers of the mel bands of each channel analyzed
     
-    float inharmonicity_; // the inharmonicity of the music
-    float dissonance_; // the dissonance of the music
+    SpectrumSmoother hpcp_smoothers_[2]; // the smoothers of the HPCP of each channel analyzed
     
-    float strong_peak_; // the strong peak of the music
-    float strong_peak_normalized_;
+    /**
+     * Reads (and smooths) all the values of a channel from the audio analyzer, after it has analyzed a window.
+     */
+    void readValues(int channel);
     
-    float strong_decay_; // the strong decay of the music
-    float strong_decay_normalized_;
+    /**
+     * Formats a value of each channel analyzed (separated by a slash) to be displayed.
+     */
+    std::string formatValue(float TechnicalValues::* value) const;
     
 public:
     
@@ -74,34 +114,54 @@ public:
      * The following function updates all the values for
      * the Technical visualizer.
      *
-     * @param sound_buffer - the sound buffer which
-     *                              contains sound for the moment, to be updated with
+     * @param new_sound_buffer - the sound which has not been analyzed yet, to be updated with
+     * @param new_start_frame - the position in the track (in frames) of the first frame of new_sound_buffer
      */
-    void update(ofSoundBuffer sound_buffer);
+    void update(const ofSoundBuffer & new_sound_buffer, long long new_start_frame);
     
     /**
-     * The following function is responsible for drawing
-     * the technical visualization.
+     * The following function is responsible for computing
+     * the technical visualization to be drawn.
+     *
+     * @param frame - the frame to fill in with the primitives to be drawn
+     * @param window_width - the width of the window the frame is drawn to
+     * @param window_height - the height of the window the frame is drawn to
      */
-    void draw();
+    void computeFrame(VisualizerFrame & frame, int window_width, int window_height);
     
     /**
-     * Getter for the number of bands of the visualizer.
+     * Getter for the number of bands of the visualizer
+     * (the number of samples the audio analyzer analyzes at a time).
      */
     int getNumberOfBands();
     
     /**
-     * Helper function to draw plots.
+     * Sets the channels of the sound which are analyzed and displayed (starting the analysis over).
+     */
+    void setChannelMode(ChannelMode mode);
+    
+    /**
+     * Getter for the channels of the sound which are analyzed and displayed.
      */
-    void drawPlot(const std::vector<float> & values,
-                                       int graph_width, int graph_height,
-                                       int x, int y, bool should_scale, bool is_mfcc);
+    ChannelMode getChannelMode() const;
     
+    /**
+     * Helper function to add plots to a layer.
+     */
+    void addPlot(FrameLayer & layer, const std::vector<float> & values,
+                 int graph_width, int graph_height,
+                 int x, int y, bool should_scale, bool is_mfcc, const FrameColor & color);
+    
+    
+    /**
+     * Helper function to add bars to a layer.
+     */
+    void addBar(FrameLayer & layer, float value, int x, int y, int bar_width, int bar_height, const FrameColor & color);
     
     /**
-     * Helper function to draw bars.
+     * Helper function to add a text to a layer.
      */
-    void drawBar(float value, int x, int y, int bar_width, int bar_height);
+    void addText(FrameLayer & layer, const std::string & text, int x, int y);
     
 };
 
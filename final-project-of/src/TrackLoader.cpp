@@ -0,0 +1,272 @@
+//
+//  TrackLoader.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "TrackLoader.h"
+#include "DecodedTrack.h"
+#include "StreamingTrack.h"
+
+const float kMaximumDecodedTrackLength = 600.0f; // the length (in seconds) of the longest track which is decoded
+                                                 // as a whole; longer tracks are decoded as they play
+
+/**
+ * Constructor for a TrackLoader object, which does not start the loader thread yet.
+ */
+TrackLoader::TrackLoader() noexcept {
+    
+    request_number_ = 0;
+    loading_request_number_ = 0;
+    is_running_ = false;
+    progress_ = 0;
+    
+}
+
+/**
+ * Destructor, which stops the loader thread.
+ */
+TrackLoader::~TrackLoader() {
+    
+    stop();
+    
+}
+
+/**
+ * Starts the loader thread.
+ */
+void TrackLoader::start() {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (is_running_) {
+        return;
+    }
+    
+    is_running_ = true;
+    loader_thread_ = std::thread(&TrackLoader::run, this);
+    
+}
+
+/**
+ * Stops the loader thread, abandoning the track being loaded.
+ */
+void TrackLoader::stop() {
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_running_ = false;
+    }
+    
+    condition_.notify_all();
+    
+    if (loader_thread_.joinable()) {
+        loader_thread_.join();
+    }
+    
+}
+
+/**
+ * The function run by the loader thread.
+ */
+void TrackLoader::run() {
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    
+    while (true) {
+        
+        // Sleep till a track is asked for or handed over to be released (or the loader is stopped).
+        
+        condition_.wait(lock, [this] {
+            return !is_running_ || !tracks_to_release_.empty() || (!pending_path_.empty() && loading_request_number_ == 0);
+        });
+        
+        if (!is_running_) {
+            return;
+        }
+        
+        if (!tracks_to_release_.empty()) {
+            
+            std::vector<std::shared_ptr<AudioSource> > tracks_to_release;
+            tracks_to_release.swap(tracks_to_release_);
+            
+            lock.unlock();
+            tracks_to_release.clear();
+            lock.lock();
+            
+            continue;
+        }
+        
+        std::string path = pending_path_;
+        int request_number = request_number_;
+        
+        pending_path_.clear();
+        loading_request_number_ = request_number;
+        progress_ = 0;
+        
+        lock.unlock();
+        
+        // Report the progress of the decoding, and abandon it as soon as another track is asked for.
+        
+        std::shared_ptr<AudioSource> track = openTrack(path, [this, request_number] (float progress) {
+            
+            progress_ = progress;
+            
+            std::lock_guard<std::mutex> lock(mutex_);
+            return is_running_ && request_number == request_number_;
+            
+        });
+        
+        lock.lock();
+        
+        // Only keep the track if no other track has been asked for in the meantime.
+        
+        if (track && request_number == request_number_) {
+            loaded_track_ = track;
+        }
+        
+        loading_request_number_ = 0;
+    }
+    
+}
+
+/**
+ * Decodes the track at the given path (or, for long tracks, opens it to be decoded as it plays).
+ * This runs on the calling thread.
+ */
+std::shared_ptr<AudioSource> TrackLoader::openTrack(const std::string & path, std::function<bool(float)> on_progress,
+                                                    size_t maximum_memory_usage) {
+    
+    // Opening the track to stream it tells how long it is, without decoding it.
+    
+    std::shared_ptr<StreamingTrack> streaming_track = std::make_shared<StreamingTrack>();
+    
+    if (!streaming_track->load(path)) {
+        return nullptr;
+    }
+    
+    float track_length = (float) streaming_track->getNumberOfFrames() / streaming_track->getSampleRate();
+    
+    if (track_length > kMaximumDecodedTrackLength) {
+        
+        // A long track (e.g. an hour-long DJ set) would take hundreds of megabytes once decoded,
+        // so only the few seconds around the playhead are decoded at a time.
+        
+        if (streaming_track->getMemoryUsage() > maximum_memory_usage || (on_progress && !on_progress(1))) {
+            return nullptr;
+        }
+        
+        streaming_track->start();
+        return streaming_track;
+    }
+    
+    // A track which would not fit is not decoded at all (going by the number of frames the decoder reports,
+    // which may be an estimate).
+    
+    size_t estimated_memory_usage = (size_t) streaming_track->getNumberOfFrames()
+                                    * streaming_track->getNumberOfChannels() * sizeof(float);
+    
+    if (estimated_memory_usage > maximum_memory_usage) {
+        return nullptr;
+    }
+    
+    std::shared_ptr<DecodedTrack> decoded_track = std::make_shared<DecodedTrack>();
+    
+    if (!decoded_track->load(path, on_progress)) {
+        return nullptr;
+    }
+    
+    return decoded_track;
+    
+}
+
+/**
+ * Asks for the track at the given path to be loaded (in the background).
+ */
+void TrackLoader::load(const std::string & path) {
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        pending_path_ = path;
+        requested_path_ = path;
+        request_number_++;
+        
+        // A track loaded for an earlier request is not wanted anymore.
+        loaded_track_.reset();
+    }
+    
+    condition_.notify_all();
+    
+}
+
+/**
+ * Hands over a track which is not needed anymore, to be released on the loader thread
+ * (once no one else holds it).
+ */
+void TrackLoader::release(std::shared_ptr<AudioSource> track) {
+    
+    if (!track) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        // If the loader is not running, the track is just released here.
+        
+        if (!is_running_) {
+            return;
+        }
+        
+        tracks_to_release_.push_back(std::move(track));
+    }
+    
+    condition_.notify_all();
+    
+}
+
+/**
+ * Returns whether a track is being loaded.
+ */
+bool TrackLoader::isLoading() {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !pending_path_.empty() || loading_request_number_ != 0;
+    
+}
+
+/**
+ * Getter for the path of the latest track asked for.
+ */
+std::string TrackLoader::getRequestedPath() {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requested_path_;
+    
+}
+
+/**
+ * Getter for the fraction (in [0, 1]) of the track being loaded which has been decoded.
+ */
+float TrackLoader::getProgress() const {
+    
+    return progress_;
+    
+}
+
+/**
+ * Returns the track which has been loaded (handing it over to the caller), or nullptr
+ * if no track has finished loading since the last call.
+ */
+std::shared_ptr<AudioSource> TrackLoader::takeLoadedTrack() {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    std::shared_ptr<AudioSource> loaded_track = loaded_track_;
+    loaded_track_.reset();
+    
+    return loaded_track;
+    
+}
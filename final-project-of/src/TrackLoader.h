@@ -0,0 +1,134 @@
+//
+//  TrackLoader.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef TrackLoader_h
+#define TrackLoader_h
+
+#include "AudioSource.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Class that decodes tracks on a loader thread, so that the main thread never stalls while
+ * a track is decoded (which, for a whole mp3 file, takes far longer than a frame).
+ *
+ * The main thread asks for a track with load(), shows the progress with getProgress(), and
+ * picks the track up with takeLoadedTrack() once it is ready, to swap it in in one step.
+ * If another track is asked for while one is being decoded, the older request is abandoned.
+ *
+ * Tracks which are switched away from are released on the loader thread as well, as freeing
+ * a whole decoded track (or stopping a streaming track's decode thread) can take a while too.
+ */
+class TrackLoader {
+    
+    std::thread loader_thread_; // the thread which decodes the tracks
+    
+    std::mutex mutex_; // the mutex guarding all the below state (except the progress)
+    
+    std::condition_variable condition_; // signalled when a track is asked for, or the thread is to stop
+    
+    std::string pending_path_; // the path of the track to be loaded next (empty if there is none)
+    
+    std::string requested_path_; // the path of the latest track asked for
+    
+    int request_number_; // the number of the latest request (so that superseded requests can be abandoned)
+    
+    int loading_request_number_; // the number of the request being loaded (0 if none)
+    
+    std::shared_ptr<AudioSource> loaded_track_; // the track which has been loaded, till it is taken
+    
+    std::vector<std::shared_ptr<AudioSource> > tracks_to_release_; // the tracks to be released on the loader thread
+    
+    bool is_running_; // whether the loader thread should keep running
+    
+    std::atomic<float> progress_; // the fraction of the track being loaded which has been decoded
+    
+    /**
+     * The function run by the loader thread.
+     */
+    void run();
+    
+public:
+    
+    /**
+     * Constructor for a TrackLoader object, which does not start the loader thread yet.
+     */
+    TrackLoader() noexcept;
+    
+    /**
+     * Destructor, which stops the loader thread.
+     */
+    ~TrackLoader();
+    
+    /**
+     * Starts the loader thread.
+     */
+    void start();
+    
+    /**
+     * Stops the loader thread, abandoning the track being loaded.
+     */
+    void stop();
+    
+    /**
+     * Decodes the track at the given path (or, for long tracks, opens it to be decoded as it plays).
+     * This runs on the calling thread.
+     *
+     * @param path - the path of the track
+     * @param on_progress - (optional) called with the fraction of the track decoded so far;
+     *                      the decoding is abandoned if it returns false
+     * @param maximum_memory_usage - (optional) the most bytes the track may take up; a track the decoder
+     *                               estimates to take up more is not decoded
+     * @return the track, or nullptr if it could not be decoded (or the decoding was abandoned, or the track
+     *         would not fit)
+     */
+    static std::shared_ptr<AudioSource> openTrack(const std::string & path,
+                                                  std::function<bool(float)> on_progress = nullptr,
+                                                  size_t maximum_memory_usage = std::numeric_limits<size_t>::max());
+    
+    /**
+     * Asks for the track at the given path to be loaded (in the background).
+     */
+    void load(const std::string & path);
+    
+    /**
+     * Hands over a track which is not needed anymore, to be released on the loader thread
+     * (once no one else holds it).
+     */
+    void release(std::shared_ptr<AudioSource> track);
+    
+    /**
+     * Returns whether a track is being loaded.
+     */
+    bool isLoading();
+    
+    /**
+     * Getter for the path of the latest track asked for.
+     */
+    std::string getRequestedPath();
+    
+    /**
+     * Getter for the fraction (in [0, 1]) of the track being loaded which has been decoded.
+     */
+    float getProgress() const;
+    
+    /**
+     * Returns the track which has been loaded (handing it over to the caller), or nullptr
+     * if no track has finished loading since the last call.
+     */
+    std::shared_ptr<AudioSource> takeLoadedTrack();
+    
+};
+
+#endif /* TrackLoader_h */
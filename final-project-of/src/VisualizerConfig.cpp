@@ -0,0 +1,235 @@
+//
+//  VisualizerConfig.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "VisualizerConfig.h"
+
+const int kMinimumNumberOfParticles = 1; // the fewest particles a graph may have
+
+const int kMaximumNumberOfParticles = 2000; // the most particles a graph may have (the edges grow with its square)
+
+const int kMinimumNumberOfBands = 64; // the fewest bands of the spectrum a graph may be updated with
+
+const int kMaximumNumberOfBands = 8192; // the most bands of the spectrum a graph may be updated with
+
+/**
+ * Reads a number from a section, if it is there.
+ */
+static bool readNumber(const JsonValue & section, const std::string & name, float minimum, float maximum,
+                       float & value, std::string & error) {
+
+    if (!section.hasMember(name)) {
+        return true;
+    }
+
+    if (!section[name].is(JsonValue::TYPE_NUMBER)) {
+
+        error = "\"" + name + "\" is not a number";
+
+        return false;
+    }
+
+    float new_value = section[name].asNumber(0);
+
+    if (new_value < minimum || new_value > maximum) {
+
+        error = "\"" + name + "\" is out of range";
+
+        return false;
+    }
+
+    value = new_value;
+
+    return true;
+
+}
+
+/**
+ * Reads a colour ([r, g, b] or [r, g, b, a], each in [0, 255]) from a section, if it is there.
+ */
+static bool readColor(const JsonValue & section, const std::string & name, FrameColor & color, std::string & error) {
+
+    if (!section.hasMember(name)) {
+        return true;
+    }
+
+    const JsonValue & components = section[name];
+
+    if (!components.is(JsonValue::TYPE_ARRAY) || components.size() < 3 || components.size() > 4) {
+
+        error = "\"" + name + "\" is not a colour ([r, g, b] or [r, g, b, a])";
+
+        return false;
+    }
+
+    unsigned char values[4] = {0, 0, 0, color.a};
+
+    for (int index = 0; index < components.size(); index++) {
+
+        double component = components[index].asNumber(-1);
+
+        if (component < 0 || component > 255) {
+
+            error = "\"" + name + "\" has a component out of [0, 255]";
+
+            return false;
+        }
+
+        values[index] = (unsigned char) component;
+    }
+
+    color = FrameColor{values[0], values[1], values[2], values[3]};
+
+    return true;
+
+}
+
+/**
+ * Constructor for a VisualizerConfig object, with the default values.
+ */
+VisualizerConfig::VisualizerConfig() noexcept {
+
+    // The values the moving 2D graph visualizer used to be compiled with.
+
+    moving_2d_graph_.number_of_particles = 300;
+    moving_2d_graph_.number_of_bands = 1024;
+    moving_2d_graph_.edge_distance = 40;
+    moving_2d_graph_.edge_fade_distance = 0;
+    moving_2d_graph_.bar_height = 250;
+    moving_2d_graph_.bar_margin = 20;
+    moving_2d_graph_.bar_bottom = 75;
+    moving_2d_graph_.bar_color = FrameColor{209, 38, 48, 100};
+    moving_2d_graph_.circle_color = FrameColor{123, 104, 238, 255};
+
+    // The values the moving 3D graph visualizer used to be compiled with.
+    // (Its bars stood at 700 pixels down a 768 pixel high window.)
+
+    moving_3d_graph_ = moving_2d_graph_;
+    moving_3d_graph_.edge_distance = 140;
+    moving_3d_graph_.edge_fade_distance = 180;
+    moving_3d_graph_.bar_height = 150;
+    moving_3d_graph_.bar_margin = 0;
+    moving_3d_graph_.bar_bottom = 68;
+
+}
+
+/**
+ * Reads the values of a graph visualizer from a section of the configuration.
+ */
+bool VisualizerConfig::readGraphConfig(const JsonValue & section, GraphConfig & config, std::string & error) {
+
+    if (section.is(JsonValue::TYPE_NULL)) {
+        return true;
+    }
+
+    if (!section.is(JsonValue::TYPE_OBJECT)) {
+
+        error = "expected an object";
+
+        return false;
+    }
+
+    float number_of_particles = config.number_of_particles;
+    float number_of_bands = config.number_of_bands;
+
+    if (!readNumber(section, "particles", kMinimumNumberOfParticles, kMaximumNumberOfParticles, number_of_particles, error) ||
+        !readNumber(section, "bands", kMinimumNumberOfBands, kMaximumNumberOfBands, number_of_bands, error) ||
+        !readNumber(section, "edge_distance", 0, 10000, config.edge_distance, error) ||
+        !readNumber(section, "edge_fade_distance", 0, 10000, config.edge_fade_distance, error) ||
+        !readNumber(section, "bar_height", 0, 10000, config.bar_height, error) ||
+        !readNumber(section, "bar_margin", 0, 10000, config.bar_margin, error) ||
+        !readNumber(section, "bar_bottom", -10000, 10000, config.bar_bottom, error) ||
+        !readColor(section, "bar_color", config.bar_color, error) ||
+        !readColor(section, "circle_color", config.circle_color, error)) {
+        return false;
+    }
+
+    config.number_of_particles = (int) number_of_particles;
+    config.number_of_bands = (int) number_of_bands;
+
+    return true;
+
+}
+
+/**
+ * Loads the configuration from the text of a JSON file.
+ */
+bool VisualizerConfig::load(const std::string & text, std::string & error) {
+
+    JsonValue configuration;
+
+    if (!JsonValue::parse(text, configuration, error)) {
+        return false;
+    }
+
+    if (!configuration.is(JsonValue::TYPE_OBJECT)) {
+
+        error = "expected an object";
+
+        return false;
+    }
+
+    // Read into copies, so that nothing changes unless all of the configuration is valid.
+
+    GraphConfig moving_2d_graph = VisualizerConfig().moving_2d_graph_;
+    GraphConfig moving_3d_graph = VisualizerConfig().moving_3d_graph_;
+
+    if (!readGraphConfig(configuration["moving_2d_graph"], moving_2d_graph, error)) {
+
+        error = "moving_2d_graph: " + error;
+
+        return false;
+    }
+
+    if (!readGraphConfig(configuration["moving_3d_graph"], moving_3d_graph, error)) {
+
+        error = "moving_3d_graph: " + error;
+
+        return false;
+    }
+
+    moving_2d_graph_ = moving_2d_graph;
+    moving_3d_graph_ = moving_3d_graph;
+
+    return true;
+
+}
+
+/**
+ * Getter for the configuration of the moving 2D graph visualizer.
+ */
+const GraphConfig & VisualizerConfig::getMoving2DGraphConfig() const {
+
+    return moving_2d_graph_;
+
+}
+
+/**
+ * Getter for the configuration of the moving 3D graph visualizer.
+ */
+const GraphConfig & VisualizerConfig::getMoving3DGraphConfig() const {
+
+    return moving_3d_graph_;
+
+}
+
+/**
+ * Returns the fewest particles a graph may have.
+ */
+int VisualizerConfig::getMinimumNumberOfParticles() {
+
+    return kMinimumNumberOfParticles;
+
+}
+
+/**
+ * Returns the most particles a graph may have.
+ */
+int VisualizerConfig::getMaximumNumberOfParticles() {
+
+    return kMaximumNumberOfParticles;
+
+}
@@ -0,0 +1,97 @@
+//
+//  VisualizerConfig.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef VisualizerConfig_h
+#define VisualizerConfig_h
+
+#include "JsonValue.h"
+#include "VisualizerFrame.h"
+#include <string>
+
+/**
+ * The tunable values of a moving graph visualizer (those which used to be compiled in).
+ */
+struct GraphConfig {
+
+    int number_of_particles; // "particles": the number of particles of the graph
+
+    int number_of_bands; // "bands": the number of (linearly spaced) bands of the spectrum the graph is updated with
+
+    float edge_distance; // "edge_distance": how close (in pixels) two particles are to have an edge
+
+    float edge_fade_distance; // "edge_fade_distance": the distance (in pixels) at which an edge fades out (3D)
+
+    float bar_height; // "bar_height": the height (in pixels) of a bar per unit of its band's value
+
+    float bar_margin; // "bar_margin": the margin (in pixels) to the left and right of the bars
+
+    float bar_bottom; // "bar_bottom": the distance (in pixels) from the bottom of the window to the foot of the bars
+
+    FrameColor bar_color; // "bar_color": the colour ([r, g, b, a]) of the bars (2D)
+
+    FrameColor circle_color; // "circle_color": the colour ([r, g, b]) of the concentric circles (2D)
+
+};
+
+/**
+ * Class that models the configuration of the visualizers, read from a JSON file, e.g.
+ *
+ *     {"moving_2d_graph": {"particles": 300, "edge_distance": 40, "bar_color": [209, 38, 48, 100]},
+ *      "moving_3d_graph": {"particles": 200, "edge_distance": 140}}
+ *
+ * Every value is optional: what is left out keeps its default (the value which used to be compiled in).
+ */
+class VisualizerConfig {
+
+    GraphConfig moving_2d_graph_; // the configuration of the moving 2D graph visualizer
+
+    GraphConfig moving_3d_graph_; // the configuration of the moving 3D graph visualizer
+
+    /**
+     * Reads the values of a graph visualizer from a section of the configuration.
+     */
+    static bool readGraphConfig(const JsonValue & section, GraphConfig & config, std::string & error);
+
+public:
+
+    /**
+     * Constructor for a VisualizerConfig object, with the default values.
+     */
+    VisualizerConfig() noexcept;
+
+    /**
+     * Loads the configuration from the text of a JSON file. If it is not valid, the configuration is left as it is.
+     *
+     * @param text - the text of the file
+     * @param error - set to what is wrong with the configuration, if it is not valid
+     * @return true if the configuration was loaded, false otherwise
+     */
+    bool load(const std::string & text, std::string & error);
+
+    /**
+     * Getter for the configuration of the moving 2D graph visualizer.
+     */
+    const GraphConfig & getMoving2DGraphConfig() const;
+
+    /**
+     * Getter for the configuration of the moving 3D graph visualizer.
+     */
+    const GraphConfig & getMoving3DGraphConfig() const;
+
+    /**
+     * Returns the fewest particles a graph may have.
+     */
+    static int getMinimumNumberOfParticles();
+
+    /**
+     * Returns the most particles a graph may have (which the graphs reserve room for up front).
+     */
+    static int getMaximumNumberOfParticles();
+
+};
+
+#endif /* VisualizerConfig_h */
@@ -0,0 +1,221 @@
+//
+//  VisualizerFrame.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef VisualizerFrame_h
+#define VisualizerFrame_h
+
+#include "GeometryBuffer.h"
+#include <cstdint>
+#include <string>
+
+// A VisualizerFrame is a plain description of everything a visualizer wants drawn for one frame.
+// It holds no openFrameworks/openGL state, so the visualizers can fill it in without a window
+// (e.g. for benchmarking or on another thread), and any renderer can draw it.
+//
+// All the arrays of a frame are GeometryBuffers, so a frame object that is reused every frame
+// keeps its capacity and stops allocating once it has grown to the size the visualization needs.
+
+/**
+ * An RGBA colour, with each component in [0, 255].
+ */
+struct FrameColor {
+
+    unsigned char r;
+    unsigned char g;
+    unsigned char b;
+    unsigned char a;
+
+};
+
+/**
+ * A filled circle.
+ */
+struct FrameCircle {
+
+    float x, y, z; // the position of the centre of the circle
+
+    float radius; // the radius of the circle
+
+    FrameColor color; // the colour of the circle
+
+};
+
+/**
+ * A line segment between two (possibly 3D) points.
+ */
+struct FrameLine {
+
+    float x1, y1, z1; // the first end point
+
+    float x2, y2, z2; // the second end point
+
+    FrameColor color; // the colour of the line
+
+};
+
+/**
+ * A filled triangle.
+ */
+struct FrameTriangle {
+
+    float x1, y1; // the first vertex
+
+    float x2, y2; // the second vertex
+
+    float x3, y3; // the third vertex
+
+    FrameColor color; // the colour of the triangle
+
+};
+
+/**
+ * A filled axis-aligned rectangle. The height may be negative (the rectangle then grows upwards).
+ */
+struct FrameRectangle {
+
+    float x, y; // the corner the rectangle is drawn from
+
+    float width, height; // the size of the rectangle
+
+    FrameColor color; // the colour of the rectangle
+
+};
+
+/**
+ * A single vertex of a polyline.
+ */
+struct FrameVertex {
+
+    float x, y;
+
+};
+
+/**
+ * A string to be displayed.
+ */
+struct FrameText {
+
+    std::string text; // the string to be displayed
+
+    float x, y; // the position of the (left end of the) baseline of the string
+
+    int font_size; // the size of the font the string is to be displayed in
+
+    FrameColor color; // the colour of the string
+
+};
+
+/**
+ * A group of primitives that share a coordinate system translation and line width.
+ *
+ * Within a layer, primitives are drawn in the order:
+ * rectangles, circles, triangles, lines, polyline, texts.
+ */
+struct FrameLayer {
+
+    float translate_x, translate_y; // the translation of the coordinate system for this layer
+
+    float line_width; // the width of the lines (and the polyline) in this layer
+
+    GeometryBuffer<FrameRectangle> rectangles;
+
+    GeometryBuffer<FrameCircle> circles;
+
+    GeometryBuffer<FrameTriangle> triangles;
+
+    GeometryBuffer<FrameLine> lines;
+
+    GeometryBuffer<FrameVertex> polyline; // the vertices of an (open) polyline
+
+    FrameColor polyline_color; // the colour of the polyline
+
+    GeometryBuffer<FrameText> texts;
+
+};
+
+/**
+ * Everything to be drawn for a single frame of a visualization.
+ */
+struct VisualizerFrame {
+
+    int width, height; // the size of the window the frame was computed for
+
+    bool has_background; // whether the frame sets its own background colour
+
+    FrameColor background_color; // the background colour (used if has_background is true)
+
+    GeometryBuffer<FrameLayer> layers; // the layers of the frame, drawn in order
+    
+    uint64_t input_capture_time_micros; // the time the newest input sample the frame was computed from was
+                                        // captured (as ofGetElapsedTimeMicros()), or 0 if it is not known
+    
+    float compute_time_ms; // the time (in milliseconds) the frame pipeline's worker took to compute the frame
+
+    /**
+     * Removes all layers from the frame (keeping their capacity), and sets the window size
+     * the next frame is computed for.
+     */
+    void reset(int new_width, int new_height) {
+
+        width = new_width;
+        height = new_height;
+        has_background = false;
+        input_capture_time_micros = 0;
+        compute_time_ms = 0;
+        layers.clear();
+
+    }
+
+    /**
+     * Adds a new (empty) layer to the frame and returns it.
+     * The layer reuses the buffers of the layer that was at its position in the previous frame.
+     */
+    FrameLayer & addLayer(float translate_x, float translate_y, float line_width = 1) {
+
+        FrameLayer & layer = layers.add();
+
+        layer.rectangles.clear();
+        layer.circles.clear();
+        layer.triangles.clear();
+        layer.lines.clear();
+        layer.polyline.clear();
+        layer.texts.clear();
+
+        layer.translate_x = translate_x;
+        layer.translate_y = translate_y;
+        layer.line_width = line_width;
+        layer.polyline_color = FrameColor{255, 255, 255, 255};
+
+        return layer;
+
+    }
+
+    /**
+     * Returns the number of allocations made while the frame was filled in
+     * (since it was last reset). In steady state, this should be zero.
+     */
+    int getAllocationCount() const {
+
+        int allocation_count = layers.getAllocationCount();
+
+        for (size_t index = 0; index < layers.size(); index++) {
+
+            const FrameLayer & layer = layers[index];
+
+            allocation_count += layer.rectangles.getAllocationCount() + layer.circles.getAllocationCount()
+                                + layer.triangles.getAllocationCount() + layer.lines.getAllocationCount()
+                                + layer.polyline.getAllocationCount() + layer.texts.getAllocationCount();
+
+        }
+
+        return allocation_count;
+
+    }
+
+};
+
+#endif /* VisualizerFrame_h */
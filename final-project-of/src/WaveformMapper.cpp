@@ -0,0 +1,330 @@
+//
+//  WaveformMapper.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "WaveformMapper.h"
+#include <algorithm>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define WAVEFORM_MAPPER_USE_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define WAVEFORM_MAPPER_USE_NEON 1
+#endif
+
+// The vertices are written as interleaved x/y floats.
+static_assert(sizeof(FrameVertex) == 2 * sizeof(float), "FrameVertex must be two packed floats");
+
+/**
+ * Constructor for a WaveformMapper object, mapping [-1, 1] to [0, 1] on both axes.
+ */
+WaveformMapper::WaveformMapper() noexcept {
+
+    setup(0, 1, -1, 1, 0, 1);
+
+}
+
+/**
+ * Sets up the mapping of the waveform to the screen.
+ */
+void WaveformMapper::setup(float x_start, float x_end, float lowest_sample, float highest_sample,
+                           float y_for_lowest_sample, float y_for_highest_sample) {
+
+    x_start_ = x_start;
+    x_end_ = x_end;
+
+    // Precompute the linear mapping that ofMap() would otherwise work out for every sample.
+
+    y_scale_ = (y_for_highest_sample - y_for_lowest_sample) / (highest_sample - lowest_sample);
+    y_offset_ = y_for_lowest_sample - lowest_sample * y_scale_;
+
+}
+
+/**
+ * Copies one channel out of interleaved samples into channel_samples_.
+ */
+const float * WaveformMapper::extractChannel(const float * samples, int number_of_frames,
+                                             int number_of_channels, int channel) {
+
+    // A single channel is already contiguous.
+
+    if (number_of_channels == 1) {
+        return samples;
+    }
+
+    channel_samples_.resize(number_of_frames);
+
+    int frame = 0;
+
+#if defined(WAVEFORM_MAPPER_USE_SSE)
+
+    // For stereo, pick out the left or right samples of four frames at a time.
+
+    if (number_of_channels == 2) {
+
+        for (; frame + 4 <= number_of_frames; frame += 4) {
+
+            __m128 first_two_frames = _mm_loadu_ps(samples + 2 * frame);
+            __m128 last_two_frames = _mm_loadu_ps(samples + 2 * frame + 4);
+
+            __m128 channel_samples = (channel == 0)
+                ? _mm_shuffle_ps(first_two_frames, last_two_frames, _MM_SHUFFLE(2, 0, 2, 0))
+                : _mm_shuffle_ps(first_two_frames, last_two_frames, _MM_SHUFFLE(3, 1, 3, 1));
+
+            _mm_storeu_ps(&channel_samples_[frame], channel_samples);
+        }
+    }
+
+#elif defined(WAVEFORM_MAPPER_USE_NEON)
+
+    if (number_of_channels == 2) {
+
+        for (; frame + 4 <= number_of_frames; frame += 4) {
+
+            float32x4x2_t deinterleaved = vld2q_f32(samples + 2 * frame);
+            vst1q_f32(&channel_samples_[frame], deinterleaved.val[channel == 0 ? 0 : 1]);
+        }
+    }
+
+#endif
+
+    for (; frame < number_of_frames; frame++) {
+        channel_samples_[frame] = samples[frame * number_of_channels + channel];
+    }
+
+    return channel_samples_.data();
+
+}
+
+/**
+ * Computes the min/max envelope of the samples, for the given number of columns.
+ */
+void WaveformMapper::computeEnvelope(const float * samples, int number_of_frames, int number_of_columns) {
+
+    column_minimums_.resize(number_of_columns);
+    column_maximums_.resize(number_of_columns);
+
+    for (int column = 0; column < number_of_columns; column++) {
+
+        // The samples [begin, end) fall in this column.
+
+        int begin = (int) ((long long) column * number_of_frames / number_of_columns);
+        int end = (int) ((long long) (column + 1) * number_of_frames / number_of_columns);
+
+        float minimum = samples[begin];
+        float maximum = samples[begin];
+
+        int index = begin;
+
+#if defined(WAVEFORM_MAPPER_USE_SSE)
+
+        if (end - begin >= 4) {
+
+            __m128 minimums = _mm_loadu_ps(samples + index);
+            __m128 maximums = minimums;
+
+            for (index += 4; index + 4 <= end; index += 4) {
+
+                __m128 values = _mm_loadu_ps(samples + index);
+                minimums = _mm_min_ps(minimums, values);
+                maximums = _mm_max_ps(maximums, values);
+            }
+
+            // Reduce the four lanes to one.
+
+            minimums = _mm_min_ps(minimums, _mm_movehl_ps(minimums, minimums));
+            minimums = _mm_min_ss(minimums, _mm_shuffle_ps(minimums, minimums, _MM_SHUFFLE(1, 1, 1, 1)));
+            maximums = _mm_max_ps(maximums, _mm_movehl_ps(maximums, maximums));
+            maximums = _mm_max_ss(maximums, _mm_shuffle_ps(maximums, maximums, _MM_SHUFFLE(1, 1, 1, 1)));
+
+            minimum = _mm_cvtss_f32(minimums);
+            maximum = _mm_cvtss_f32(maximums);
+        }
+
+#elif defined(WAVEFORM_MAPPER_USE_NEON)
+
+        if (end - begin >= 4) {
+
+            float32x4_t minimums = vld1q_f32(samples + index);
+            float32x4_t maximums = minimums;
+
+            for (index += 4; index + 4 <= end; index += 4) {
+
+                float32x4_t values = vld1q_f32(samples + index);
+                minimums = vminq_f32(minimums, values);
+                maximums = vmaxq_f32(maximums, values);
+            }
+
+            float32x2_t minimum_pair = vpmin_f32(vget_low_f32(minimums), vget_high_f32(minimums));
+            float32x2_t maximum_pair = vpmax_f32(vget_low_f32(maximums), vget_high_f32(maximums));
+
+            minimum = vget_lane_f32(vpmin_f32(minimum_pair, minimum_pair), 0);
+            maximum = vget_lane_f32(vpmax_f32(maximum_pair, maximum_pair), 0);
+        }
+
+#endif
+
+        for (; index < end; index++) {
+
+            minimum = std::min(minimum, samples[index]);
+            maximum = std::max(maximum, samples[index]);
+        }
+
+        column_minimums_[column] = minimum;
+        column_maximums_[column] = maximum;
+    }
+
+}
+
+/**
+ * Maps sample values to y coordinates (y = v * y_scale_ + y_offset_) in place.
+ */
+void WaveformMapper::mapValues(float * values, int number_of_values) {
+
+    int index = 0;
+
+#if defined(WAVEFORM_MAPPER_USE_SSE)
+
+    __m128 scale = _mm_set1_ps(y_scale_);
+    __m128 offset = _mm_set1_ps(y_offset_);
+
+    for (; index + 4 <= number_of_values; index += 4) {
+        _mm_storeu_ps(values + index, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(values + index), scale), offset));
+    }
+
+#elif defined(WAVEFORM_MAPPER_USE_NEON)
+
+    float32x4_t scale = vdupq_n_f32(y_scale_);
+    float32x4_t offset = vdupq_n_f32(y_offset_);
+
+    for (; index + 4 <= number_of_values; index += 4) {
+        vst1q_f32(values + index, vmlaq_f32(offset, vld1q_f32(values + index), scale));
+    }
+
+#endif
+
+    for (; index < number_of_values; index++) {
+        values[index] = values[index] * y_scale_ + y_offset_;
+    }
+
+}
+
+/**
+ * Writes the vertices with the x coordinates x_start_ + i * x_step (shared by the two vertices of a column
+ * if is_envelope is true) and the y coordinates in y_coordinates_.
+ */
+void WaveformMapper::writeVertices(int number_of_vertices, float x_step, bool is_envelope,
+                                   GeometryBuffer<FrameVertex> & vertices) {
+
+    // Compute the x coordinates, and interleave them with the y coordinates into the vertices.
+
+    x_coordinates_.resize(number_of_vertices);
+
+    for (int index = 0; index < number_of_vertices; index++) {
+        x_coordinates_[index] = x_start_ + (is_envelope ? (index & ~1) : index) * x_step;
+    }
+
+    vertices.resize(number_of_vertices);
+
+    float * vertex_coordinates = reinterpret_cast<float *>(vertices.data());
+
+    int index = 0;
+
+#if defined(WAVEFORM_MAPPER_USE_SSE)
+
+    for (; index + 4 <= number_of_vertices; index += 4) {
+
+        __m128 x = _mm_loadu_ps(&x_coordinates_[index]);
+        __m128 y = _mm_loadu_ps(&y_coordinates_[index]);
+
+        _mm_storeu_ps(vertex_coordinates + 2 * index, _mm_unpacklo_ps(x, y));
+        _mm_storeu_ps(vertex_coordinates + 2 * index + 4, _mm_unpackhi_ps(x, y));
+    }
+
+#elif defined(WAVEFORM_MAPPER_USE_NEON)
+
+    for (; index + 4 <= number_of_vertices; index += 4) {
+
+        float32x4x2_t interleaved;
+        interleaved.val[0] = vld1q_f32(&x_coordinates_[index]);
+        interleaved.val[1] = vld1q_f32(&y_coordinates_[index]);
+
+        vst2q_f32(vertex_coordinates + 2 * index, interleaved);
+    }
+
+#endif
+
+    for (; index < number_of_vertices; index++) {
+
+        vertex_coordinates[2 * index] = x_coordinates_[index];
+        vertex_coordinates[2 * index + 1] = y_coordinates_[index];
+    }
+
+}
+
+/**
+ * Maps one channel of a window of (interleaved) samples to the vertices of a waveform polyline.
+ */
+void WaveformMapper::map(const float * samples, int number_of_frames, int number_of_channels, int channel,
+                         int number_of_columns, GeometryBuffer<FrameVertex> & vertices) {
+
+    vertices.clear();
+
+    if (number_of_frames <= 0 || number_of_columns <= 0) {
+        return;
+    }
+
+    const float * channel_samples = extractChannel(samples, number_of_frames, number_of_channels, channel);
+
+    if (number_of_frames > number_of_columns) {
+
+        // Every column becomes two vertices: its minimum and its maximum.
+
+        computeEnvelope(channel_samples, number_of_frames, number_of_columns);
+        mapEnvelope(column_minimums_.data(), column_maximums_.data(), number_of_columns, vertices);
+
+        return;
+    }
+
+    // Every sample becomes a vertex.
+
+    y_coordinates_.assign(channel_samples, channel_samples + number_of_frames);
+    mapValues(y_coordinates_.data(), number_of_frames);
+
+    writeVertices(number_of_frames, (x_end_ - x_start_) / number_of_frames, false, vertices);
+
+}
+
+/**
+ * Maps a precomputed min/max envelope to the vertices of a waveform polyline.
+ */
+void WaveformMapper::mapEnvelope(const float * minimums, const float * maximums, int number_of_columns,
+                                 GeometryBuffer<FrameVertex> & vertices) {
+
+    vertices.clear();
+
+    if (number_of_columns <= 0) {
+        return;
+    }
+
+    int number_of_vertices = 2 * number_of_columns;
+
+    y_coordinates_.resize(number_of_vertices);
+
+    for (int column = 0; column < number_of_columns; column++) {
+
+        y_coordinates_[2 * column] = minimums[column];
+        y_coordinates_[2 * column + 1] = maximums[column];
+    }
+
+    mapValues(y_coordinates_.data(), number_of_vertices);
+
+    // Both vertices of a column share its x coordinate.
+
+    writeVertices(number_of_vertices, 0.5f * (x_end_ - x_start_) / number_of_columns, true, vertices);
+
+}
@@ -0,0 +1,112 @@
+//
+//  WaveformMapper.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef WaveformMapper_h
+#define WaveformMapper_h
+
+#include "VisualizerFrame.h"
+#include <vector>
+
+/**
+ * Class that maps a window of audio samples to the screen-space vertices of a time waveform.
+ *
+ * The mapping from sample values/indices to y/x coordinates is precomputed as a scale and an offset,
+ * and applied to all the samples (or columns) in one vectorized pass (SSE on x86, NEON on ARM, with
+ * a scalar fallback).
+ *
+ * If there are more samples than pixel columns to draw them in, each column gets the minimum and
+ * maximum of the samples that fall in it (a min/max envelope) instead of every n-th sample, so that
+ * decimating the waveform does not alias. This keeps windows of 16k samples (and more) cheap to draw.
+ */
+class WaveformMapper {
+
+    float x_start_, x_end_; // the horizontal screen range the window of samples is mapped to
+
+    float y_scale_, y_offset_; // the precomputed mapping of a sample value v to the y coordinate v * y_scale_ + y_offset_
+
+    std::vector<float> channel_samples_; // the samples of the mapped channel, when they are interleaved with other channels
+
+    std::vector<float> column_minimums_; // the minimum sample of each pixel column
+
+    std::vector<float> column_maximums_; // the maximum sample of each pixel column
+
+    std::vector<float> x_coordinates_; // the x coordinates of the vertices
+
+    std::vector<float> y_coordinates_; // the y coordinates of the vertices
+
+    /**
+     * Copies one channel out of interleaved samples into channel_samples_.
+     */
+    const float * extractChannel(const float * samples, int number_of_frames, int number_of_channels, int channel);
+
+    /**
+     * Computes the min/max envelope of the samples, for the given number of columns.
+     */
+    void computeEnvelope(const float * samples, int number_of_frames, int number_of_columns);
+
+    /**
+     * Maps sample values to y coordinates (y = v * y_scale_ + y_offset_) in place.
+     */
+    void mapValues(float * values, int number_of_values);
+
+    /**
+     * Writes the vertices with the x coordinates x_start_ + i * x_step (shared by the two vertices of a column
+     * if is_envelope is true) and the y coordinates in y_coordinates_.
+     */
+    void writeVertices(int number_of_vertices, float x_step, bool is_envelope, GeometryBuffer<FrameVertex> & vertices);
+
+public:
+
+    /**
+     * Constructor for a WaveformMapper object, mapping [-1, 1] to [0, 1] on both axes.
+     */
+    WaveformMapper() noexcept;
+
+    /**
+     * Sets up the mapping of the waveform to the screen.
+     *
+     * @param x_start - the x coordinate of the first sample
+     * @param x_end - the x coordinate just past the last sample
+     * @param lowest_sample - the sample value which is mapped to y_for_lowest_sample
+     * @param highest_sample - the sample value which is mapped to y_for_highest_sample
+     * @param y_for_lowest_sample - the y coordinate of lowest_sample
+     * @param y_for_highest_sample - the y coordinate of highest_sample
+     */
+    void setup(float x_start, float x_end, float lowest_sample, float highest_sample,
+               float y_for_lowest_sample, float y_for_highest_sample);
+
+    /**
+     * Maps one channel of a window of (interleaved) samples to the vertices of a waveform polyline.
+     *
+     * If the window has no more samples than there are columns, every sample becomes a vertex.
+     * Otherwise, each column contributes two vertices: the minimum and the maximum of its samples.
+     *
+     * @param samples - the interleaved samples of the window
+     * @param number_of_frames - the number of frames (samples per channel) in the window
+     * @param number_of_channels - the number of interleaved channels
+     * @param channel - the channel to be mapped
+     * @param number_of_columns - the number of pixel columns the waveform is drawn in
+     * @param vertices - the buffer the vertices are written to (it is cleared first)
+     */
+    void map(const float * samples, int number_of_frames, int number_of_channels, int channel,
+             int number_of_columns, GeometryBuffer<FrameVertex> & vertices);
+
+    /**
+     * Maps a precomputed min/max envelope (e.g. from a WaveformPyramid) to the vertices of a waveform polyline.
+     * Each column contributes two vertices: its minimum and its maximum.
+     *
+     * @param minimums - the minimum sample of each column
+     * @param maximums - the maximum sample of each column
+     * @param number_of_columns - the number of columns
+     * @param vertices - the buffer the vertices are written to (it is cleared first)
+     */
+    void mapEnvelope(const float * minimums, const float * maximums, int number_of_columns,
+                     GeometryBuffer<FrameVertex> & vertices);
+
+};
+
+#endif /* WaveformMapper_h */
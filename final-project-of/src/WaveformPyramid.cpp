@@ -0,0 +1,236 @@
+//
+//  WaveformPyramid.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "WaveformPyramid.h"
+#include <algorithm>
+#include <limits>
+
+const float kEmptyMinimum = std::numeric_limits<float>::max(); // the minimum of a node without samples
+
+const float kEmptyMaximum = - std::numeric_limits<float>::max(); // the maximum of a node without samples
+
+/**
+ * Constructor for an (empty) WaveformPyramid object.
+ */
+WaveformPyramid::WaveformPyramid() noexcept {
+    
+    clear();
+    
+}
+
+/**
+ * Removes all the samples from the pyramid.
+ */
+void WaveformPyramid::clear() {
+    
+    levels_.clear();
+    number_of_frames_ = 0;
+    
+    pending_minimum_ = kEmptyMinimum;
+    pending_maximum_ = kEmptyMaximum;
+    pending_count_ = 0;
+    
+}
+
+/**
+ * Getter for the number of frames appended (or skipped) so far.
+ */
+long long WaveformPyramid::getNumberOfFrames() const {
+    
+    return number_of_frames_;
+    
+}
+
+/**
+ * Adds a complete node to the given level, and completes a node of the level above if
+ * that fills a pair.
+ */
+void WaveformPyramid::pushNode(int level, float minimum, float maximum) {
+    
+    // Cascade upwards as long as pairs are completed.
+    
+    while (true) {
+        
+        if (level == (int) levels_.size()) {
+            levels_.push_back(Level());
+        }
+        
+        Level & current_level = levels_[level];
+        
+        current_level.minimums.push_back(minimum);
+        current_level.maximums.push_back(maximum);
+        
+        int size = current_level.minimums.size();
+        
+        if (size % 2 != 0) {
+            break;
+        }
+        
+        minimum = std::min(current_level.minimums[size - 2], current_level.minimums[size - 1]);
+        maximum = std::max(current_level.maximums[size - 2], current_level.maximums[size - 1]);
+        level++;
+    }
+    
+}
+
+/**
+ * Appends interleaved samples to the end of the pyramid.
+ */
+void WaveformPyramid::append(const float * samples, int number_of_frames, int number_of_channels) {
+    
+    for (int frame = 0; frame < number_of_frames; frame++) {
+        
+        // The envelope is taken over all channels.
+        
+        for (int channel = 0; channel < number_of_channels; channel++) {
+            
+            float sample = samples[frame * number_of_channels + channel];
+            
+            pending_minimum_ = std::min(pending_minimum_, sample);
+            pending_maximum_ = std::max(pending_maximum_, sample);
+        }
+        
+        pending_count_++;
+        
+        if (pending_count_ == kBaseBlockSize) {
+            
+            pushNode(0, pending_minimum_, pending_maximum_);
+            
+            pending_minimum_ = kEmptyMinimum;
+            pending_maximum_ = kEmptyMaximum;
+            pending_count_ = 0;
+        }
+    }
+    
+    number_of_frames_ += number_of_frames;
+    
+}
+
+/**
+ * Appends frames for which there are no samples (e.g. after seeking forward).
+ */
+void WaveformPyramid::skip(long long number_of_frames) {
+    
+    number_of_frames_ += number_of_frames;
+    
+    // First, complete the pending block.
+    
+    long long frames_to_complete_block = std::min(number_of_frames, (long long) (kBaseBlockSize - pending_count_));
+    
+    pending_count_ += frames_to_complete_block;
+    number_of_frames -= frames_to_complete_block;
+    
+    if (pending_count_ < kBaseBlockSize) {
+        return;
+    }
+    
+    pushNode(0, pending_minimum_, pending_maximum_);
+    
+    // Then, add empty blocks, and leave the rest pending.
+    
+    for (; number_of_frames >= kBaseBlockSize; number_of_frames -= kBaseBlockSize) {
+        pushNode(0, kEmptyMinimum, kEmptyMaximum);
+    }
+    
+    pending_minimum_ = kEmptyMinimum;
+    pending_maximum_ = kEmptyMaximum;
+    pending_count_ = number_of_frames;
+    
+}
+
+/**
+ * Computes the min/max envelope of the frames [start_frame, end_frame) for the given number of columns.
+ * Columns without any samples get a minimum greater than their maximum.
+ */
+void WaveformPyramid::query(long long start_frame, long long end_frame, int number_of_columns,
+                            std::vector<float> & minimums, std::vector<float> & maximums) const {
+    
+    minimums.assign(number_of_columns, kEmptyMinimum);
+    maximums.assign(number_of_columns, kEmptyMaximum);
+    
+    if (number_of_columns <= 0 || end_frame <= start_frame) {
+        return;
+    }
+    
+    // Pick the coarsest level whose nodes are no larger than a column.
+    
+    double frames_per_column = (double) (end_frame - start_frame) / number_of_columns;
+    
+    int level = 0;
+    long long node_size = kBaseBlockSize;
+    
+    while (level + 1 < (int) levels_.size() && 2 * node_size <= frames_per_column) {
+        
+        level++;
+        node_size *= 2;
+    }
+    
+    for (int column = 0; column < number_of_columns; column++) {
+        
+        long long column_start = start_frame + (long long) (column * frames_per_column);
+        long long column_end = start_frame + (long long) ((column + 1) * frames_per_column);
+        
+        float minimum = kEmptyMinimum;
+        float maximum = kEmptyMaximum;
+        
+        // The nodes overlapping the column (there are at most a few, since nodes are no larger than a column).
+        
+        if (level < (int) levels_.size()) {
+            
+            const Level & current_level = levels_[level];
+            
+            long long first_node = std::max(column_start, 0LL) / node_size;
+            long long last_node = std::min((column_end + node_size - 1) / node_size, (long long) current_level.minimums.size());
+            
+            for (long long node = first_node; node < last_node; node++) {
+                
+                minimum = std::min(minimum, current_level.minimums[node]);
+                maximum = std::max(maximum, current_level.maximums[node]);
+            }
+        }
+        
+        // The most recent frames, which have not filled a node of level 0 yet, are only in the pending block.
+        
+        long long pending_start = number_of_frames_ - pending_count_;
+        
+        if (pending_count_ > 0 && column_end > pending_start && column_start < number_of_frames_) {
+            
+            minimum = std::min(minimum, pending_minimum_);
+            maximum = std::max(maximum, pending_maximum_);
+        }
+        
+        // So are frames past the last complete node of this level but before the pending block.
+        // (They are covered by the finer levels, so walk down to level 0 for them.)
+        
+        if (level > 0 && level < (int) levels_.size()) {
+            
+            long long covered_frames = (long long) levels_[level].minimums.size() * node_size;
+            
+            for (int finer_level = level - 1; finer_level >= 0 && covered_frames < pending_start; finer_level--) {
+                
+                const Level & current_level = levels_[finer_level];
+                long long finer_node_size = (long long) kBaseBlockSize << finer_level;
+                
+                long long first_node = std::max(std::max(column_start, 0LL), covered_frames) / finer_node_size;
+                long long last_node = std::min((column_end + finer_node_size - 1) / finer_node_size,
+                                               (long long) current_level.minimums.size());
+                
+                for (long long node = first_node; node < last_node; node++) {
+                    
+                    minimum = std::min(minimum, current_level.minimums[node]);
+                    maximum = std::max(maximum, current_level.maximums[node]);
+                }
+                
+                covered_frames = std::max(covered_frames, (long long) current_level.minimums.size() * finer_node_size);
+            }
+        }
+        
+        minimums[column] = minimum;
+        maximums[column] = maximum;
+    }
+    
+}
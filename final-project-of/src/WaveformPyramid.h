@@ -0,0 +1,105 @@
+//
+//  WaveformPyramid.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef WaveformPyramid_h
+#define WaveformPyramid_h
+
+#include <vector>
+
+/**
+ * Class that models a multi-resolution min/max pyramid over the samples of a track.
+ *
+ * Level 0 stores the minimum and maximum (over all channels) of each block of kBaseBlockSize frames,
+ * and every level above stores the min/max of pairs of nodes of the level below. The pyramid is built
+ * incrementally as samples are appended, so it can be fed while a track is decoded or played.
+ *
+ * Querying the envelope of any span of the track for a number of columns picks the level whose nodes are
+ * just smaller than a column, so it costs O(number of columns), however many samples the span covers.
+ */
+class WaveformPyramid {
+    
+public:
+    
+    static const int kBaseBlockSize = 128; // the number of frames covered by a node of level 0
+    
+private:
+    
+    /**
+     * A level of the pyramid.
+     */
+    struct Level {
+        
+        std::vector<float> minimums; // the minimum sample of each node
+        
+        std::vector<float> maximums; // the maximum sample of each node
+        
+    };
+    
+    std::vector<Level> levels_; // the levels of the pyramid, from the finest (0) to the coarsest
+    
+    long long number_of_frames_; // the number of frames appended (including skipped frames)
+    
+    float pending_minimum_; // the minimum of the incomplete block of level 0
+    
+    float pending_maximum_; // the maximum of the incomplete block of level 0
+    
+    int pending_count_; // the number of frames in the incomplete block of level 0
+    
+    /**
+     * Adds a complete node to the given level, and completes a node of the level above if
+     * that fills a pair.
+     */
+    void pushNode(int level, float minimum, float maximum);
+    
+public:
+    
+    /**
+     * Constructor for an (empty) WaveformPyramid object.
+     */
+    WaveformPyramid() noexcept;
+    
+    /**
+     * Removes all the samples from the pyramid.
+     */
+    void clear();
+    
+    /**
+     * Getter for the number of frames appended (or skipped) so far.
+     */
+    long long getNumberOfFrames() const;
+    
+    /**
+     * Appends interleaved samples to the end of the pyramid.
+     *
+     * @param samples - the interleaved samples
+     * @param number_of_frames - the number of frames (samples per channel)
+     * @param number_of_channels - the number of interleaved channels
+     */
+    void append(const float * samples, int number_of_frames, int number_of_channels);
+    
+    /**
+     * Appends frames for which there are no samples (e.g. after seeking forward).
+     * They show up as empty columns in queries.
+     */
+    void skip(long long number_of_frames);
+    
+    /**
+     * Computes the min/max envelope of the frames [start_frame, end_frame) for the given number of columns.
+     * Columns without any samples get a minimum greater than their maximum.
+     *
+     * @param start_frame - the first frame of the span (may be negative)
+     * @param end_frame - the frame just past the span
+     * @param number_of_columns - the number of columns the span is divided into
+     * @param minimums - the minimum of each column is written here
+     * @param maximums - the maximum of each column is written here
+     */
+    void query(long long start_frame, long long end_frame, int number_of_columns,
+               std::vector<float> & minimums, std::vector<float> & maximums) const;
+    
+};
+
+#endif /* WaveformPyramid_h */
@@ -1,5 +1,6 @@
 #include "ofMain.h"
 #include "ofApp.h"
+#include "FftBenchmark.h"
 
 // Final Project for CS 126
 // Music Visualization
@@ -9,8 +10,88 @@
 
 /**
  * The main function to be run.
+ *
+ * The following command line options are understood:
+ *   --input-file <path>     feed the live input from a .wav/.mp3 file instead of the sound input device
+ *   --input-speed <factor>  feed the file in this many times faster than real time (default 1)
+ *   --input-buffer-size <frames>  capture the live input this many frames at a time (a power of 2, default 256)
+ *   --visualization <key>   open the visualization of that key (G, D, F or T) right away
+ *   --target-frame-time <ms>  the 95th percentile frame time the quality governor holds (default 16.6)
+ *   --size <width>x<height> the size of the window (or of the frames rendered headless), e.g. 1920x1080
+ *   --headless <path>       run without a window or a GPU, rasterizing the frames on the CPU, and writing them
+ *                           to the file as raw 8-bit RGB (with --input-file and --visualization)
+ *   --benchmark-fft         benchmark the FFT backend (for 256 to 8192 bins), and exit
+ *
+ * (The first three allow the live input path to be load tested unattended, without a sound card.)
  */
-int main() {
+int main(int argc, char * argv[]) {
+    
+    std::string input_file_path;
+    float input_speed = 1;
+    int input_buffer_size = 0;
+    int startup_key = 0;
+    float target_frame_time_ms = 16.6;
+    int width = 1024;
+    int height = 768;
+    std::string headless_output_path;
+    
+    for (int index = 1; index < argc; index++) {
+        
+        std::string option = argv[index];
+        
+        if (option == "--benchmark-fft") {
+            
+            FftBenchmark::run();
+            return 0;
+            
+        }
+        
+        if (index + 1 == argc) {
+            
+            ofLogError("main") << "No value given for " << option;
+            break;
+            
+        }
+        
+        std::string value = argv[++index];
+        
+        if (option == "--input-file") {
+            input_file_path = value;
+        } else if (option == "--input-speed") {
+            input_speed = ofToFloat(value);
+        } else if (option == "--input-buffer-size") {
+            
+            if (LiveInput::isValidBufferSize(ofToInt(value))) {
+                input_buffer_size = ofToInt(value);
+            } else {
+                ofLogError("main") << "Invalid input buffer size " << value << " (expected a power of 2 from "
+                                   << LiveInput::getMinimumBufferSize() << " to "
+                                   << LiveInput::getMaximumBufferSize() << ")";
+            }
+            
+        } else if (option == "--visualization") {
+            startup_key = value[0];
+        } else if (option == "--target-frame-time") {
+            target_frame_time_ms = ofToFloat(value);
+        } else if (option == "--size") {
+            
+            std::vector<std::string> dimensions = ofSplitString(value, "x");
+            
+            if (dimensions.size() == 2 && ofToInt(dimensions[0]) > 0 && ofToInt(dimensions[1]) > 0) {
+                
+                width = ofToInt(dimensions[0]);
+                height = ofToInt(dimensions[1]);
+                
+            } else {
+                ofLogError("main") << "Invalid size " << value << " (expected <width>x<height>)";
+            }
+            
+        } else if (option == "--headless") {
+            headless_output_path = value;
+        } else {
+            ofLogError("main") << "Unknown option " << option;
+        }
+    }
     
     // Set up the openFrameworks/openGL window
     // which is the display for the application.
@@ -20,11 +101,35 @@ int main() {
     // OF_WINDOW (display of specified width and height) or
     // OF_FULLSCREEN (full-screen display).)
     
-    ofSetupOpenGL(1024,768,OF_WINDOW);
+    //
+    // Run headless, there is no openGL window at all (the frames are rasterized on the CPU instead).
+    
+    if (headless_output_path.empty()) {
+        ofSetupOpenGL(width, height, OF_WINDOW);
+    } else {
+        ofSetupOpenGL(std::make_shared<ofAppNoWindow>(), width, height, OF_WINDOW);
+    }
 
-	// The below line kicks off
+	// The below lines kick off
     // the running of my application.
     
-	ofRunApp(new ofApp());
+    ofApp * app = new ofApp();
+    
+    if (!input_file_path.empty()) {
+        app->setLiveInputFile(input_file_path, input_speed);
+    }
+    
+    if (input_buffer_size != 0) {
+        app->setLiveInputBufferSize(input_buffer_size);
+    }
+    
+    app->setStartupKey(startup_key);
+    app->setTargetFrameTime(target_frame_time_ms);
+    
+    if (!headless_output_path.empty()) {
+        app->setHeadlessOutput(headless_output_path);
+    }
+    
+	ofRunApp(app);
 
 }
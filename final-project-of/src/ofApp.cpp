@@ -5,12 +5,26 @@
 
 const int kDefaultTextSize = 20; // the int constant storing the default font display size
 
-const float kDefaultSongPlaySpeed = 1.0f; // the float constant storing the default play speed for music
-
 const int kTurquoiseColourHexValue = 0xC9E9F6; // the int (hex) value for turquoise colour.
 
 const int kBlackColourHexValue = 0x000000; // the int (hex) value for black colour.
 
+const int kLiveInputSampleRate = 44100; // the sample rate the live input is captured at
+
+const int kDefaultLiveInputBufferSize = 256; // the number of frames the live input is captured in at a time,
+                                             // unless another is set
+                                             // (smaller buffers give a lower latency, but risk dropouts)
+
+const int kLiveInputNumberOfChannels = 2; // the number of channels of the live input
+
+const int kWaveformWindowSizes[] = { 1024, 4096, 16384 }; // the window sizes (in samples) the N key cycles the
+                                                         // FFT visualization's time waveform through
+
+const int kNumberOfWaveformWindowSizes = sizeof(kWaveformWindowSizes) / sizeof(kWaveformWindowSizes[0]);
+
+const int kMaximumFramesToCatchUp = 48000; // the most frames the visualizers analyze in one frame (about a second);
+                                           // if more have gone by (e.g. the song was sought), they start over
+
 std::string song_to_play = "indian_summer.mp3"; // string containing the name of the song to be played
 
 ofTrueTypeFont temporary_font_loader_; // an extra font loader for different fonts used within the app
@@ -26,6 +40,66 @@ ofTrueTypeFont temporary_font_loader_; // an extra font loader for different fon
 //
 // FFTVisualizer is a class having functions to create the FFT Visualization.
 
+/**
+ * Constructor for the application, which captures the live input from the default input device.
+ */
+ofApp::ofApp() noexcept {
+    
+    live_input_file_speed_ = 1;
+    live_input_buffer_size_ = kDefaultLiveInputBufferSize;
+    startup_key_ = 0;
+    frame_start_time_micros_ = 0;
+    chosen_number_of_particles_ = 0;
+    gui_ = nullptr;
+    
+}
+
+/**
+ * Makes a file stand in for the sound input device, and starts the application in live input mode.
+ */
+void ofApp::setLiveInputFile(const std::string & path, float speed) {
+    
+    live_input_file_path_ = path;
+    live_input_file_speed_ = speed;
+    
+}
+
+/**
+ * Sets the number of frames the live input is captured in at a time.
+ */
+void ofApp::setLiveInputBufferSize(int buffer_size) {
+    
+    live_input_buffer_size_ = buffer_size;
+    
+}
+
+/**
+ * Sets the key to be pressed once the application is set up.
+ */
+void ofApp::setStartupKey(int key) {
+    
+    startup_key_ = key;
+    
+}
+
+/**
+ * Runs the application headless: the frames are rasterized on the CPU, and written to the given file.
+ */
+void ofApp::setHeadlessOutput(const std::string & path) {
+    
+    headless_output_path_ = path;
+    
+}
+
+/**
+ * Sets the 95th percentile frame time the quality governor holds.
+ */
+void ofApp::setTargetFrameTime(float target_frame_time_ms) {
+    
+    quality_governor_.setTargetFrameTime(target_frame_time_ms);
+    
+}
+
 /**
  * The following function sets up the resources for the application.
  */
@@ -45,6 +119,16 @@ void ofApp::setup() {
     
     moving_3d_graph_visualizer_ = Moving3DGraphVisualizer();
     
+    // Read the configuration of the visualizers from config.json, and the mappings of the features of the sound
+    // to the moving graphs' parameters from mappings.json (in the data directory), if there are such files.
+    // Otherwise, the visualizers keep their defaults. Both files are watched, and applied again (between frames)
+    // whenever they change, so that the visualizers can be tuned while they run.
+    
+    config_watcher_.setup("config.json");
+    mappings_watcher_.setup("mappings.json");
+    
+    applyChangedConfig();
+    
     // The below line calls the function that initializes all resources
     // for the FFT visualizer.
     
@@ -58,29 +142,78 @@ void ofApp::setup() {
     // Load the font (.ttf file from ../bin/data directory)
     // which the text is to be displayed in.
     
-    text_font_loader_.load("helvetica.ttf", kDefaultTextSize);
+    // Run headless, there is no openGL context to load the font into (and no window to display text in).
+    // Instead, the file the frames are written to is opened, and the threads which rasterize them are started.
     
-    // Load the song to be visualized and played.
+    if (headless_output_path_.empty()) {
+        
+        text_font_loader_.load("helvetica.ttf", kDefaultTextSize);
+        
+    } else {
+        
+        headless_output_.open(ofToDataPath(headless_output_path_, true).c_str(), std::ios::binary);
+        
+        if (!headless_output_.is_open()) {
+            ofLogError("ofApp") << "Could not open " << headless_output_path_ << " to write the frames to";
+        }
+        
+        software_frame_renderer_.start();
+    }
+    
+    // Decode the song to be visualized and played, in the background.
+    // This is the only time it is decoded: playback and all the visualizations share the decoded samples.
     
-    sound_player_.load(song_to_play);
-    extended_sound_player_.load(song_to_play);
+    track_loader_.start();
+    track_loader_.load(song_to_play);
+    
+    // Read the playlist: the songs listed in playlist.m3u (in the data directory), if there is one,
+    // otherwise all the songs in the data directory. The songs after the current one are decoded ahead of time.
+    
+    if (!ofFile("playlist.m3u").exists() || !playlist_.loadM3u("playlist.m3u")) {
+        playlist_.loadDirectory("");
+    }
+    
+    int song_index = playlist_.findPath(song_to_play);
+    
+    if (song_index != -1) {
+        playlist_.setCurrentIndex(song_index, track_loader_);
+    }
+    
+    playlist_.start();
     
     // Set the song playing to a loop.
     // This means that if the song ends, it will restart playing.
     // This will continuously go on till the application is closed.
     
-    sound_player_.setLoop(true);
-     extended_sound_player_.setLoop(true);
-    
-    // Set the speed to default value (1.0f).
-    // TODO: Add capability to change song speed through a slider in later functions.
-    
-    sound_player_.setSpeed(kDefaultSongPlaySpeed);
-    extended_sound_player_.setSpeed(kDefaultSongPlaySpeed);
+    audio_engine_.setLoop(true);
     
     // Load the SVG background Menu image.
     svg_.load("pattern.svg");
     
+    // Start the worker thread which computes the frames of the visualizations.
+    frame_pipeline_.start();
+    
+    // The profiler overlay is hidden till P is pressed.
+    is_profiler_overlay_visible_ = false;
+    
+    // No sound has been analyzed yet.
+    analyzed_end_frame_ = -1;
+    
+    // The visualizations are fed by the song till L is pressed
+    // (unless a file stands in for the sound input device, which is then fed in right away).
+    
+    is_live_input_mode_ = false;
+    
+    if (!live_input_file_path_.empty()) {
+        is_live_input_mode_ = startLiveInput();
+    }
+    
+    // Open the visualization asked for on the command line, if any.
+    
+    if (startup_key_ != 0) {
+        keyPressed(startup_key_);
+    }
+    
 }
 
 /**
@@ -88,25 +221,90 @@ void ofApp::setup() {
  */
 void ofApp::update() {
     
+    frame_start_time_micros_ = ofGetElapsedTimeMicros();
+    
+    // The visualizers themselves are only updated on the frame pipeline's worker thread.
+    // Here, the input for the next frame is gathered (it must be copied, as the worker
+    // reads it while the main thread moves on) and handed to the pipeline, along with the
+    // current window size.
+    
+    int window_width = ofGetWidth();
+    int window_height = ofGetHeight();
+    
+    // Switch to the song the track loader has decoded, if it has finished,
+    // and keep the next song of the playlist queued.
+    
+    swapInLoadedSong();
+    followPlaylist();
+    
+    // Release the songs the audio engine has switched away from (once the audio thread has let go of them)
+    // on the track loader's thread, as the songs switched away from here are.
+    
+    while (std::shared_ptr<AudioSource> retired_track = audio_engine_.takeRetiredTrack()) {
+        track_loader_.release(std::move(retired_track));
+    }
+    
+    // The visualizers analyze either the song being played, or the live input.
+    // The live input's newest frames are drained from the audio thread first, and the time they were
+    // captured is passed along with the frame computed from them (to measure the input latency).
+    //
+    // Every window and spectrum of the frame is read at the sound being heard right now (as the playback clock,
+    // driven by the frames handed to the sound device, tells), and the visualizers animate by that clock too.
+    
+    AnalysisInput & analysis_input = is_live_input_mode_ ? (AnalysisInput &) live_input_ : (AnalysisInput &) audio_engine_;
+    uint64_t input_capture_time_micros = 0;
+    
+    analysis_input.update();
+    double clock_seconds = analysis_input.getClockSeconds();
+    
+    // Apply the configuration files, if they have been changed (before the next frame is computed).
+    
+    applyChangedConfig();
+    
+    if (is_live_input_mode_) {
+        input_capture_time_micros = live_input_.getCaptureTimeMicros();
+    }
+    
     if (current_state_ == MOVING_2D_GRAPH_VIZ || current_state_ == MOVING_3D_GRAPH_VIZ) {
         
-        // Update the sound player's states.
-        // This updates the current time value in the ofSoundPlayer
-        // and updates the spectrum band values for the next time interval.
+        // Get the sound which has been played (or heard) since the last frame, up to the end of the current window,
+        // for the beats to be tracked from. (The beat tracker analyzes every frame once, and hands a beat on
+        // at most a hop after it is heard.)
+        
+        int beat_window_size = beat_tracker_.getWindowSize();
+        long long window_end_frame = analysis_input.getCurrentWindowStartFrame(beat_window_size) + beat_window_size;
         
-        ofSoundUpdate();
+        long long new_start_frame;
+        ofSoundBuffer new_sound_buffer = getNewSoundBuffer(analysis_input, window_end_frame, beat_window_size,
+                                                           new_start_frame);
         
         if (current_state_ == MOVING_2D_GRAPH_VIZ) {
             
             // Get the newly updated spectrum values.
             // These are values for various frequencies within the specified number of bands.
             
-            float * current_sound_spectrum_values = ofSoundGetSpectrum(moving_2d_graph_visualizer_.getNumberOfBands());
+            int number_of_bands = moving_2d_graph_visualizer_.getNumberOfBands();
+            std::vector<float> spectrum_values = analysis_input.getSpectrum(number_of_bands);
+            int sample_rate = analysis_input.getSampleRate();
             
-            // Update the spectrum_value_array_ of the moving 2D graph visualizer with these values
-            // by calling the function responsible for it.
+            // Track the beats of the new sound, then update the spectrum_value_array_ of the moving 2D graph
+            // visualizer with these values (and the beats) by calling the function responsible for it,
+            // then compute the next frame.
             
-            moving_2d_graph_visualizer_.update(current_sound_spectrum_values);
+            frame_pipeline_.submit([this, spectrum_values, sample_rate, new_sound_buffer, new_start_frame,
+                                    window_end_frame, clock_seconds, input_capture_time_micros,
+                                    window_width, window_height] (VisualizerFrame & frame) mutable {
+                
+                beat_tracker_.push(new_sound_buffer.getBuffer().data(), new_sound_buffer.getNumFrames(),
+                                   new_sound_buffer.getNumChannels(), sample_rate, new_start_frame);
+                BeatState beat_state = beat_tracker_.getState(window_end_frame);
+                
+                moving_2d_graph_visualizer_.update(spectrum_values.data(), sample_rate, beat_state,
+                                                   new_sound_buffer.getRMSAmplitude(), clock_seconds);
+                moving_2d_graph_visualizer_.computeFrame(frame, window_width, window_height);
+                frame.input_capture_time_micros = input_capture_time_micros;
+                
+            });
             
         }
         
@@ -115,34 +313,225 @@ void ofApp::update() {
             // Get the newly updated spectrum values.
             // These are values for various frequencies within the specified number of bands.
             
-            float * current_sound_spectrum_values = ofSoundGetSpectrum(moving_3d_graph_visualizer_.getNumberOfBands());
+            int number_of_bands = moving_3d_graph_visualizer_.getNumberOfBands();
+            std::vector<float> spectrum_values = analysis_input.getSpectrum(number_of_bands);
+            int sample_rate = analysis_input.getSampleRate();
             
-            // Update the spectrum_value_array_ of the moving graph visualizer with these values
-            // by calling the function responsible for it.
+            // Track the beats of the new sound, then update the spectrum_value_array_ of the moving graph
+            // visualizer with these values (and the beats) by calling the function responsible for it,
+            // then compute the next frame.
             
-            moving_3d_graph_visualizer_.update(current_sound_spectrum_values);
+            frame_pipeline_.submit([this, spectrum_values, sample_rate, new_sound_buffer, new_start_frame,
+                                    window_end_frame, clock_seconds, input_capture_time_micros,
+                                    window_width, window_height] (VisualizerFrame & frame) mutable {
+                
+                beat_tracker_.push(new_sound_buffer.getBuffer().data(), new_sound_buffer.getNumFrames(),
+                                   new_sound_buffer.getNumChannels(), sample_rate, new_start_frame);
+                BeatState beat_state = beat_tracker_.getState(window_end_frame);
+                
+                moving_3d_graph_visualizer_.update(spectrum_values.data(), sample_rate, beat_state,
+                                                   new_sound_buffer.getRMSAmplitude(), clock_seconds);
+                moving_3d_graph_visualizer_.computeFrame(frame, window_width, window_height);
+                frame.input_capture_time_micros = input_capture_time_micros;
+                
+            });
 
         }
         
     } else if (current_state_ == FFT_VIZ) {
         
-        // Get the sound buffer for the current sound being played.
+        // Get the sound buffer for the current sound being played (or heard), and where it starts.
+        
+        int window_size = fft_visualizer_.getWindowSize();
+        
+        long long window_start_frame = analysis_input.getCurrentWindowStartFrame(window_size);
+        ofSoundBuffer current_sound_buffer = analysis_input.getCurrentSoundBuffer(window_size);
+        
+        // Get the frames up to the end of the window which have not been analyzed yet.
+        
+        long long new_start_frame;
+        ofSoundBuffer new_sound_buffer = getNewSoundBuffer(analysis_input, window_start_frame + window_size,
+                                                           fft_visualizer_.getAnalysisWindowSize(), new_start_frame);
         
-        ofSoundBuffer current_sound_buffer = extended_sound_player_.getCurrentSoundBuffer(fft_visualizer_.getNumberOfBands());
+        // Update the values of the FFT visualizer, then compute the next frame.
         
-        // Update the values of the FFT visualizer.
-        fft_visualizer_.update(current_sound_buffer);
+        frame_pipeline_.submit([this, current_sound_buffer, window_start_frame, new_sound_buffer, new_start_frame,
+                                input_capture_time_micros, window_width, window_height] (VisualizerFrame & frame) {
+            
+            fft_visualizer_.update(current_sound_buffer, window_start_frame, new_sound_buffer, new_start_frame);
+            fft_visualizer_.computeFrame(frame, window_width, window_height);
+            frame.input_capture_time_micros = input_capture_time_micros;
+            
+        });
         
     } else if (current_state_ == TECHNICAL_VIZ) {
         
-        // Get the sound buffer for the current sound being played.
+        // Get the sound which has been played (or heard) since the last frame, up to the end of the current window.
+        
+        int window_size = tech_visualizer_.getNumberOfBands();
+        long long window_end_frame = analysis_input.getCurrentWindowStartFrame(window_size) + window_size;
+        
+        long long new_start_frame;
+        ofSoundBuffer new_sound_buffer = getNewSoundBuffer(analysis_input, window_end_frame, window_size,
+                                                           new_start_frame);
+        
+        // Update the values of the Technical Visualizer, then compute the next frame.
+        
+        frame_pipeline_.submit([this, new_sound_buffer, new_start_frame, input_capture_time_micros, window_width,
+                                window_height] (VisualizerFrame & frame) {
+            
+            tech_visualizer_.update(new_sound_buffer, new_start_frame);
+            tech_visualizer_.computeFrame(frame, window_width, window_height);
+            frame.input_capture_time_micros = input_capture_time_micros;
+            
+        });
+    }
+
+}
+
+/**
+ * This function applies config.json and mappings.json (in the data directory) to the visualizers,
+ * if they have been created or modified since they were last applied.
+ */
+void ofApp::applyChangedConfig() {
+    
+    bool has_config_changed = config_watcher_.hasChanged();
+    bool have_mappings_changed = mappings_watcher_.hasChanged();
+    
+    if (!has_config_changed && !have_mappings_changed) {
+        return;
+    }
+    
+    // The visualizers are changed between frames, once the frame being computed is done.
+    
+    frame_pipeline_.waitUntilIdle();
+    
+    if (has_config_changed) {
+        
+        std::string error;
+        
+        int configured_number_of_particles = visualizer_config_.getMoving2DGraphConfig().number_of_particles;
         
-        ofSoundBuffer current_sound_buffer = extended_sound_player_.getCurrentSoundBuffer(tech_visualizer_.getNumberOfBands());
+        if (!visualizer_config_.load(ofBufferFromFile(config_watcher_.getPath()).getText(), error)) {
+            
+            // Keep the configuration as it was, till the file is fixed.
+            
+            ofLogError("ofApp") << "Could not load " << config_watcher_.getPath() << " (" << error << ")";
+            
+        } else {
+            
+            // A number of particles set in the file replaces the one chosen with the slider.
+            
+            if (visualizer_config_.getMoving2DGraphConfig().number_of_particles != configured_number_of_particles) {
+                chosen_number_of_particles_ = 0;
+            }
+            
+            applyQualityLevel();
+            
+            ofLogNotice("ofApp") << "Applied " << config_watcher_.getPath();
+        }
+    }
+    
+    if (have_mappings_changed) {
         
-        // Update the values of the Technical Visualizer.
-        tech_visualizer_.update(current_sound_buffer);
+        if (moving_2d_graph_visualizer_.loadMappings(mappings_watcher_.getPath()) &&
+            moving_3d_graph_visualizer_.loadMappings(mappings_watcher_.getPath())) {
+            ofLogNotice("ofApp") << "Applied " << mappings_watcher_.getPath();
+        }
     }
+    
+}
 
+/**
+ * This function applies the configuration of the visualizers, at the quality level
+ * the quality governor has set.
+ */
+void ofApp::applyQualityLevel() {
+    
+    // The visualizers are changed between frames, once the frame being computed is done.
+    
+    frame_pipeline_.waitUntilIdle();
+    
+    // (The number of particles chosen with the slider is scaled down as the configured one would be.)
+    
+    moving_2d_graph_visualizer_.applyConfig(quality_governor_.getGovernedConfig(getMoving2DGraphConfig()));
+    moving_3d_graph_visualizer_.applyConfig(quality_governor_.getGovernedConfig(visualizer_config_.getMoving3DGraphConfig()));
+    
+    const QualityLevel & quality_level = quality_governor_.getLevel();
+    
+    fft_visualizer_.setBinsPerBar(quality_level.band_divisor);
+    fft_visualizer_.setWaveformColumnWidth(quality_level.waveform_column_width);
+    
+    // Show the (configured) threshold distance and number of particles (as chosen, rather than as governed)
+    // on the sliders, if they are there.
+    
+    if (current_state_ == MOVING_2D_GRAPH_VIZ && gui_ != nullptr) {
+        
+        gui_->getSlider("THRESHOLD DIST.")->setValue(moving_2d_graph_visualizer_.getThresholdDistanceValue());
+        gui_->getSlider("PARTICLES")->setValue(getMoving2DGraphConfig().number_of_particles);
+    }
+    
+}
+
+/**
+ * This function returns the configuration of the moving 2D graph visualizer (at the highest quality),
+ * with the number of particles chosen with the slider, if one has been.
+ */
+GraphConfig ofApp::getMoving2DGraphConfig() const {
+    
+    GraphConfig config = visualizer_config_.getMoving2DGraphConfig();
+    
+    if (chosen_number_of_particles_ > 0) {
+        config.number_of_particles = chosen_number_of_particles_;
+    }
+    
+    return config;
+    
+}
+
+/**
+ * This function measures the time the current frame took, and applies the quality level
+ * the quality governor sets, if it changes it.
+ */
+void ofApp::governQuality() {
+    
+    // The frame took the longer of the time the main thread took to update and draw it, and the time the worker
+    // took to compute the next one (as they run side by side). The time spent waiting for the vertical sync
+    // is not counted, so that the headroom under the budget is seen as well as going over it.
+    
+    float main_thread_time_ms = (ofGetElapsedTimeMicros() - frame_start_time_micros_) / 1000.0f;
+    float worker_time_ms = frame_pipeline_.hasFrontFrame() ? frame_pipeline_.getFrontFrame().compute_time_ms : 0;
+    
+    if (quality_governor_.addFrameTime(std::max(main_thread_time_ms, worker_time_ms))) {
+        applyQualityLevel();
+    }
+    
+}
+
+/**
+ * This function returns the frames of the sound which have not been handed to the visualizers
+ * to be analyzed yet, up to the given frame, so that every frame is analyzed (once).
+ */
+ofSoundBuffer ofApp::getNewSoundBuffer(AnalysisInput & analysis_input, long long end_frame, int analysis_window_size,
+                                       long long & new_start_frame) {
+    
+    new_start_frame = analyzed_end_frame_;
+    
+    // If the sound went back (e.g. the song looped, or was switched), or too much of it has gone by to be analyzed
+    // in one frame, start over from the last window's worth of frames. (The visualizers start over when the frames
+    // they are handed do not follow on from the ones before.)
+    
+    if (new_start_frame < 0 || new_start_frame > end_frame || end_frame - new_start_frame > kMaximumFramesToCatchUp) {
+        new_start_frame = end_frame - analysis_window_size;
+    }
+    
+    analyzed_end_frame_ = end_frame;
+    
+    ofSoundBuffer new_sound_buffer;
+    analysis_input.copyFrames(new_start_frame, (int) (end_frame - new_start_frame), new_sound_buffer);
+    
+    return new_sound_buffer;
+    
 }
 
 /**
@@ -151,11 +540,28 @@ void ofApp::update() {
  */
 void ofApp::draw() {
     
+    // Run headless, the frames are rasterized on the CPU, and written out, instead of drawn.
+    
+    if (!headless_output_path_.empty()) {
+        
+        if (current_state_ != MENU) {
+            
+            drawHeadlessFrame();
+            governQuality();
+        }
+        
+        return;
+    }
+    
     if (current_state_ == MENU) {
         
         svg_.draw();
         drawMenuAndOptions();
         
+        // The menu's frames are not governed (and the next visualization's take their own time).
+        
+        quality_governor_.clearFrameTimes();
+        
     } else if (current_state_ == MOVING_2D_GRAPH_VIZ) {
         
         // Set background to white colour.
@@ -166,7 +572,7 @@ void ofApp::draw() {
         // Draw the moving graph and equalizer bars
         // for the moving graph visualization.
     
-        moving_2d_graph_visualizer_.draw();
+        drawCurrentFrame();
         
         // Display a "Now Playing :" + the song's name, in Helvetica font.
 
@@ -175,7 +581,7 @@ void ofApp::draw() {
         ofSetColor(0, 0, 0);
         temporary_font_loader_.drawString("Press G to exit visualization.", 10, 20);
         temporary_font_loader_.drawString("Now Playing: " +
-                                          song_to_play.substr(song_to_play.find_last_of("\\/") + 1),
+                                          getNowPlayingName(),
                                           0.78125 * ofGetWidth(), 20);
         
         // Draw the GUI for the visualization.
@@ -192,7 +598,7 @@ void ofApp::draw() {
         // Draw the moving graph and equalizer bars
         // for the moving graph visualization.
 
-        moving_3d_graph_visualizer_.draw();
+        drawCurrentFrame();
         
         // Display a "Now Playing :" + the song's name, in Helvetica font.
 
@@ -201,7 +607,7 @@ void ofApp::draw() {
         ofSetColor(255, 255, 255);
         temporary_font_loader_.drawString("Press D to exit visualization.", 10, 20);
         temporary_font_loader_.drawString("Now Playing: " +
-                                          song_to_play.substr(song_to_play.find_last_of("\\/") + 1),
+                                          getNowPlayingName(),
                                           0.78125 * ofGetWidth(), 20);
 
     }
@@ -209,7 +615,8 @@ void ofApp::draw() {
     else if (current_state_ == FFT_VIZ) {
         
         // Draw the time waveform and frequency bars of the FFT visualization.
-        fft_visualizer_.draw();
+        
+        drawCurrentFrame();
         
         // Display a "Now Playing :" + the song's name, in Helvetica font.
 
@@ -218,7 +625,7 @@ void ofApp::draw() {
         ofSetColor(255, 255, 255);
         temporary_font_loader_.drawString("Press F to exit visualization.", 0.435 * ofGetWidth(), 20);
         temporary_font_loader_.drawString("Now Playing: " +
-                                          song_to_play.substr(song_to_play.find_last_of("\\/") + 1),
+                                          getNowPlayingName(),
                                           0.78125 * ofGetWidth(), 20);
         
     }
@@ -226,7 +633,8 @@ void ofApp::draw() {
     else if (current_state_ == TECHNICAL_VIZ) {
         
         // Draw the technical visualization.
-        tech_visualizer_.draw();
+        
+        drawCurrentFrame();
         
         // Display a "Now Playing :" + the song's name, in Helvetica font.
         
@@ -235,9 +643,39 @@ void ofApp::draw() {
         ofSetColor(255, 255, 255);
         temporary_font_loader_.drawString("Press T to exit visualization.", 0.435 * ofGetWidth(), 20);
         temporary_font_loader_.drawString("Now Playing: " +
-                                         song_to_play.substr(song_to_play.find_last_of("\\/") + 1),
+                                         getNowPlayingName(),
                                          0.78125 * ofGetWidth(), 20);
     }
+    
+    // Draw the profiler overlay over any visualization, if it is toggled on.
+    
+    if (is_profiler_overlay_visible_ && current_state_ != MENU) {
+        drawProfilerOverlay();
+    }
+    
+    // Measure the frame, and lower (or raise) the quality of the visualizations if it is over (or well under) budget.
+    
+    if (current_state_ != MENU) {
+        governQuality();
+    }
+}
+
+/**
+ * The following function releases the resources of the application
+ * when it is closed.
+ */
+void ofApp::exit() {
+    
+    // Stop the worker thread before the visualizers it uses are destroyed.
+    frame_pipeline_.stop();
+    software_frame_renderer_.stop();
+    
+    // Stop the loader and audio threads before the songs they use are released.
+    live_input_.close();
+    track_loader_.stop();
+    playlist_.stop();
+    audio_engine_.close();
+    
 }
 
 /**
@@ -257,22 +695,34 @@ void ofApp::keyPressed(int key) {
         if (current_state_ == MENU) {
             
             // GUI initialisation for 2D graph visualizer.
+            // (Run headless, there is no window to show it in.)
+            
+            if (headless_output_path_.empty()) {
+                
+                gui_ = new ofxDatGui(0.7 * ofGetWidth(), 40);
+                gui_->setAssetPath("");
+                gui_->addSlider("THRESHOLD DIST.", 10, 100, moving_2d_graph_visualizer_.getThresholdDistanceValue());
+                gui_->addSlider("PARTICLES", VisualizerConfig::getMinimumNumberOfParticles(),
+                                VisualizerConfig::getMaximumNumberOfParticles(),
+                                getMoving2DGraphConfig().number_of_particles)->setPrecision(0);
             
-            gui_ = new ofxDatGui(0.7 * ofGetWidth(), 40);
-            gui_->setAssetPath("");
-            gui_->addSlider("THRESHOLD DIST.", 10, 100, 40);
+                std::vector<string> display_options = {"LINES", "TRIANGLES"};
+                gui_->addDropdown("DISPLAY MODE", display_options);
             
-            std::vector<string> display_options = {"LINES", "TRIANGLES"};
-            gui_->addDropdown("DISPLAY MODE", display_options);
+                std::vector<string> band_scale_options = {BandAggregator::getScaleName(BAND_SCALE_THIRD_OCTAVE),
+                                                          BandAggregator::getScaleName(BAND_SCALE_OCTAVE),
+                                                          BandAggregator::getScaleName(BAND_SCALE_BARK)};
+                gui_->addDropdown("BAND SCALE", band_scale_options);
             
-            gui_->addFooter();
-            gui_->getFooter()->setLabelWhenExpanded("CLOSE PANEL");
-            gui_->getFooter()->setLabelWhenCollapsed("EXPAND PANEL");
+                gui_->addFooter();
+                gui_->getFooter()->setLabelWhenExpanded("CLOSE PANEL");
+                gui_->getFooter()->setLabelWhenCollapsed("EXPAND PANEL");
             
-            gui_->onSliderEvent(this, &ofApp::onSliderEvent);
-            gui_->onDropdownEvent(this, &ofApp::onDropdownEvent);
+                gui_->onSliderEvent(this, &ofApp::onSliderEvent);
+                gui_->onDropdownEvent(this, &ofApp::onDropdownEvent);
             
-            gui_->setTheme(new ofxDatGuiThemeMidnight());
+                gui_->setTheme(new ofxDatGuiThemeMidnight());
+            }
             
             
             // Move to the Moving Graph Visualization screen.
@@ -281,11 +731,8 @@ void ofApp::keyPressed(int key) {
             ofSetWindowTitle("Moving Graph Visualization");
             current_state_ = MOVING_2D_GRAPH_VIZ;
             
-            sound_player_.load(song_to_play);
-            
-            // Start playing the song.
-            sound_player_.play();
-            sound_player_.setPositionMS(60000); // For demo purposes - plays song from the 1 minute mark
+            // Start playing the (already decoded) song.
+            startSong();
             
         }
         
@@ -293,6 +740,7 @@ void ofApp::keyPressed(int key) {
             
            // Remove the gui.
            delete gui_;
+           gui_ = nullptr;
             
             // If G is pressed in the Moving Graph visualization screen,
             // return to the Menu screen, after stopping the music.
@@ -300,8 +748,11 @@ void ofApp::keyPressed(int key) {
             ofSetWindowTitle("Menu");
             current_state_ = MENU;
             
+            // Discard the frames computed for the visualization.
+            frame_pipeline_.clear();
+            
             // Stop playing the song.
-            sound_player_.stop();
+            audio_engine_.stop();
             
             // Resources allocated for the object will be automatically deallocated.
             
@@ -312,6 +763,9 @@ void ofApp::keyPressed(int key) {
     else if (uppercase_key == 'C') {
         
         // Change Moving 2D Graph display mode.
+        // (The visualizer may only be modified while the frame pipeline is idle.)
+        
+        frame_pipeline_.waitUntilIdle();
         moving_2d_graph_visualizer_.mode = (moving_2d_graph_visualizer_.mode == 1) ? 2 : 1;
         
     }
@@ -329,11 +783,8 @@ void ofApp::keyPressed(int key) {
             ofSetWindowTitle("Moving 3D Graph Visualization");
             current_state_ = MOVING_3D_GRAPH_VIZ;
 
-            sound_player_.load(song_to_play);
-            
-            // Start playing the song.
-            sound_player_.play();
-            sound_player_.setPositionMS(60000); // For demo purposes - plays song from the 1 minute mark
+            // Start playing the (already decoded) song.
+            startSong();
 
         }
         
@@ -344,9 +795,12 @@ void ofApp::keyPressed(int key) {
 
             ofSetWindowTitle("Menu");
             current_state_ = MENU;
+            
+            // Discard the frames computed for the visualization.
+            frame_pipeline_.clear();
 
             // Stop playing the song.
-            sound_player_.stop();
+            audio_engine_.stop();
         }
     }
     // If the key is F
@@ -361,11 +815,8 @@ void ofApp::keyPressed(int key) {
             ofSetWindowTitle("FFT, Time and Frequency Waveform Visualization");
             current_state_ = FFT_VIZ;
             
-            extended_sound_player_.load(song_to_play);
-            
-            // Start playing the song.
-            extended_sound_player_.play();
-            extended_sound_player_.setPositionMS(60000); // For demo purposes - plays song from the 1 minute mark
+            // Start playing the (already decoded) song.
+            startSong();
             
             
         }
@@ -378,11 +829,14 @@ void ofApp::keyPressed(int key) {
             ofSetWindowTitle("Menu");
             current_state_ = MENU;
             
+            // Discard the frames computed for the visualization.
+            frame_pipeline_.clear();
+            
             // Restore line width to 1.
             ofSetLineWidth(1);
             
             // Stop playing the song.
-            extended_sound_player_.stop();
+            audio_engine_.stop();
             
         }
         
@@ -399,11 +853,8 @@ void ofApp::keyPressed(int key) {
             ofSetWindowTitle("Technical Visualization");
             current_state_ = TECHNICAL_VIZ;
             
-            extended_sound_player_.load(song_to_play);
-            
-            // Start playing the song.
-            extended_sound_player_.play();
-            extended_sound_player_.setPositionMS(60000); // For demo purposes - plays song from the 1 minute mark
+            // Start playing the (already decoded) song.
+            startSong();
             
             
         }
@@ -416,11 +867,14 @@ void ofApp::keyPressed(int key) {
             ofSetWindowTitle("Menu");
             current_state_ = MENU;
             
+            // Discard the frames computed for the visualization.
+            frame_pipeline_.clear();
+            
             // Restore line width to 1.
             // ofSetLineWidth(1);
             
             // Stop playing the song.
-            extended_sound_player_.stop();
+            audio_engine_.stop();
             
         }
         
@@ -429,29 +883,109 @@ void ofApp::keyPressed(int key) {
     
     else if (uppercase_key == 'S') {
         
-        // Allow song switching only if the user is in the Menu.
-        //
-        // For understandable reasons, switching a song during the visualization
-        // can cause unexpected crashes.
+        // Move on to the next song of the playlist.
+        // This works in the menu as well as during a visualization, which carries on with the new song.
         
-        if (current_state_ == MENU) {
+        playNextSong();
+
+    }
+    
+    // if the key is L
+    
+    else if (uppercase_key == 'L') {
+        
+        // Switch the visualizations between the song and the live input (e.g. a mixer feed).
+        
+        if (!is_live_input_mode_) {
             
-            // Unload the sound player.
-            //
-            // We don't need to do this for the extended sound player as load() first unloads, then loads.
+            if (startLiveInput()) {
+                
+                is_live_input_mode_ = true;
+                audio_engine_.stop();
+                
+            }
             
-            sound_player_.unload();
+        } else {
             
-            // Set the song to be played.
-            song_to_play = (song_to_play == "indian_summer.mp3") ? "alone.mp3" : "indian_summer.mp3";
+            live_input_.close();
+            is_live_input_mode_ = false;
             
-            // Load the songs into the players.
+            if (current_state_ != MENU) {
+                startSong();
+            }
+        }
+        
+    }
+    
+    // if the key is W
+    
+    else if (uppercase_key == 'W') {
+        
+        // Switch the FFT visualization's time waveform between the current window
+        // and the last few seconds of the song.
+        
+        frame_pipeline_.waitUntilIdle();
+        fft_visualizer_.toggleWaveformView();
+        
+    }
+    
+    // if the key is N
+    
+    else if (uppercase_key == 'N') {
+        
+        // Move the FFT visualization's time waveform on to the next window size
+        // (the larger ones show more of the sound, for high-resolution displays).
+        
+        int next_window_size = kWaveformWindowSizes[0];
+        
+        for (int i = 0; i < kNumberOfWaveformWindowSizes; i++) {
             
-            sound_player_.load(song_to_play);
-            extended_sound_player_.load(song_to_play);
+            if (kWaveformWindowSizes[i] > fft_visualizer_.getWindowSize()) {
+                next_window_size = kWaveformWindowSizes[i];
+                break;
+            }
             
         }
-
+        
+        frame_pipeline_.waitUntilIdle();
+        fft_visualizer_.setWaveformWindowSize(next_window_size);
+        
+    }
+    
+    // if the key is H
+    
+    else if (uppercase_key == 'H') {
+        
+        // Move the FFT and Technical visualizations on to the next channel mode
+        // (left, right, mid, side, or both the left and right channel).
+        
+        ChannelMode channel_mode = ChannelMixer::getNextMode(fft_visualizer_.getChannelMode());
+        
+        frame_pipeline_.waitUntilIdle();
+        fft_visualizer_.setChannelMode(channel_mode);
+        tech_visualizer_.setChannelMode(channel_mode);
+        
+    }
+    
+    // if the key is Q
+    
+    else if (uppercase_key == 'Q') {
+        
+        // Turn the quality governor on or off (which brings back the configured quality).
+        
+        if (quality_governor_.setEnabled(!quality_governor_.isEnabled())) {
+            applyQualityLevel();
+        }
+        
+    }
+    
+    // if the key is P
+    
+    else if (uppercase_key == 'P') {
+        
+        // Toggle the profiler overlay.
+        is_profiler_overlay_visible_ = !is_profiler_overlay_visible_;
+        
     }
     
     // if the key is M
@@ -466,8 +1000,11 @@ void ofApp::keyPressed(int key) {
         if (musicFileResult.bSuccess){
             
             ofLogVerbose("User selected a file");
-            song_to_play = musicFileResult.getPath();
             
+            // Decode the song in the background right away, so that it is ready when a visualization is opened.
+            // (Every song is decoded only once, however many visualizations it is played in.)
+            
+            track_loader_.load(musicFileResult.getPath());
             
         } else {
             ofLogVerbose("User hit cancel");
@@ -476,6 +1013,163 @@ void ofApp::keyPressed(int key) {
 
 }
 
+/**
+ * This function starts feeding the visualizations with the live input, from the default input device
+ * or the file standing in for it.
+ */
+bool ofApp::startLiveInput() {
+    
+    std::unique_ptr<AudioInputBackend> backend;
+    
+    if (live_input_file_path_.empty()) {
+        backend.reset(new SoundStreamInputBackend());
+    } else {
+        backend.reset(new FileInputBackend(live_input_file_path_, live_input_file_speed_));
+    }
+    
+    return live_input_.setup(std::move(backend), kLiveInputSampleRate, live_input_buffer_size_,
+                             kLiveInputNumberOfChannels);
+    
+}
+
+/**
+ * This function starts playing the song, unless the visualizations are fed by the live input.
+ */
+void ofApp::startSong() {
+    
+    if (is_live_input_mode_) {
+        return;
+    }
+    
+    audio_engine_.play();
+    audio_engine_.setPositionMS(60000); // For demo purposes - plays song from the 1 minute mark
+    
+}
+
+/**
+ * This function returns the name of what is being visualized: the song's file name, or the live input.
+ */
+std::string ofApp::getNowPlayingName() {
+    
+    if (is_live_input_mode_) {
+        return "Live Input (" + live_input_.getBackendName() + ")";
+    }
+    
+    return song_to_play.substr(song_to_play.find_last_of("\\/") + 1);
+    
+}
+
+/**
+ * This function hands the song the track loader has finished loading (if any)
+ * to the audio engine, in place of the current song.
+ */
+void ofApp::swapInLoadedSong() {
+    
+    std::shared_ptr<AudioSource> loaded_track = track_loader_.takeLoadedTrack();
+    
+    if (loaded_track) {
+        switchToSong(loaded_track);
+    }
+    
+}
+
+/**
+ * This function hands the given song to the audio engine, in place of the current song.
+ */
+void ofApp::switchToSong(std::shared_ptr<AudioSource> track) {
+    
+    // The audio engine swaps the song in one step, under its lock, so this is safe while a visualization
+    // is running: the audio thread and the frame pipeline only ever see either the old or the new song.
+    // The old song is released on the track loader's thread, so that freeing it never stalls a frame.
+    
+    std::shared_ptr<AudioSource> old_track = current_track_;
+    
+    song_to_play = track->getPath();
+    current_track_ = track;
+    
+    audio_engine_.setTrack(current_track_);
+    track_loader_.release(std::move(old_track));
+    
+}
+
+/**
+ * This function moves the playlist on once the audio engine has moved on to the next song,
+ * and queues the song after it (once it has been prefetched) to be played without a gap.
+ */
+void ofApp::followPlaylist() {
+    
+    if (playlist_.size() < 2 || !current_track_) {
+        return;
+    }
+    
+    // The audio engine moves on to the queued song by itself, at the end of the current one.
+    
+    std::shared_ptr<AudioSource> playing_track = audio_engine_.getTrack();
+    
+    if (playing_track != current_track_) {
+        
+        track_loader_.release(std::move(current_track_));
+        
+        song_to_play = playing_track->getPath();
+        current_track_ = playing_track;
+        
+        playlist_.setCurrentIndex(playlist_.getNextIndex(), track_loader_);
+    }
+    
+    // (While the track loader is decoding the song to be switched to, nothing is queued after the old one.)
+    
+    if (audio_engine_.getNextTrack() || track_loader_.isLoading()) {
+        return;
+    }
+    
+    // Queue the next song, once it has been prefetched.
+    
+    int next_index = playlist_.getNextIndex();
+    std::shared_ptr<AudioSource> next_track = playlist_.getPrefetchedTrack(next_index);
+    
+    if (!next_track || audio_engine_.setNextTrack(next_track)) {
+        return;
+    }
+    
+    // A song at another sample rate cannot be queued (the sound stream has to be reopened for it),
+    // so switch to it, with a short gap, as the current song ends.
+    
+    long long frames_left = current_track_->getNumberOfFrames() - audio_engine_.getPositionFrames();
+    
+    if (frames_left < current_track_->getSampleRate() / 10) {
+        
+        switchToSong(next_track);
+        playlist_.setCurrentIndex(next_index, track_loader_);
+    }
+    
+}
+
+/**
+ * This function switches to the next song of the playlist (right away if it has been prefetched,
+ * otherwise once the track loader has decoded it).
+ */
+void ofApp::playNextSong() {
+    
+    if (playlist_.size() == 0) {
+        return;
+    }
+    
+    int next_index = playlist_.getNextIndex();
+    
+    // The prefetched song is released by the playlist once it is the current one, so it is taken first.
+    
+    std::shared_ptr<AudioSource> next_track = playlist_.getPrefetchedTrack(next_index);
+    
+    playlist_.setCurrentIndex(next_index, track_loader_);
+    
+    if (next_track) {
+        switchToSong(next_track);
+    } else {
+        track_loader_.load(playlist_.getPath(next_index));
+    }
+    
+}
+
 /**
  * This function is responsible for drawing the menu screen and displaying options
  * for different visualizations.
@@ -495,12 +1189,113 @@ void ofApp::drawMenuAndOptions() {
     temporary_font_loader_.drawString("MUSIC VISUALIZER", ofGetWidth() / 4, ofGetHeight() / 2);
 
     string menu_message = "Press G, D, F or T for visualizations. \n\n";
-    menu_message       += "      Press S to switch songs.\n\n";
-    menu_message       += "      Press M to import a song.";
+    menu_message       += "      Press S for the next song.\n\n";
+    menu_message       += "      Press M to import a song.\n\n";
+    menu_message       += "      Press L for live input.";
     
     // Display the string.
     text_font_loader_.drawString(menu_message, ofGetWidth() / 3.15, 100 + ofGetHeight() / 2);
     
+    // Display the progress of the song being loaded, if any.
+    
+    if (track_loader_.isLoading()) {
+        
+        std::string requested_song = track_loader_.getRequestedPath();
+        
+        string loading_message = "Loading " + requested_song.substr(requested_song.find_last_of("\\/") + 1) + ": ";
+        loading_message       += ofToString((int) (100 * track_loader_.getProgress())) + "%";
+        
+        text_font_loader_.drawString(loading_message, ofGetWidth() / 3.15, 250 + ofGetHeight() / 2);
+    }
+    
+}
+
+/**
+ * This function is responsible for drawing the most recent frame computed
+ * by the frame pipeline for the visualization being run.
+ */
+void ofApp::drawCurrentFrame() {
+    
+    // Right after a visualization is opened, no frame has been computed yet.
+    
+    if (frame_pipeline_.hasFrontFrame()) {
+        frame_renderer_.draw(frame_pipeline_.getFrontFrame());
+    }
+    
+}
+
+/**
+ * This function is responsible for rasterizing the most recent frame computed by the frame pipeline
+ * on the CPU, and writing it out (when the application is run headless).
+ */
+void ofApp::drawHeadlessFrame() {
+    
+    if (!frame_pipeline_.hasFrontFrame()) {
+        return;
+    }
+    
+    // The moving graphs are drawn over the background the window is cleared to for them (white in 2D, black in 3D).
+    
+    FrameColor background_color = (current_state_ == MOVING_2D_GRAPH_VIZ) ? FrameColor{255, 255, 255, 255}
+                                                                          : FrameColor{0, 0, 0, 255};
+    
+    software_frame_renderer_.draw(frame_pipeline_.getFrontFrame(), background_color);
+    
+    // The frames are written one after the other, as raw 8-bit RGB (e.g. for ffmpeg -f rawvideo -pix_fmt rgb24).
+    
+    headless_output_.write((const char *) software_frame_renderer_.getPixels(),
+                           (std::streamsize) software_frame_renderer_.getWidth() * software_frame_renderer_.getHeight() * 3);
+    
+}
+
+/**
+ * This function is responsible for drawing the profiler overlay, which displays
+ * performance figures of the visualization being run.
+ */
+void ofApp::drawProfilerOverlay() {
+    
+    // The number of allocations made while filling in the frame being drawn.
+    // Once the frame buffers have grown to the size the visualization needs, this reads zero.
+    
+    int frame_allocation_count = frame_pipeline_.hasFrontFrame() ? frame_pipeline_.getFrontFrame().getAllocationCount() : 0;
+    
+    string profiler_message = "FPS: " + ofToString(ofGetFrameRate(), 1) + "\n";
+    profiler_message       += "Frame allocations: " + ofToString(frame_allocation_count) + "\n";
+    
+    // The quality level the governor has set, and the frame times it judges it by.
+    
+    if (quality_governor_.isEnabled()) {
+        
+        profiler_message += "Quality level: " + ofToString(quality_governor_.getLevelIndex()) + " of "
+                            + ofToString(QualityGovernor::getNumberOfLevels() - 1) + " (p95 frame time: "
+                            + ofToString(quality_governor_.getFrameTimePercentile(), 1) + " ms, target: "
+                            + ofToString(quality_governor_.getTargetFrameTime(), 1) + " ms)";
+    } else {
+        profiler_message += "Quality level: off (Q)";
+    }
+    
+    // For the live input, the latency from the input to the screen: the time since the newest block of input
+    // the frame was computed from was captured, plus the length of that block (its first frame waited that long
+    // to be captured). The display's own scan-out is not included.
+    
+    uint64_t input_capture_time_micros = frame_pipeline_.hasFrontFrame()
+                                         ? frame_pipeline_.getFrontFrame().input_capture_time_micros : 0;
+    
+    if (is_live_input_mode_ && input_capture_time_micros != 0) {
+        
+        float buffer_length_ms = 1000.0f * live_input_.getBufferSize() / live_input_.getSampleRate();
+        float input_latency_ms = (ofGetElapsedTimeMicros() - input_capture_time_micros) / 1000.0f + buffer_length_ms;
+        
+        profiler_message += "\nInput latency: " + ofToString(input_latency_ms, 1) + " ms";
+        profiler_message += " (buffer: " + ofToString(live_input_.getBufferSize()) + " frames, dropped: ";
+        profiler_message += ofToString(live_input_.getDroppedFrames()) + " frames)";
+    }
+    
+    temporary_font_loader_.load("helvetica.ttf", 10);
+    
+    ofSetColor(255, 0, 0);
+    temporary_font_loader_.drawString(profiler_message, 10, ofGetHeight() - 70);
+    
 }
 
 /**
@@ -509,9 +1304,27 @@ void ofApp::drawMenuAndOptions() {
  */
 void ofApp::onSliderEvent(ofxDatGuiSliderEvent event) {
     
-    // Update the threshold distance.
+    frame_pipeline_.waitUntilIdle();
+    
+    // Update the number of particles (in place: the existing particles keep moving as they were),
+    // if the particles slider was moved.
+    
+    // The number chosen is kept (over the configured one) when the quality level changes, and scaled down
+    // as the configured one would be.
+    
+    if (event.target->getLabel() == "PARTICLES") {
+        
+        chosen_number_of_particles_ = (int) event.target->getValue();
+        
+        moving_2d_graph_visualizer_.setNumberOfParticles(
+            quality_governor_.getGovernedConfig(getMoving2DGraphConfig()).number_of_particles);
+        return;
+    }
+    
+    // Otherwise, update the threshold distance.
     
     float new_threshold_distance = (float) event.target->getValue();
+    
     moving_2d_graph_visualizer_.updateThresholdDistanceValue(new_threshold_distance);
     
 }
@@ -522,9 +1335,25 @@ void ofApp::onSliderEvent(ofxDatGuiSliderEvent event) {
  */
 void ofApp::onDropdownEvent(ofxDatGuiDropdownEvent event) {
     
-    // Update the display mode.
+    std::string label = event.target->getLabel();
+    
+    frame_pipeline_.waitUntilIdle();
+    
+    // Update the band scale, if a scale was picked.
+    
+    for (BandScale scale : {BAND_SCALE_OCTAVE, BAND_SCALE_THIRD_OCTAVE, BAND_SCALE_BARK}) {
+        
+        if (label == BandAggregator::getScaleName(scale)) {
+            
+            moving_2d_graph_visualizer_.updateBandScale(scale);
+            return;
+        }
+    }
+    
+    // Otherwise, update the display mode.
+    
+    int new_display_mode = (label == "LINES") ? 1 : 2;
     
-    int new_display_mode = (event.target->getLabel() == "LINES") ? 1 : 2;
     moving_2d_graph_visualizer_.updateDisplayMode(new_display_mode);
     
 }
@@ -1,14 +1,28 @@
 #pragma once
 
 #include "ofMain.h"
-#include "ofxFFTLive.h"
 #include "Moving2DGraphVisualizer.h"
 #include "Moving3DGraphVisualizer.h"
-#include "ofSoundPlayerExtended.h"
 #include "ofxDatGui.h"
 #include "FFTVisualizer.h"
 #include "ofxSvg.h"
 #include "TechnicalVisualizer.h"
+#include "VisualizerFrame.h"
+#include "FrameRenderer.h"
+#include "FramePipeline.h"
+#include "TrackLoader.h"
+#include "Playlist.h"
+#include "LiveInput.h"
+#include "SoundStreamInputBackend.h"
+#include "FileInputBackend.h"
+#include "AudioEngine.h"
+#include "BeatTracker.h"
+#include "VisualizerConfig.h"
+#include "FileWatcher.h"
+#include "QualityGovernor.h"
+#include "SoftwareFrameRenderer.h"
+#include <fstream>
+#include <memory>
 
 /**
  * The ofApp class that contains all the functions which are executed when main() is run.
@@ -25,9 +39,15 @@ class ofApp : public ofBaseApp {
     
     ApplicationState current_state_; // this variable tracks the current state of the application
     
-    ofSoundPlayer sound_player_; // the sound player for the music to be visualized
+    std::shared_ptr<AudioSource> current_track_; // the (decoded) song to be visualized and played,
+                                                 // which both playback and the visualizers read from
     
-    ofSoundPlayerExtended extended_sound_player_;
+    TrackLoader track_loader_; // the loader which decodes the songs in the background
+    
+    Playlist playlist_; // the playlist of songs, the next of which are decoded ahead of time
+    
+    AudioEngine audio_engine_; // the engine which plays the song, and provides its samples and spectrum
+                               // to the visualizers
     
     ofTrueTypeFont text_font_loader_; // the TTF file loader for
                                       // the font the text is to be displayed in
@@ -36,19 +56,110 @@ class ofApp : public ofBaseApp {
     
     Moving3DGraphVisualizer moving_3d_graph_visualizer_; // an object which runs the moving 3D graph visualizer
     
-    ofxFFTLive fft_live_; // the ofxFFT addon object used to visualize frequency waveforms after applying FFT
-                          // on real time data
-    
     FFTVisualizer fft_visualizer_; // an object which runs the FFT visualization
     
     TechnicalVisualizer tech_visualizer_; // an object that runs the technical visualization
     
+    BeatTracker beat_tracker_; // the tracker of the beats (and tempo) the moving graph visualizers pulse with
+    
+    FramePipeline frame_pipeline_; // the pipeline which computes the next frame of the visualization being run
+                                   // on a worker thread, while the current one is drawn
+    
+    FrameRenderer frame_renderer_; // the renderer which draws the visualizer frames to the window
+    
+    SoftwareFrameRenderer software_frame_renderer_; // the renderer which rasterizes the visualizer frames on the CPU,
+                                                    // when the application is run headless
+    
+    std::string headless_output_path_; // the file the frames are written to when the application is run headless
+                                       // (empty when it is run in a window)
+    
+    std::ofstream headless_output_; // the stream the frames are written to when the application is run headless
+    
     ofxDatGui * gui_; // the GUI for the program
     
     ofxSVG svg_; // the loader and displayer for an SVG file
     
+    LiveInput live_input_; // the live input (e.g. a mixer feed), which can be visualized instead of the song
+    
+    bool is_live_input_mode_; // whether the visualizations are fed by the live input
+    
+    std::string live_input_file_path_; // the file which stands in for the sound input device
+                                       // (empty to capture from the default input device)
+    
+    float live_input_file_speed_; // how many times faster than real time the file is fed in
+    
+    int live_input_buffer_size_; // the number of frames the live input is captured in at a time
+    
+    int startup_key_; // the key pressed once the application is set up (0 for none), to open a visualization
+    
+    bool is_profiler_overlay_visible_; // whether the profiler overlay is drawn over the visualizations
+    
+    long long analyzed_end_frame_; // the frame (of the song, or the live input) up to which the sound has been
+                                   // handed to the visualizers to be analyzed
+    
+    VisualizerConfig visualizer_config_; // the configuration of the visualizers (read from config.json)
+    
+    FileWatcher config_watcher_; // the watcher of config.json, which is applied again whenever it changes
+    
+    FileWatcher mappings_watcher_; // the watcher of mappings.json, which is loaded again whenever it changes
+    
+    int chosen_number_of_particles_; // the number of particles of the moving 2D graph chosen with the slider,
+                                     // which stands in for the configured one (0 till one is chosen)
+    
+    QualityGovernor quality_governor_; // the governor which lowers (or raises) the quality of the visualizations
+                                       // to hold the frame time budget
+    
+    uint64_t frame_start_time_micros_; // the time (as ofGetElapsedTimeMicros()) the current frame was started at
+    
 	public:
     
+        /**
+         * Constructor for the application, which captures the live input from the default input device.
+         */
+        ofApp() noexcept;
+    
+        /**
+         * Makes a file stand in for the sound input device, and starts the application in live input mode
+         * (so that the live input can be run, and load tested, on machines without a sound card).
+         * This is to be called before the application is run.
+         *
+         * @param path - the path of the file (a .wav or .mp3)
+         * @param speed - how many times faster than real time the file is fed in (1 for real time)
+         */
+        void setLiveInputFile(const std::string & path, float speed);
+    
+        /**
+         * Sets the number of frames the live input is captured in at a time (256 by default).
+         * Smaller buffers give a lower latency, larger ones ride out a busier machine.
+         * This is to be called before the application is run.
+         *
+         * @param buffer_size - the number of frames, a power of 2 which LiveInput::isValidBufferSize()
+         */
+        void setLiveInputBufferSize(int buffer_size);
+    
+        /**
+         * Sets the key to be pressed once the application is set up (e.g. 'F' to open the FFT visualization).
+         * This is to be called before the application is run.
+         */
+        void setStartupKey(int key);
+    
+        /**
+         * Runs the application headless (without a window, or a GPU): the frames are rasterized on the CPU,
+         * and written to the given file as raw 8-bit RGB, one after the other. This is to be called before
+         * the application is run.
+         *
+         * @param path - the path of the file (absolute, or relative to the data directory)
+         */
+        void setHeadlessOutput(const std::string & path);
+    
+        /**
+         * Sets the 95th percentile frame time the quality governor holds (16.6 ms by default).
+         * This is to be called before the application is run.
+         *
+         * @param target_frame_time_ms - the frame time (in milliseconds)
+         */
+        void setTargetFrameTime(float target_frame_time_ms);
+    
         /**
          * The following function sets up the resources for the application.
          */
@@ -64,6 +175,12 @@ class ofApp : public ofBaseApp {
          * application window.
          */
 		void draw();
+    
+        /**
+         * The following function releases the resources of the application
+         * when it is closed.
+         */
+        void exit();
 
         /**
          * The following function triggers an action based on the key
@@ -71,12 +188,105 @@ class ofApp : public ofBaseApp {
          */
 		void keyPressed(int key);
     
+        /**
+         * This function starts feeding the visualizations with the live input, from the default input device
+         * or the file standing in for it.
+         */
+        bool startLiveInput();
+    
+        /**
+         * This function starts playing the song, unless the visualizations are fed by the live input.
+         */
+        void startSong();
+    
+        /**
+         * This function returns the name of what is being visualized: the song's file name, or the live input.
+         */
+        std::string getNowPlayingName();
+    
+        /**
+         * This function hands the given song to the audio engine, in place of the current song.
+         */
+        void switchToSong(std::shared_ptr<AudioSource> track);
+    
+        /**
+         * This function hands the song the track loader has finished loading (if any)
+         * to the audio engine, in place of the current song.
+         */
+        void swapInLoadedSong();
+    
+        /**
+         * This function moves the playlist on once the audio engine has moved on to the next song,
+         * and queues the song after it (once it has been prefetched) to be played without a gap.
+         */
+        void followPlaylist();
+    
+        /**
+         * This function switches to the next song of the playlist (right away if it has been prefetched,
+         * otherwise once the track loader has decoded it).
+         */
+        void playNextSong();
+    
+        /**
+         * This function applies config.json and mappings.json (in the data directory) to the visualizers,
+         * if they have been created or modified since they were last applied.
+         */
+        void applyChangedConfig();
+    
+        /**
+         * This function applies the configuration of the visualizers, at the quality level
+         * the quality governor has set.
+         */
+        void applyQualityLevel();
+    
+        /**
+         * This function returns the configuration of the moving 2D graph visualizer (at the highest quality),
+         * with the number of particles chosen with the slider, if one has been.
+         */
+        GraphConfig getMoving2DGraphConfig() const;
+    
+        /**
+         * This function measures the time the current frame took, and applies the quality level
+         * the quality governor sets, if it changes it.
+         */
+        void governQuality();
+    
+        /**
+         * This function returns the frames of the sound which have not been handed to the visualizers
+         * to be analyzed yet, up to the given frame, so that every frame is analyzed (once).
+         *
+         * @param analysis_input - the sound being analyzed
+         * @param end_frame - the frame up to which the sound is to be analyzed
+         * @param analysis_window_size - the number of frames analyzed at a time (the fewest frames to start from)
+         * @param new_start_frame - set to the frame the frames returned start at
+         */
+        ofSoundBuffer getNewSoundBuffer(AnalysisInput & analysis_input, long long end_frame, int analysis_window_size,
+                                        long long & new_start_frame);
+    
         /**
          * This function is responsible for drawing the menu screen and displaying options
          * for different visualizations.
          */
         void drawMenuAndOptions();
     
+        /**
+         * This function is responsible for drawing the most recent frame computed
+         * by the frame pipeline for the visualization being run.
+         */
+        void drawCurrentFrame();
+    
+        /**
+         * This function is responsible for rasterizing the most recent frame computed by the frame pipeline
+         * on the CPU, and writing it out (when the application is run headless).
+         */
+        void drawHeadlessFrame();
+    
+        /**
+         * This function is responsible for drawing the profiler overlay, which displays
+         * performance figures of the visualization being run.
+         */
+        void drawProfilerOverlay();
+    
         /**
          * This function is responsible for executing an action based
          * on moving the slider.
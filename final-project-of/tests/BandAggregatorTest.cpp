@@ -0,0 +1,132 @@
+//
+//  BandAggregatorTest.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "BandAggregator.h"
+#include "TestSupport.h"
+#include <vector>
+
+const BandScale kScales[] = {BAND_SCALE_OCTAVE, BAND_SCALE_THIRD_OCTAVE, BAND_SCALE_BARK}; // the scales tested
+
+const int kNumbersOfBins[] = {64, 513, 1024, 1025, 4097}; // the numbers of bins tested (odd ones leave a scalar tail)
+
+const int kSampleRates[] = {44100, 48000}; // the sample rates tested
+
+/**
+ * Checks that every band of a flat spectrum reads its level (the weights of each band add up to 1,
+ * to within the rounding of adding up a few hundred of them in single precision).
+ */
+static void testFlatSpectrumReadsItsLevel(BandScale scale, int number_of_bins, int sample_rate) {
+
+    BandAggregator aggregator;
+    aggregator.setup(scale, number_of_bins, sample_rate);
+
+    CHECK(aggregator.getNumberOfBands() > 0);
+
+    std::vector<float> bin_values(number_of_bins + 1, 0.5f);
+    std::vector<float> band_values;
+
+    aggregator.aggregate(bin_values.data(), band_values);
+
+    CHECK((int) band_values.size() == aggregator.getNumberOfBands());
+
+    for (int band = 0; band < (int) band_values.size(); band++) {
+        CHECK_NEAR(band_values[band], 0.5, 1e-4);
+    }
+
+}
+
+/**
+ * Checks the (vectorized) aggregation against a scalar dot product, in double precision, of the weights
+ * of each band with a random spectrum. The weights are read back from the aggregator one bin at a time
+ * (a spectrum with a single bin of 1 reads that bin's weight in each band), so the check covers the SIMD
+ * kernel, its tail, and how the runs of bins line up with the weights.
+ */
+static void testAggregationMatchesTheScalarDotProduct(BandScale scale, int number_of_bins, int sample_rate) {
+
+    BandAggregator aggregator;
+    aggregator.setup(scale, number_of_bins, sample_rate);
+
+    int number_of_bands = aggregator.getNumberOfBands();
+
+    // Read the weights back.
+
+    std::vector<std::vector<double> > weights(number_of_bands, std::vector<double>(number_of_bins + 1, 0));
+    std::vector<float> bin_values(number_of_bins + 1, 0);
+    std::vector<float> band_values;
+
+    for (int bin = 0; bin <= number_of_bins; bin++) {
+
+        bin_values[bin] = 1;
+        aggregator.aggregate(bin_values.data(), band_values);
+        bin_values[bin] = 0;
+
+        for (int band = 0; band < number_of_bands; band++) {
+            weights[band][bin] = band_values[band];
+        }
+    }
+
+    // Aggregate a random spectrum, and compare it with the scalar dot products.
+
+    unsigned seed = number_of_bins + scale;
+
+    for (int bin = 0; bin <= number_of_bins; bin++) {
+        bin_values[bin] = 1 + getRandomSample(seed);
+    }
+
+    aggregator.aggregate(bin_values.data(), band_values);
+
+    for (int band = 0; band < number_of_bands; band++) {
+
+        double expected_value = 0;
+
+        for (int bin = 0; bin <= number_of_bins; bin++) {
+            expected_value += weights[band][bin] * bin_values[bin];
+        }
+
+        CHECK_NEAR(band_values[band], expected_value, 1e-5 * (1 + expected_value));
+    }
+
+}
+
+/**
+ * Checks that frequencies are told to be in the bands which cover them.
+ */
+static void testBandIndexCoversTheFrequency() {
+
+    BandAggregator aggregator;
+    aggregator.setup(BAND_SCALE_OCTAVE, 1024, 44100);
+
+    int band = aggregator.getBandIndex(1000);
+
+    CHECK(band >= 0 && band < aggregator.getNumberOfBands());
+    CHECK(aggregator.getBandIndex(2000) == band + 1);
+    CHECK(aggregator.getBandIndex(500) == band - 1);
+    CHECK(aggregator.getBandIndex(0) == 0);
+    CHECK(aggregator.getBandIndex(1e6) == aggregator.getNumberOfBands() - 1);
+
+}
+
+/**
+ * Runs the tests of the band aggregator.
+ */
+int main() {
+
+    for (BandScale scale : kScales) {
+        for (int number_of_bins : kNumbersOfBins) {
+            for (int sample_rate : kSampleRates) {
+
+                testFlatSpectrumReadsItsLevel(scale, number_of_bins, sample_rate);
+                testAggregationMatchesTheScalarDotProduct(scale, number_of_bins, sample_rate);
+            }
+        }
+    }
+
+    testBandIndexCoversTheFrequency();
+
+    return finishTests("BandAggregatorTest");
+
+}
@@ -0,0 +1,107 @@
+//
+//  BeatTrackerTest.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "BeatTracker.h"
+#include "TestSupport.h"
+#include <vector>
+
+const int kSampleRate = 44100; // the sample rate of the test streams
+
+const int kNumberOfChannels = 2; // the number of channels of the test streams
+
+const int kPushFrames = 1024; // the number of frames pushed at a time (about a frame of the visualization)
+
+/**
+ * Makes a stream of noise, with a loud click (a burst of louder noise) every click_period frames
+ * (no clicks if it is 0).
+ */
+static std::vector<float> makeStream(int number_of_frames, int click_period, unsigned seed) {
+
+    std::vector<float> samples(number_of_frames * kNumberOfChannels);
+
+    for (int frame = 0; frame < number_of_frames; frame++) {
+
+        float sample = 0.01f * getRandomSample(seed);
+
+        if (click_period > 0 && frame % click_period < 400) {
+            sample += 0.8f * getRandomSample(seed);
+        }
+
+        for (int channel = 0; channel < kNumberOfChannels; channel++) {
+            samples[frame * kNumberOfChannels + channel] = sample;
+        }
+    }
+
+    return samples;
+
+}
+
+/**
+ * Pushes the frames [start_frame, end_frame) of a stream, a visualization frame's worth at a time.
+ */
+static void pushStream(BeatTracker & tracker, const std::vector<float> & samples, int start_frame, int end_frame) {
+
+    for (int frame = start_frame; frame + kPushFrames <= end_frame; frame += kPushFrames) {
+        tracker.push(&samples[frame * kNumberOfChannels], kPushFrames, kNumberOfChannels, kSampleRate, frame);
+    }
+
+}
+
+/**
+ * Checks that steady noise has no beats, however it is started: the start of a run
+ * (the stream starting, or being sought) is not an onset.
+ */
+static void testSteadyNoiseHasNoBeats() {
+
+    std::vector<float> samples = makeStream(4 * kSampleRate, 0, 7);
+
+    BeatTracker tracker;
+
+    pushStream(tracker, samples, 0, 2 * kSampleRate);
+
+    BeatState state = tracker.getState(2 * kSampleRate);
+
+    CHECK(state.beat_count == 0);
+    CHECK(state.onset_strength == 0);
+
+    // A seek starts a new run.
+
+    pushStream(tracker, samples, 3 * kSampleRate - 4 * kPushFrames, 4 * kSampleRate);
+
+    CHECK(tracker.getState(4 * kSampleRate).beat_count == 0);
+
+}
+
+/**
+ * Checks that the beats of a click track at 120 BPM are tracked, and its tempo found.
+ */
+static void testTracksAClickTrack() {
+
+    std::vector<float> samples = makeStream(8 * kSampleRate, kSampleRate / 2, 8);
+
+    BeatTracker tracker;
+
+    pushStream(tracker, samples, 0, 8 * kSampleRate);
+
+    BeatState state = tracker.getState(8 * kSampleRate);
+
+    CHECK_NEAR(state.bpm, 120, 2);
+    CHECK(state.beat_count >= 14 && state.beat_count <= 16);
+
+}
+
+/**
+ * Runs the tests of the beat tracker.
+ */
+int main() {
+
+    testSteadyNoiseHasNoBeats();
+    testTracksAClickTrack();
+
+    return finishTests("BeatTrackerTest");
+
+}
@@ -0,0 +1,117 @@
+//
+//  ChannelMixerTest.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "ChannelMixer.h"
+#include "TestSupport.h"
+#include <vector>
+
+const ChannelMode kModes[] = {CHANNEL_MODE_LEFT, CHANNEL_MODE_RIGHT, CHANNEL_MODE_MID, CHANNEL_MODE_SIDE,
+                              CHANNEL_MODE_BOTH}; // the modes tested
+
+/**
+ * Mixes a frame's left and right sample into a channel of a mode, one sample at a time (the reference).
+ */
+static float mixSample(ChannelMode mode, int channel, float left, float right) {
+
+    switch (mode) {
+
+        case CHANNEL_MODE_LEFT:
+            return left;
+
+        case CHANNEL_MODE_RIGHT:
+            return right;
+
+        case CHANNEL_MODE_MID:
+            return (left + right) / 2;
+
+        case CHANNEL_MODE_SIDE:
+            return (left - right) / 2;
+
+        case CHANNEL_MODE_BOTH:
+            return (channel == 0) ? left : right;
+    }
+
+    return 0;
+
+}
+
+/**
+ * Checks the (vectorized) mix of every mode against the reference, for numbers of frames that leave
+ * every length of scalar tail, and for mono, stereo and multichannel sounds.
+ */
+static void testMixMatchesTheScalarReference() {
+
+    unsigned seed = 3;
+
+    for (int number_of_channels = 1; number_of_channels <= 6; number_of_channels++) {
+        for (int number_of_frames = 0; number_of_frames <= 67; number_of_frames++) {
+
+            std::vector<float> samples(number_of_frames * number_of_channels);
+
+            for (int index = 0; index < (int) samples.size(); index++) {
+                samples[index] = getRandomSample(seed);
+            }
+
+            for (ChannelMode mode : kModes) {
+
+                ChannelMixer mixer;
+                mixer.setMode(mode);
+
+                int number_of_mixed_channels = mixer.mix(samples.data(), number_of_frames, number_of_channels);
+
+                CHECK(number_of_mixed_channels == ((mode == CHANNEL_MODE_BOTH) ? 2 : 1));
+                CHECK(mixer.getNumberOfChannels() == number_of_mixed_channels);
+                CHECK(mixer.getNumberOfFrames() == number_of_frames);
+
+                for (int channel = 0; channel < number_of_mixed_channels; channel++) {
+
+                    const float * mixed_samples = mixer.getChannel(channel);
+
+                    for (int frame = 0; frame < number_of_frames; frame++) {
+
+                        // A mono sound has the same left and right channel.
+
+                        float left = samples[frame * number_of_channels];
+                        float right = samples[frame * number_of_channels + ((number_of_channels > 1) ? 1 : 0)];
+
+                        CHECK_NEAR(mixed_samples[frame], mixSample(mode, channel, left, right), 1e-6);
+                    }
+                }
+            }
+        }
+    }
+
+}
+
+/**
+ * Checks that the modes are cycled through in order, back to the first after the last.
+ */
+static void testModesCycle() {
+
+    ChannelMode mode = CHANNEL_MODE_LEFT;
+
+    for (int index = 0; index < (int) (sizeof(kModes) / sizeof(kModes[0])); index++) {
+
+        CHECK(mode == kModes[index]);
+        mode = ChannelMixer::getNextMode(mode);
+    }
+
+    CHECK(mode == CHANNEL_MODE_LEFT);
+
+}
+
+/**
+ * Runs the tests of the channel mixer.
+ */
+int main() {
+
+    testMixMatchesTheScalarReference();
+    testModesCycle();
+
+    return finishTests("ChannelMixerTest");
+
+}
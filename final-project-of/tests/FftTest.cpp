@@ -0,0 +1,148 @@
+//
+//  FftTest.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "Fft.h"
+#include "FftBackend.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <complex>
+#include <memory>
+#include <vector>
+
+const double kPi = 3.14159265358979323846;
+
+const int kMinimumSize = 2; // the smallest FFT size tested
+
+const int kMaximumSize = 4096; // the largest FFT size tested
+
+/**
+ * Computes the discrete Fourier transform of complex values directly (in double precision), as the reference.
+ */
+static std::vector<std::complex<double> > computeDft(const std::vector<std::complex<float> > & input) {
+
+    int size = input.size();
+    std::vector<std::complex<double> > output(size);
+
+    for (int k = 0; k < size; k++) {
+        for (int n = 0; n < size; n++) {
+
+            double angle = -2 * kPi * ((long long) k * n % size) / size;
+            output[k] += std::complex<double>(input[n]) * std::complex<double>(cos(angle), sin(angle));
+        }
+    }
+
+    return output;
+
+}
+
+/**
+ * Returns the largest magnitude of the given values (so that the tolerance scales with the size of the FFT).
+ */
+static double getLargestMagnitude(const std::vector<std::complex<double> > & values) {
+
+    double largest_magnitude = 1;
+
+    for (int index = 0; index < (int) values.size(); index++) {
+        largest_magnitude = std::max(largest_magnitude, std::abs(values[index]));
+    }
+
+    return largest_magnitude;
+
+}
+
+/**
+ * Checks the complex FFT against the direct transform, for every power of 2 size.
+ */
+static void testComplexFftMatchesTheDft() {
+
+    unsigned seed = 1;
+
+    for (int size = kMinimumSize; size <= kMaximumSize; size *= 2) {
+
+        std::vector<std::complex<float> > input(size);
+
+        for (int index = 0; index < size; index++) {
+            input[index] = std::complex<float>(getRandomSample(seed), getRandomSample(seed));
+        }
+
+        Fft fft;
+        fft.setup(size);
+        CHECK(fft.getSize() == size);
+
+        std::vector<std::complex<float> > output(size);
+        fft.transform(input.data(), output.data());
+
+        std::vector<std::complex<double> > expected_output = computeDft(input);
+        double tolerance = 1e-5 * getLargestMagnitude(expected_output) * log2(size);
+
+        for (int k = 0; k < size; k++) {
+
+            CHECK_NEAR(output[k].real(), expected_output[k].real(), tolerance);
+            CHECK_NEAR(output[k].imag(), expected_output[k].imag(), tolerance);
+        }
+    }
+
+}
+
+/**
+ * Checks the real FFT plans of the backend against the direct transform, for every power of 2 size.
+ */
+static void testRealFftPlanMatchesTheDft() {
+
+    unsigned seed = 2;
+
+    for (int size = kMinimumSize; size <= kMaximumSize; size *= 2) {
+
+        std::vector<float> samples(size);
+        std::vector<std::complex<float> > complex_samples(size);
+
+        for (int index = 0; index < size; index++) {
+
+            samples[index] = getRandomSample(seed);
+            complex_samples[index] = samples[index];
+        }
+
+        std::shared_ptr<const FftPlan> plan = FftBackend::getPlan(size);
+        CHECK(plan->getSize() == size);
+
+        std::vector<std::complex<float> > bins(size / 2 + 1);
+        plan->transform(samples.data(), bins.data());
+
+        std::vector<std::complex<double> > expected_bins = computeDft(complex_samples);
+        double tolerance = 1e-5 * getLargestMagnitude(expected_bins) * log2(size);
+
+        for (int k = 0; k <= size / 2; k++) {
+
+            CHECK_NEAR(bins[k].real(), expected_bins[k].real(), tolerance);
+            CHECK_NEAR(bins[k].imag(), expected_bins[k].imag(), tolerance);
+        }
+    }
+
+}
+
+/**
+ * Checks that a plan is made once per size, and shared.
+ */
+static void testPlansAreCached() {
+
+    CHECK(FftBackend::getPlan(1024) == FftBackend::getPlan(1024));
+    CHECK(FftBackend::getPlan(1024) != FftBackend::getPlan(2048));
+
+}
+
+/**
+ * Runs the tests of the FFT and of the FFT backend.
+ */
+int main() {
+
+    testComplexFftMatchesTheDft();
+    testRealFftPlanMatchesTheDft();
+    testPlansAreCached();
+
+    return finishTests("FftTest");
+
+}
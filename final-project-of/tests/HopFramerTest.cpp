@@ -0,0 +1,156 @@
+//
+//  HopFramerTest.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "HopFramer.h"
+#include "TestSupport.h"
+#include <vector>
+
+const int kNumberOfChannels = 2; // the number of channels of the streams framed
+
+/**
+ * Returns the sample of a channel of a frame of the test stream (which tells where it is from).
+ */
+static float getStreamSample(long long frame, int channel) {
+
+    return (float) (frame * kNumberOfChannels + channel);
+
+}
+
+/**
+ * Pushes the frames [start_frame, start_frame + number_of_frames) of the test stream.
+ */
+static void pushStream(HopFramer & framer, long long start_frame, int number_of_frames) {
+
+    std::vector<float> samples(number_of_frames * kNumberOfChannels);
+
+    for (int frame = 0; frame < number_of_frames; frame++) {
+        for (int channel = 0; channel < kNumberOfChannels; channel++) {
+            samples[frame * kNumberOfChannels + channel] = getStreamSample(start_frame + frame, channel);
+        }
+    }
+
+    framer.push(samples.data(), number_of_frames, kNumberOfChannels, start_frame);
+
+}
+
+/**
+ * Takes all the windows the framer has, checking that they hold the frames of the stream they start at,
+ * and that they start a hop after the window before.
+ *
+ * @param next_window_start_frame - where the next window is expected to start (moved on past the windows taken)
+ * @return the number of windows taken
+ */
+static int popAndCheckWindows(HopFramer & framer, long long & next_window_start_frame) {
+
+    const float * window;
+    long long window_start_frame;
+    int number_of_windows = 0;
+
+    while (framer.popWindow(window, window_start_frame)) {
+
+        CHECK(window_start_frame == next_window_start_frame);
+
+        bool is_window_of_stream = true;
+
+        for (int frame = 0; frame < framer.getWindowSize(); frame++) {
+            for (int channel = 0; channel < kNumberOfChannels; channel++) {
+
+                if (window[frame * kNumberOfChannels + channel] != getStreamSample(window_start_frame + frame, channel)) {
+                    is_window_of_stream = false;
+                }
+            }
+        }
+
+        CHECK(is_window_of_stream);
+
+        next_window_start_frame = window_start_frame + framer.getHopSize();
+        number_of_windows++;
+    }
+
+    return number_of_windows;
+
+}
+
+/**
+ * Checks that every window of the stream is taken, whatever the number of frames pushed at a time.
+ */
+static void testWindowsEveryHop(int window_size, int hop_size) {
+
+    const int kChunkSizes[] = {1, 7, 64, 511, 512, 513, 3000};
+
+    for (int chunk_size : kChunkSizes) {
+
+        HopFramer framer;
+        framer.setup(window_size, hop_size);
+
+        long long next_window_start_frame = 1000;
+        long long number_of_frames_pushed = 0;
+        int number_of_windows = 0;
+
+        while (number_of_frames_pushed < 20000) {
+
+            pushStream(framer, 1000 + number_of_frames_pushed, chunk_size);
+            number_of_frames_pushed += chunk_size;
+
+            number_of_windows += popAndCheckWindows(framer, next_window_start_frame);
+        }
+
+        CHECK(number_of_windows == (int) ((number_of_frames_pushed - window_size) / hop_size + 1));
+    }
+
+}
+
+/**
+ * Checks that frames which do not follow on from the ones before start the windows over from them.
+ */
+static void testStartsOverOnAJump() {
+
+    HopFramer framer;
+    framer.setup(1024, 512);
+
+    long long next_window_start_frame = 0;
+
+    pushStream(framer, 0, 4096);
+    CHECK(popAndCheckWindows(framer, next_window_start_frame) == 7);
+
+    // A seek back (e.g. the song looped).
+
+    next_window_start_frame = 100;
+
+    pushStream(framer, 100, 1000);
+    CHECK(popAndCheckWindows(framer, next_window_start_frame) == 0);
+
+    pushStream(framer, 1100, 1000);
+    CHECK(popAndCheckWindows(framer, next_window_start_frame) == 2);
+
+    // A reset drops the frames pushed, even if the next ones follow on from them.
+
+    framer.reset();
+    next_window_start_frame = 2100;
+
+    pushStream(framer, 2100, 1023);
+    CHECK(popAndCheckWindows(framer, next_window_start_frame) == 0);
+
+    pushStream(framer, 3123, 1);
+    CHECK(popAndCheckWindows(framer, next_window_start_frame) == 1);
+
+}
+
+/**
+ * Runs the tests of the hop framer.
+ */
+int main() {
+
+    testWindowsEveryHop(1024, 512);
+    testWindowsEveryHop(2048, 512);
+    testWindowsEveryHop(512, 512);
+    testWindowsEveryHop(256, 1000);
+    testStartsOverOnAJump();
+
+    return finishTests("HopFramerTest");
+
+}
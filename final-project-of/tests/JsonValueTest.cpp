@@ -0,0 +1,134 @@
+//
+//  JsonValueTest.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "JsonValue.h"
+#include "TestSupport.h"
+#include <string>
+
+/**
+ * Parses a document which is expected to be valid JSON.
+ */
+static JsonValue parseValid(const std::string & text) {
+
+    JsonValue value;
+    std::string error;
+
+    bool is_valid = JsonValue::parse(text, value, error);
+
+    CHECK(is_valid);
+
+    if (!is_valid) {
+        std::printf("  %s\n", error.c_str());
+    }
+
+    return value;
+
+}
+
+/**
+ * Checks that a configuration-like document is parsed into the values it holds.
+ */
+static void testParsesADocument() {
+
+    JsonValue document = parseValid("{\n"
+                                    "  \"graph\": {\"particles\": 150, \"edge_distance\": 0.35e2, \"fill\": true},\n"
+                                    "  \"colours\": [\"#C9E9F6\", \"#000000\"],\n"
+                                    "  \"offset\": -12.5,\n"
+                                    "  \"nothing\": null\n"
+                                    "}");
+
+    CHECK(document.is(JsonValue::TYPE_OBJECT));
+    CHECK(document.size() == 4);
+    CHECK(document.getMemberName(1) == "colours");
+
+    const JsonValue & graph = document["graph"];
+
+    CHECK(graph["particles"].asNumber(0) == 150);
+    CHECK(graph["edge_distance"].asNumber(0) == 35);
+    CHECK(graph["fill"].asBool(false));
+
+    CHECK(document["colours"].is(JsonValue::TYPE_ARRAY));
+    CHECK(document["colours"].size() == 2);
+    CHECK(document["colours"][1].asString("") == "#000000");
+
+    CHECK(document["offset"].asNumber(0) == -12.5);
+    CHECK(document["nothing"].is(JsonValue::TYPE_NULL));
+    CHECK(document.hasMember("nothing"));
+
+}
+
+/**
+ * Checks that missing or mistyped values read as the defaults given.
+ */
+static void testMissingValuesReadAsDefaults() {
+
+    JsonValue document = parseValid("{\"name\": \"graph\", \"list\": [1, 2]}");
+
+    CHECK(!document.hasMember("missing"));
+    CHECK(document["missing"].is(JsonValue::TYPE_NULL));
+    CHECK(document["missing"]["deeper"].asNumber(7) == 7);
+    CHECK(document["name"].asNumber(3) == 3);
+    CHECK(document["list"][5].asString("none") == "none");
+    CHECK(document["list"].asBool(true));
+    CHECK(document.getMemberName(9) == "");
+
+}
+
+/**
+ * Checks that string escapes (and \u sequences, surrogate pairs included) are decoded into UTF-8.
+ */
+static void testDecodesEscapes() {
+
+    JsonValue document = parseValid("[\"tab\\there\", \"quote \\\" slash \\/ backslash \\\\\", \"\\u00e9\", "
+                                    "\"\\ud83c\\udfb5\"]");
+
+    CHECK(document[0].asString("") == "tab\there");
+    CHECK(document[1].asString("") == "quote \" slash / backslash \\");
+    CHECK(document[2].asString("") == "\xC3\xA9");
+    CHECK(document[3].asString("") == "\xF0\x9F\x8E\xB5");
+
+}
+
+/**
+ * Checks that invalid documents are rejected (with the line they go wrong on), leaving the value as it was.
+ */
+static void testRejectsInvalidDocuments() {
+
+    const char * kInvalidDocuments[] = {"", "{", "{\"a\": }", "{\"a\": 1,}", "[1, 2", "\"unterminated",
+                                        "{\"a\" 1}", "01", "1.", "-", "tru", "[1] 2", "\"\\x\"", "\"\\ud83c\""};
+
+    for (const char * text : kInvalidDocuments) {
+
+        JsonValue value = parseValid("{\"kept\": true}");
+        std::string error;
+
+        CHECK(!JsonValue::parse(text, value, error));
+        CHECK(!error.empty());
+        CHECK(value["kept"].asBool(false));
+    }
+
+    JsonValue value;
+    std::string error;
+
+    CHECK(!JsonValue::parse("{\n  \"a\": 1,\n  \"b\": ]\n}", value, error));
+    CHECK(error.find("line 3") != std::string::npos);
+
+}
+
+/**
+ * Runs the tests of the JSON parser.
+ */
+int main() {
+
+    testParsesADocument();
+    testMissingValuesReadAsDefaults();
+    testDecodesEscapes();
+    testRejectsInvalidDocuments();
+
+    return finishTests("JsonValueTest");
+
+}
@@ -0,0 +1,178 @@
+//
+//  QualityGovernorTest.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "QualityGovernor.h"
+#include "TestSupport.h"
+
+const float kTargetFrameTimeMs = 16.6; // the frame time the governor holds in the tests (60 FPS)
+
+const float kSlowFrameTimeMs = 25; // a frame time over the target
+
+const float kMediumFrameTimeMs = 12; // a frame time under the target, but over the fraction of it to raise at
+
+const float kQuietFrameTimeMs = 5; // a frame time well under the target
+
+const int kNumberOfFrameTimes = 60; // the number of frames the governor takes the percentile over
+
+const int kMinimumRaiseHoldFrames = 300; // the fewest frames in a row the frames must be quiet to raise the quality
+
+/**
+ * Adds frames of the given time till the quality level changes (or the given number of frames is reached).
+ *
+ * @return the number of frames added (the last of which changed the level, if it changed)
+ */
+static int addFramesTillChange(QualityGovernor & governor, float frame_time_ms, int maximum_number_of_frames) {
+
+    for (int frame = 1; frame <= maximum_number_of_frames; frame++) {
+
+        if (governor.addFrameTime(frame_time_ms)) {
+            return frame;
+        }
+    }
+
+    return maximum_number_of_frames;
+
+}
+
+/**
+ * Checks that the quality is lowered once a full window of frames is over the target, and no sooner.
+ */
+static void testLowersAfterSlowFrames() {
+
+    QualityGovernor governor;
+    governor.setTargetFrameTime(kTargetFrameTimeMs);
+
+    CHECK(addFramesTillChange(governor, kSlowFrameTimeMs, 1000) == kNumberOfFrameTimes);
+    CHECK(governor.getLevelIndex() == 1);
+
+    // The next level is only judged by a full window of its own frames.
+
+    CHECK(addFramesTillChange(governor, kSlowFrameTimeMs, 1000) == kNumberOfFrameTimes);
+    CHECK(governor.getLevelIndex() == 2);
+
+    // The lowest level is held, however slow the frames are.
+
+    addFramesTillChange(governor, kSlowFrameTimeMs, 1000);
+    CHECK(governor.getLevelIndex() == QualityGovernor::getNumberOfLevels() - 1);
+    CHECK(!governor.addFrameTime(kSlowFrameTimeMs));
+
+}
+
+/**
+ * Checks that frames under the target (but not well under it) hold the quality level.
+ */
+static void testHoldsBetweenTheThresholds() {
+
+    QualityGovernor governor;
+    governor.setTargetFrameTime(kTargetFrameTimeMs);
+
+    addFramesTillChange(governor, kSlowFrameTimeMs, 1000);
+
+    CHECK(addFramesTillChange(governor, kMediumFrameTimeMs, 5000) == 5000);
+    CHECK(governor.getLevelIndex() == 1);
+
+}
+
+/**
+ * Checks that the quality is raised only once the frames have been well under the target
+ * for the hold time in a row (after a full window of them).
+ */
+static void testRaisesAfterARunOfQuietFrames() {
+
+    QualityGovernor governor;
+    governor.setTargetFrameTime(kTargetFrameTimeMs);
+
+    addFramesTillChange(governor, kSlowFrameTimeMs, 1000);
+
+    CHECK(addFramesTillChange(governor, kQuietFrameTimeMs, 5000) == kNumberOfFrameTimes - 1 + kMinimumRaiseHoldFrames);
+    CHECK(governor.getLevelIndex() == 0);
+
+}
+
+/**
+ * Checks that a burst of frames over the raise fraction of the target starts the run of quiet frames over.
+ */
+static void testResetsTheRunOnABurst() {
+
+    QualityGovernor governor;
+    governor.setTargetFrameTime(kTargetFrameTimeMs);
+
+    addFramesTillChange(governor, kSlowFrameTimeMs, 1000);
+
+    // Most of the way through the run, a burst long enough to lift the percentile over the raise fraction.
+
+    CHECK(addFramesTillChange(governor, kQuietFrameTimeMs, kNumberOfFrameTimes + 200) == kNumberOfFrameTimes + 200);
+    CHECK(addFramesTillChange(governor, kMediumFrameTimeMs, 5) == 5);
+    CHECK(governor.getLevelIndex() == 1);
+
+    // The run only starts over once the burst has left the window, so the quality is raised a full
+    // hold time (and a window) after it.
+
+    int frames_till_raise = addFramesTillChange(governor, kQuietFrameTimeMs, 5000);
+
+    CHECK(frames_till_raise > kMinimumRaiseHoldFrames);
+    CHECK(frames_till_raise <= kNumberOfFrameTimes + kMinimumRaiseHoldFrames);
+    CHECK(governor.getLevelIndex() == 0);
+
+}
+
+/**
+ * Checks that raising the quality to a level which does not hold doubles the time before it is raised again.
+ */
+static void testBacksOffAfterAFailedRaise() {
+
+    QualityGovernor governor;
+    governor.setTargetFrameTime(kTargetFrameTimeMs);
+
+    addFramesTillChange(governor, kSlowFrameTimeMs, 1000);
+    addFramesTillChange(governor, kQuietFrameTimeMs, 5000);
+    CHECK(governor.getLevelIndex() == 0);
+
+    // The raised level does not hold.
+
+    CHECK(addFramesTillChange(governor, kSlowFrameTimeMs, 1000) == kNumberOfFrameTimes);
+    CHECK(governor.getLevelIndex() == 1);
+
+    CHECK(addFramesTillChange(governor, kQuietFrameTimeMs, 5000) == kNumberOfFrameTimes - 1 + 2 * kMinimumRaiseHoldFrames);
+    CHECK(governor.getLevelIndex() == 0);
+
+}
+
+/**
+ * Checks that turning the governor off brings back the highest quality, and keeps it.
+ */
+static void testTurningOffRestoresTheHighestQuality() {
+
+    QualityGovernor governor;
+    governor.setTargetFrameTime(kTargetFrameTimeMs);
+
+    addFramesTillChange(governor, kSlowFrameTimeMs, 1000);
+    CHECK(governor.getLevelIndex() == 1);
+
+    CHECK(governor.setEnabled(false));
+    CHECK(governor.getLevelIndex() == 0);
+
+    CHECK(addFramesTillChange(governor, kSlowFrameTimeMs, 1000) == 1000);
+    CHECK(governor.getLevelIndex() == 0);
+
+}
+
+/**
+ * Runs the tests of the quality governor.
+ */
+int main() {
+
+    testLowersAfterSlowFrames();
+    testHoldsBetweenTheThresholds();
+    testRaisesAfterARunOfQuietFrames();
+    testResetsTheRunOnABurst();
+    testBacksOffAfterAFailedRaise();
+    testTurningOffRestoresTheHighestQuality();
+
+    return finishTests("QualityGovernorTest");
+
+}
@@ -0,0 +1,95 @@
+//
+//  SpectrumSmootherTest.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "SpectrumSmoother.h"
+#include "TestSupport.h"
+#include <vector>
+
+const SmoothingMode kModes[] = {SMOOTHING_MODE_DECAY, SMOOTHING_MODE_ATTACK_RELEASE,
+                                SMOOTHING_MODE_PEAK_HOLD}; // the modes tested
+
+const int kNumberOfValues = 37; // the number of bands smoothed (not a multiple of 4, so there is a scalar tail)
+
+const int kNumberOfUpdates = 300; // the number of updates the bands are smoothed over
+
+/**
+ * Checks the (vectorized) smoothing of all the bands at once against the scalar smoothing of each band
+ * on its own (a smoother of a single band only runs the scalar loop).
+ */
+static void testVectorizedMatchesScalarSmoothing(SmoothingMode mode) {
+
+    SpectrumSmoother smoother;
+    smoother.setup(mode, 0.05f, 0.3f, 0.1f);
+
+    std::vector<SpectrumSmoother> band_smoothers(kNumberOfValues);
+
+    for (int band = 0; band < kNumberOfValues; band++) {
+        band_smoothers[band].setup(mode, 0.05f, 0.3f, 0.1f);
+    }
+
+    unsigned seed = 4 + mode;
+    std::vector<float> new_values(kNumberOfValues);
+
+    for (int update = 0; update < kNumberOfUpdates; update++) {
+
+        // Bursts of loud values, with quieter stretches in between, at an uneven frame rate.
+
+        float level = (update % 50 < 10) ? 1.0f : 0.2f;
+        float delta_seconds = 0.01f + 0.01f * (1 + getRandomSample(seed));
+
+        for (int band = 0; band < kNumberOfValues; band++) {
+            new_values[band] = level * (1 + getRandomSample(seed)) / 2;
+        }
+
+        const std::vector<float> & values = smoother.process(new_values.data(), kNumberOfValues, delta_seconds);
+
+        for (int band = 0; band < kNumberOfValues; band++) {
+
+            const std::vector<float> & band_values = band_smoothers[band].process(&new_values[band], 1, delta_seconds);
+            CHECK_NEAR(values[band], band_values[0], 1e-6);
+        }
+    }
+
+}
+
+/**
+ * Checks that a value decays with the release time once the new values drop to zero.
+ */
+static void testDecaysWithTheReleaseTime() {
+
+    SpectrumSmoother smoother;
+    smoother.setup(SMOOTHING_MODE_DECAY, 0, 0.25f);
+
+    std::vector<float> new_values(kNumberOfValues, 1.0f);
+    smoother.process(new_values.data(), kNumberOfValues, 0.01f);
+
+    std::vector<float> zero_values(kNumberOfValues, 0.0f);
+
+    for (int update = 0; update < 100; update++) {
+        smoother.process(zero_values.data(), kNumberOfValues, 0.01f);
+    }
+
+    for (int band = 0; band < kNumberOfValues; band++) {
+        CHECK_NEAR(smoother.getValues()[band], exp(-1.0 / 0.25), 1e-4);
+    }
+
+}
+
+/**
+ * Runs the tests of the spectrum smoother.
+ */
+int main() {
+
+    for (SmoothingMode mode : kModes) {
+        testVectorizedMatchesScalarSmoothing(mode);
+    }
+
+    testDecaysWithTheReleaseTime();
+
+    return finishTests("SpectrumSmootherTest");
+
+}
@@ -0,0 +1,67 @@
+//
+//  TestSupport.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef TestSupport_h
+#define TestSupport_h
+
+#include <cmath>
+#include <cstdio>
+
+// The checks the test drivers make. A failed check is reported (with where it is), and the driver
+// carries on, so that one run reports every check that fails.
+
+static int number_of_failed_checks = 0; // the number of checks which have failed so far
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            number_of_failed_checks++; \
+        } \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance) \
+    do { \
+        double checked_actual = (actual); \
+        double checked_expected = (expected); \
+        if (!(std::fabs(checked_actual - checked_expected) <= (tolerance))) { \
+            std::printf("%s:%d: CHECK_NEAR(%s, %s) failed: %g != %g\n", __FILE__, __LINE__, #actual, #expected, \
+                        checked_actual, checked_expected); \
+            number_of_failed_checks++; \
+        } \
+    } while (0)
+
+/**
+ * Reports whether all the checks of a test driver passed.
+ *
+ * @param name - the name of the test driver
+ * @return the exit status of the driver (0 if all the checks passed)
+ */
+static inline int finishTests(const char * name) {
+
+    if (number_of_failed_checks > 0) {
+
+        std::printf("%s: %d checks failed\n", name, number_of_failed_checks);
+        return 1;
+    }
+
+    std::printf("%s: passed\n", name);
+    return 0;
+
+}
+
+/**
+ * Returns a pseudo-random number in [-1, 1) (the same sequence on every run, for a given seed).
+ */
+static inline float getRandomSample(unsigned & seed) {
+
+    seed = seed * 1664525u + 1013904223u;
+    return (float) (seed >> 8) / (1 << 23) - 1.0f;
+
+}
+
+#endif /* TestSupport_h */
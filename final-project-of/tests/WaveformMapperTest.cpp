@@ -0,0 +1,128 @@
+//
+//  WaveformMapperTest.cpp
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#include "WaveformMapper.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <vector>
+
+const float kXStart = 10; // the x coordinate the waveforms start at
+
+const float kXEnd = 810; // the x coordinate the waveforms end at
+
+const float kYForLowestSample = 500; // the y coordinate of a sample of -1
+
+const float kYForHighestSample = 100; // the y coordinate of a sample of 1
+
+/**
+ * Maps a sample value to its y coordinate, directly (the reference).
+ */
+static double getSampleY(float sample) {
+
+    return kYForLowestSample + (sample + 1.0) / 2.0 * (kYForHighestSample - kYForLowestSample);
+
+}
+
+/**
+ * Checks the (vectorized) mapping of every sample of a window against the reference, for numbers of
+ * frames that leave every length of scalar tail, and for each channel of interleaved samples.
+ */
+static void testMapsEverySampleOfShortWindows() {
+
+    WaveformMapper mapper;
+    mapper.setup(kXStart, kXEnd, -1, 1, kYForLowestSample, kYForHighestSample);
+
+    GeometryBuffer<FrameVertex> vertices;
+    unsigned seed = 5;
+
+    for (int number_of_channels = 1; number_of_channels <= 2; number_of_channels++) {
+        for (int number_of_frames = 1; number_of_frames <= 67; number_of_frames++) {
+
+            std::vector<float> samples(number_of_frames * number_of_channels);
+
+            for (int index = 0; index < (int) samples.size(); index++) {
+                samples[index] = getRandomSample(seed);
+            }
+
+            for (int channel = 0; channel < number_of_channels; channel++) {
+
+                mapper.map(samples.data(), number_of_frames, number_of_channels, channel, 800, vertices);
+
+                CHECK((int) vertices.size() == number_of_frames);
+
+                for (int frame = 0; frame < std::min((int) vertices.size(), number_of_frames); frame++) {
+
+                    double x = kXStart + (double) frame * (kXEnd - kXStart) / number_of_frames;
+
+                    CHECK_NEAR(vertices[frame].x, x, 1e-3);
+                    CHECK_NEAR(vertices[frame].y, getSampleY(samples[frame * number_of_channels + channel]), 1e-3);
+                }
+            }
+        }
+    }
+
+}
+
+/**
+ * Checks the (vectorized) min/max envelope of long windows against the reference: each column becomes
+ * two vertices, the minimum and the maximum of the samples which fall in it.
+ */
+static void testMapsTheEnvelopeOfLongWindows() {
+
+    WaveformMapper mapper;
+    mapper.setup(kXStart, kXEnd, -1, 1, kYForLowestSample, kYForHighestSample);
+
+    GeometryBuffer<FrameVertex> vertices;
+    unsigned seed = 6;
+
+    const int kNumbersOfFrames[] = {1025, 4096, 16384, 16387};
+    const int kNumbersOfColumns[] = {7, 200, 801};
+
+    for (int number_of_frames : kNumbersOfFrames) {
+        for (int number_of_columns : kNumbersOfColumns) {
+
+            std::vector<float> samples(number_of_frames);
+
+            for (int index = 0; index < number_of_frames; index++) {
+                samples[index] = getRandomSample(seed);
+            }
+
+            mapper.map(samples.data(), number_of_frames, 1, 0, number_of_columns, vertices);
+
+            CHECK((int) vertices.size() == 2 * number_of_columns);
+
+            for (int column = 0; column < std::min((int) vertices.size() / 2, number_of_columns); column++) {
+
+                int begin = (int) ((long long) column * number_of_frames / number_of_columns);
+                int end = (int) ((long long) (column + 1) * number_of_frames / number_of_columns);
+
+                float minimum = *std::min_element(samples.begin() + begin, samples.begin() + end);
+                float maximum = *std::max_element(samples.begin() + begin, samples.begin() + end);
+
+                double x = kXStart + (double) column * (kXEnd - kXStart) / number_of_columns;
+
+                CHECK_NEAR(vertices[2 * column].x, x, 1e-3);
+                CHECK_NEAR(vertices[2 * column + 1].x, x, 1e-3);
+                CHECK_NEAR(vertices[2 * column].y, getSampleY(minimum), 1e-3);
+                CHECK_NEAR(vertices[2 * column + 1].y, getSampleY(maximum), 1e-3);
+            }
+        }
+    }
+
+}
+
+/**
+ * Runs the tests of the waveform mapper.
+ */
+int main() {
+
+    testMapsEverySampleOfShortWindows();
+    testMapsTheEnvelopeOfLongWindows();
+
+    return finishTests("WaveformMapperTest");
+
+}
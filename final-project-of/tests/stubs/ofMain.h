@@ -0,0 +1,77 @@
+//
+//  ofMain.h
+//  final-project-of
+//
+//  Created by Dipro Ray on 10/19/26.
+//
+
+#ifndef ofMain_h
+#define ofMain_h
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+// The few openFrameworks functions the components under test use (logging, and formatting numbers),
+// so that the test drivers build without openFrameworks. The log messages are dropped.
+
+/**
+ * Class that models a log message, which is dropped.
+ */
+class ofLogStream {
+
+public:
+
+    /**
+     * Drops a part of the message.
+     */
+    template <typename Value>
+    ofLogStream & operator<<(const Value &) {
+
+        return *this;
+
+    }
+
+};
+
+/**
+ * Starts a notice log message (which is dropped).
+ */
+inline ofLogStream ofLogNotice(const std::string & = "") {
+
+    return ofLogStream();
+
+}
+
+/**
+ * Starts a warning log message (which is dropped).
+ */
+inline ofLogStream ofLogWarning(const std::string & = "") {
+
+    return ofLogStream();
+
+}
+
+/**
+ * Starts an error log message (which is dropped).
+ */
+inline ofLogStream ofLogError(const std::string & = "") {
+
+    return ofLogStream();
+
+}
+
+/**
+ * Formats a number with the given number of digits after the decimal point.
+ */
+template <typename Value>
+std::string ofToString(const Value & value, int precision) {
+
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(precision) << value;
+
+    return stream.str();
+
+}
+
+#endif /* ofMain_h */